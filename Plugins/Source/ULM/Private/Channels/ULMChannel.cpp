@@ -1,48 +1,98 @@
 #include "Channels/ULMChannel.h"
+#include "Logging/ULMSampler.h"
 #include "HAL/PlatformFilemanager.h"
 
-bool FULMChannelState::CanLog(EULMVerbosity Verbosity, double CurrentTime)
+EULMChannelId ULMChannelIdFromName(const TCHAR* ChannelName)
 {
-	if (!bEffectiveEnabled || Verbosity < EffectiveMinVerbosity)
+	if (!ChannelName || !*ChannelName)
 	{
-		return false;
+		return EULMChannelId::Invalid;
 	}
 
-	FScopeLock Lock(&StateLock);
-	
-	RefillTokens(CurrentTime);
-	
-	if (CurrentTokens >= 1.0f)
-	{
-		CurrentTokens -= 1.0f;
-		return true;
-	}
-	
-	return false;
+#define ULM_CHANNEL_NAME_TO_ID(EnumName, ChannelStr, DisplayStr) \
+	if (FCString::Stricmp(ChannelName, TEXT(ChannelStr)) == 0) return EULMChannelId::EnumName;
+
+	ULM_CHANNEL_LIST(ULM_CHANNEL_NAME_TO_ID)
+#undef ULM_CHANNEL_NAME_TO_ID
+
+	return EULMChannelId::Invalid;
 }
 
-void FULMChannelState::RefillTokens(double CurrentTime)
+// Stripe each reader thread counts itself in - handed out round-robin on first use
+static std::atomic<uint32> GNextReaderStripe{0};
+static thread_local int32 GReaderStripe = INDEX_NONE;
+
+void FULMTokenBucket::Configure(const FULMRateLimit& RateLimit)
 {
-	if (LastRefillTime == 0.0)
-	{
-		LastRefillTime = CurrentTime;
-		CurrentTokens = static_cast<float>(EffectiveRateLimit.BurstCapacity);
-		return;
-	}
+	const uint64 Capacity = static_cast<uint64>(FMath::Clamp(RateLimit.BurstCapacity, 1, static_cast<int32>(TOKEN_MASK >> FRACTION_BITS))) << FRACTION_BITS;
+	const double TokensPerMs = FMath::Max(static_cast<double>(RateLimit.TokensPerSecond), 0.0) / 1000.0;
+
+	CapacityFixed.store(Capacity, std::memory_order_relaxed);
+	RefillPerMsFixed.store(static_cast<uint64>(TokensPerMs * 4294967296.0), std::memory_order_relaxed);
+}
 
-	const double DeltaTime = CurrentTime - LastRefillTime;
-	if (DeltaTime > 0.0)
+bool FULMTokenBucket::TryConsume(double CurrentTime)
+{
+	const uint32 NowMs = static_cast<uint32>(static_cast<uint64>(CurrentTime * 1000.0));
+	const uint64 Capacity = CapacityFixed.load(std::memory_order_relaxed);
+	const uint64 RefillPerMs = RefillPerMsFixed.load(std::memory_order_relaxed);
+
+	uint64 OldState = State.load(std::memory_order_relaxed);
+	for (;;)
 	{
-		const float TokensToAdd = static_cast<float>(DeltaTime * EffectiveRateLimit.TokensPerSecond);
-		CurrentTokens = FMath::Min(CurrentTokens + TokensToAdd, static_cast<float>(EffectiveRateLimit.BurstCapacity));
-		LastRefillTime = CurrentTime;
+		uint64 Tokens;
+		uint32 Tick;
+
+		if ((OldState & PRIMED_BIT) == 0)
+		{
+			// First use starts with a full burst
+			Tokens = Capacity;
+			Tick = NowMs;
+		}
+		else
+		{
+			Tokens = (OldState >> 32) & TOKEN_MASK;
+			Tick = static_cast<uint32>(OldState);
+
+			// Wrapping subtraction - a producer with a slightly older clock reading sees a small negative delta and
+			// skips the refill, while a large one means the tick wrapped after more than 24.8 days idle
+			const int32 Elapsed = static_cast<int32>(NowMs - Tick);
+			if (Elapsed > 0)
+			{
+				const uint64 ElapsedMs = FMath::Min(static_cast<uint32>(Elapsed), MAX_ELAPSED_MS);
+				Tokens = FMath::Min(Capacity, Tokens + ((ElapsedMs * RefillPerMs) >> (32 - FRACTION_BITS)));
+				Tick = NowMs;
+			}
+			else if (Elapsed < -MAX_CLOCK_SKEW_MS)
+			{
+				Tokens = Capacity;
+				Tick = NowMs;
+			}
+		}
+
+		const bool bAdmit = Tokens >= ONE_TOKEN;
+		if (bAdmit)
+		{
+			Tokens -= ONE_TOKEN;
+		}
+
+		const uint64 NewState = PRIMED_BIT | (FMath::Min(Tokens, TOKEN_MASK) << 32) | Tick;
+
+		// An empty bucket within the same millisecond rejects without writing the shared word
+		if (NewState == OldState)
+		{
+			return bAdmit;
+		}
+
+		if (State.compare_exchange_weak(OldState, NewState, std::memory_order_relaxed))
+		{
+			return bAdmit;
+		}
 	}
 }
 
 void FULMChannelState::UpdateEffectiveSettings(const FULMChannelConfig& Config, const FULMChannelState* ParentState)
 {
-	FScopeLock Lock(&StateLock);
-
 	if (Config.bInheritFromParent && ParentState)
 	{
 		bEffectiveEnabled = ParentState->bEffectiveEnabled && Config.bEnabled;
@@ -59,9 +109,22 @@ void FULMChannelState::UpdateEffectiveSettings(const FULMChannelConfig& Config,
 		EffectiveRateLimit = Config.RateLimit;
 		EffectiveMaxEntries = Config.MaxLogEntries;
 	}
+
+	EffectiveOutputLogMirror = Config.OutputLogMirror;
+	EffectiveOutputLogSampleRate = FMath::Max(1, Config.OutputLogSampleRate);
+	EffectiveOverflowPolicy = Config.OverflowPolicy;
+	EffectiveOverflowBlockTimeoutMs = FMath::Max(0, Config.OverflowBlockTimeoutMs);
+	EffectivePressureSampleRate = FMath::Max(1, Config.PressureSampleRate);
+	EffectiveSamplingMode = Config.SamplingMode;
+	EffectiveSampleRate = FMath::Max(1, Config.SampleRate);
+	EffectiveSamplingBudget = FMath::Max(0.1f, Config.SamplingBudgetPerSecond);
+	EffectiveSamplingWindow = FMath::Max(0.1f, Config.SamplingWindowSeconds);
+
+	RateLimiter.Configure(EffectiveRateLimit);
 }
 
-FULMChannelRegistry::FULMChannelRegistry()
+FULMChannelRegistry::FULMChannelRegistry(bool bInPublishGlobals)
+	: bPublishGlobals(bInPublishGlobals)
 {
 	RegisterChannel(TEXT("Default"));
 }
@@ -69,6 +132,15 @@ FULMChannelRegistry::FULMChannelRegistry()
 FULMChannelRegistry::~FULMChannelRegistry()
 {
 	FWriteScopeLock WriteLock(RegistryLock);
+	for (int32 Index = 0; bPublishGlobals && Index < ULM_CHANNEL_COUNT; ++Index)
+	{
+		GULMChannelGates[Index].Close();
+	}
+
+	// Owner is shutting down - no readers remain, free everything now
+	delete Snapshot.exchange(nullptr, std::memory_order_acq_rel);
+	ReclaimRetired(true);
+
 	ChannelStates.Empty();
 	ChannelConfigs.Empty();
 }
@@ -81,30 +153,32 @@ void FULMChannelRegistry::RegisterChannel(const FString& ChannelName, const FULM
 	}
 
 	FWriteScopeLock WriteLock(RegistryLock);
+	RegisterChannelLocked(ChannelName, Config);
+	PublishSnapshot();
+}
 
+void FULMChannelRegistry::RegisterChannelLocked(const FString& ChannelName, const FULMChannelConfig& Config)
+{
 	FString ParentName, LocalName;
 	ParseChannelHierarchy(ChannelName, ParentName, LocalName);
 
 	if (!ParentName.IsEmpty() && !ChannelConfigs.Contains(ParentName))
 	{
-		RegisterChannel(ParentName, DefaultConfig);
+		RegisterChannelLocked(ParentName, DefaultConfig);
 	}
 
 	ChannelConfigs.Emplace(ChannelName, Config);
 
-	TUniquePtr<FULMChannelState> NewState = MakeUnique<FULMChannelState>();
-	NewState->ParentChannel = ParentName;
-
-	const FULMChannelState* ParentState = nullptr;
-	if (!ParentName.IsEmpty())
+	// Re-registering keeps the existing state so in-flight snapshots never point at a freed token bucket
+	TUniquePtr<FULMChannelState>& StatePtr = ChannelStates.FindOrAdd(ChannelName);
+	if (!StatePtr)
 	{
-		if (const TUniquePtr<FULMChannelState>* ParentPtr = ChannelStates.Find(ParentName))
-		{
-			ParentState = ParentPtr->Get();
-		}
+		StatePtr = MakeUnique<FULMChannelState>();
 	}
-	NewState->UpdateEffectiveSettings(Config, ParentState);
+	FULMChannelState* State = StatePtr.Get();
+	State->ParentChannel = ParentName;
 
+	const FULMChannelState* ParentState = nullptr;
 	if (!ParentName.IsEmpty())
 	{
 		if (TUniquePtr<FULMChannelState>* ParentPtr = ChannelStates.Find(ParentName))
@@ -112,11 +186,11 @@ void FULMChannelRegistry::RegisterChannel(const FString& ChannelName, const FULM
 			if (FULMChannelState* Parent = ParentPtr->Get())
 			{
 				Parent->ChildChannels.AddUnique(ChannelName);
+				ParentState = Parent;
 			}
 		}
 	}
-
-	ChannelStates.Emplace(ChannelName, MoveTemp(NewState));
+	State->UpdateEffectiveSettings(Config, ParentState);
 
 	UpdateChildChannels(ChannelName);
 }
@@ -130,76 +204,105 @@ void FULMChannelRegistry::UnregisterChannel(const FString& ChannelName)
 
 	FWriteScopeLock WriteLock(RegistryLock);
 
-	if (TUniquePtr<FULMChannelState>* StatePtr = ChannelStates.Find(ChannelName))
+	TUniquePtr<FULMChannelState> RemovedState;
+	if (ChannelStates.RemoveAndCopyValue(ChannelName, RemovedState) && RemovedState)
 	{
-		FULMChannelState* State = StatePtr->Get();
-		if (State)
+		FULMChannelState* State = RemovedState.Get();
+		if (!State->ParentChannel.IsEmpty())
 		{
-			if (!State->ParentChannel.IsEmpty())
+			if (TUniquePtr<FULMChannelState>* ParentPtr = ChannelStates.Find(State->ParentChannel))
 			{
-				if (TUniquePtr<FULMChannelState>* ParentPtr = ChannelStates.Find(State->ParentChannel))
+				if (FULMChannelState* ParentState = ParentPtr->Get())
 				{
-					if (FULMChannelState* ParentState = ParentPtr->Get())
-					{
-						ParentState->ChildChannels.Remove(ChannelName);
-					}
+					ParentState->ChildChannels.Remove(ChannelName);
 				}
 			}
+		}
 
-			for (const FString& ChildChannel : State->ChildChannels)
+		for (const FString& ChildChannel : State->ChildChannels)
+		{
+			if (TUniquePtr<FULMChannelState>* ChildPtr = ChannelStates.Find(ChildChannel))
 			{
-				if (TUniquePtr<FULMChannelState>* ChildPtr = ChannelStates.Find(ChildChannel))
+				if (FULMChannelState* ChildState = ChildPtr->Get())
 				{
-					if (FULMChannelState* ChildState = ChildPtr->Get())
+					ChildState->ParentChannel = State->ParentChannel;
+					if (!State->ParentChannel.IsEmpty())
 					{
-						ChildState->ParentChannel = State->ParentChannel;
-						if (!State->ParentChannel.IsEmpty())
+						if (TUniquePtr<FULMChannelState>* ParentPtr = ChannelStates.Find(State->ParentChannel))
 						{
-							if (TUniquePtr<FULMChannelState>* ParentPtr = ChannelStates.Find(State->ParentChannel))
+							if (FULMChannelState* ParentState = ParentPtr->Get())
 							{
-								if (FULMChannelState* ParentState = ParentPtr->Get())
-								{
-									ParentState->ChildChannels.AddUnique(ChildChannel);
-								}
+								ParentState->ChildChannels.AddUnique(ChildChannel);
 							}
 						}
 					}
 				}
 			}
 		}
+
+		// The current snapshot still references this state's token bucket - retire instead of freeing
+		FRetired& Retiree = Retired.AddDefaulted_GetRef();
+		Retiree.State = MoveTemp(RemovedState);
 	}
 
 	ChannelConfigs.Remove(ChannelName);
-	ChannelStates.Remove(ChannelName);
+	PublishSnapshot();
 }
 
-bool FULMChannelRegistry::IsChannelRegistered(const FString& ChannelName) const
+const FULMChannelSnapshot* FULMChannelRegistry::BeginRead(std::atomic<int32>*& OutReaderCount) const
 {
-	FReadScopeLock ReadLock(RegistryLock);
-	return ChannelStates.Contains(ChannelName);
+	if (GReaderStripe == INDEX_NONE)
+	{
+		GReaderStripe = static_cast<int32>(GNextReaderStripe.fetch_add(1, std::memory_order_relaxed) % NUM_READER_STRIPES);
+	}
+
+	// Count the reader before loading the pointer - a writer that misses the count has already swapped the pointer,
+	// so this reader can only see the newer snapshot. Both sides are seq_cst for that store/load ordering.
+	const uint32 Parity = ReaderEpoch.load(std::memory_order_seq_cst) & 1;
+	OutReaderCount = &ReaderStripes[GReaderStripe].Count[Parity];
+	OutReaderCount->fetch_add(1, std::memory_order_seq_cst);
+	return Snapshot.load(std::memory_order_seq_cst);
 }
 
+void FULMChannelRegistry::EndRead(std::atomic<int32>* ReaderCount)
+{
+	ReaderCount->fetch_sub(1, std::memory_order_release);
+}
 
-const FULMChannelState* FULMChannelRegistry::GetChannelState(const FString& ChannelName) const
+bool FULMChannelRegistry::IsChannelRegistered(const FString& ChannelName) const
 {
-	FReadScopeLock ReadLock(RegistryLock);
-	if (const TUniquePtr<FULMChannelState>* StatePtr = ChannelStates.Find(ChannelName))
-	{
-		return StatePtr->Get();
-	}
-	return nullptr;
+	const FULMChannelSnapshotPin Pin(this);
+	return Pin && Pin.Get()->Configs.Contains(ChannelName);
 }
 
 bool FULMChannelRegistry::CanChannelLog(const FString& ChannelName, EULMVerbosity Verbosity) const
 {
-	const FULMChannelState* State = GetChannelState(ChannelName);
-	if (!State)
+	const FULMChannelSnapshotPin Pin(this);
+	const FULMChannelView* View = Pin.Find(ChannelName);
+	return View && View->CanLog(Verbosity, FPlatformTime::Seconds());
+}
+
+bool FULMChannelRegistry::CanChannelLog(EULMChannelId ChannelId, EULMVerbosity Verbosity) const
+{
+	return Admit(ChannelId, Verbosity).bAdmitted;
+}
+
+FULMAdmissionTicket FULMChannelRegistry::Admit(EULMChannelId ChannelId, EULMVerbosity Verbosity) const
+{
+	FULMAdmissionTicket Ticket;
+	Ticket.ChannelId = ChannelId;
+	Ticket.Verbosity = Verbosity;
+
+	// Cheap reject through the gate before touching the snapshot
+	if (!ULMIsValidChannelId(ChannelId) || (bPublishGlobals && !GULMChannelGates[static_cast<int32>(ChannelId)].IsOpen(Verbosity)))
 	{
-		return false;
+		return Ticket;
 	}
 
-	const double CurrentTime = FPlatformTime::Seconds();
-	return const_cast<FULMChannelState*>(State)->CanLog(Verbosity, CurrentTime);
+	const FULMChannelSnapshotPin Pin(this);
+	const FULMChannelView* View = Pin.Find(ChannelId);
+	Ticket.bAdmitted = View && View->CanLog(Verbosity, FPlatformTime::Seconds());
+	return Ticket;
 }
 
 void FULMChannelRegistry::UpdateChannelConfig(const FString& ChannelName, const FULMChannelConfig& Config)
@@ -210,16 +313,19 @@ void FULMChannelRegistry::UpdateChannelConfig(const FString& ChannelName, const
 	{
 		ChannelConfigs[ChannelName] = Config;
 		RebuildEffectiveSettings(ChannelName);
+		PublishSnapshot();
 	}
 }
 
 FULMChannelConfig FULMChannelRegistry::GetChannelConfig(const FString& ChannelName) const
 {
-	FReadScopeLock ReadLock(RegistryLock);
-	
-	if (const FULMChannelConfig* Config = ChannelConfigs.Find(ChannelName))
+	const FULMChannelSnapshotPin Pin(this);
+	if (Pin)
 	{
-		return *Config;
+		if (const FULMChannelConfig* Config = Pin.Get()->Configs.Find(ChannelName))
+		{
+			return *Config;
+		}
 	}
 	
 	return DefaultConfig;
@@ -227,11 +333,12 @@ FULMChannelConfig FULMChannelRegistry::GetChannelConfig(const FString& ChannelNa
 
 TArray<FString> FULMChannelRegistry::GetAllChannels() const
 {
-	FReadScopeLock ReadLock(RegistryLock);
-	
 	TArray<FString> Result;
-	Result.Reserve(ChannelStates.Num());
-	ChannelStates.GenerateKeyArray(Result);
+	const FULMChannelSnapshotPin Pin(this);
+	if (Pin)
+	{
+		Pin.Get()->Configs.GenerateKeyArray(Result);
+	}
 	
 	return Result;
 }
@@ -269,7 +376,12 @@ FString FULMChannelRegistry::GetParentChannel(const FString& ChannelName) const
 void FULMChannelRegistry::SetChannelEnabled(const FString& ChannelName, bool bEnabled, bool bRecursive)
 {
 	FWriteScopeLock WriteLock(RegistryLock);
+	SetChannelEnabledLocked(ChannelName, bEnabled, bRecursive);
+	PublishSnapshot();
+}
 
+void FULMChannelRegistry::SetChannelEnabledLocked(const FString& ChannelName, bool bEnabled, bool bRecursive)
+{
 	if (FULMChannelConfig* Config = ChannelConfigs.Find(ChannelName))
 	{
 		Config->bEnabled = bEnabled;
@@ -283,7 +395,7 @@ void FULMChannelRegistry::SetChannelEnabled(const FString& ChannelName, bool bEn
 				{
 					for (const FString& ChildChannel : State->ChildChannels)
 					{
-						SetChannelEnabled(ChildChannel, bEnabled, true);
+						SetChannelEnabledLocked(ChildChannel, bEnabled, true);
 					}
 				}
 			}
@@ -294,7 +406,12 @@ void FULMChannelRegistry::SetChannelEnabled(const FString& ChannelName, bool bEn
 void FULMChannelRegistry::SetChannelVerbosity(const FString& ChannelName, EULMVerbosity MinVerbosity, bool bRecursive)
 {
 	FWriteScopeLock WriteLock(RegistryLock);
+	SetChannelVerbosityLocked(ChannelName, MinVerbosity, bRecursive);
+	PublishSnapshot();
+}
 
+void FULMChannelRegistry::SetChannelVerbosityLocked(const FString& ChannelName, EULMVerbosity MinVerbosity, bool bRecursive)
+{
 	if (FULMChannelConfig* Config = ChannelConfigs.Find(ChannelName))
 	{
 		Config->MinVerbosity = MinVerbosity;
@@ -308,7 +425,7 @@ void FULMChannelRegistry::SetChannelVerbosity(const FString& ChannelName, EULMVe
 				{
 					for (const FString& ChildChannel : State->ChildChannels)
 					{
-						SetChannelVerbosity(ChildChannel, MinVerbosity, true);
+						SetChannelVerbosityLocked(ChildChannel, MinVerbosity, true);
 					}
 				}
 			}
@@ -378,4 +495,105 @@ void FULMChannelRegistry::RebuildEffectiveSettings(const FString& ChannelName)
 	{
 		RebuildEffectiveSettings(ChildChannel);
 	}
-}
\ No newline at end of file
+}
+
+void FULMChannelRegistry::PublishSnapshot()
+{
+	// Called with RegistryLock held for writing - build a complete snapshot before swapping the pointer
+	TUniquePtr<FULMChannelSnapshot> NewSnapshot = MakeUnique<FULMChannelSnapshot>();
+	NewSnapshot->Version = ConfigVersion.fetch_add(1, std::memory_order_acq_rel) + 1;
+	NewSnapshot->Configs = ChannelConfigs;
+	NewSnapshot->ByName.Reserve(ChannelStates.Num());
+
+	for (const TPair<FString, TUniquePtr<FULMChannelState>>& Pair : ChannelStates)
+	{
+		FULMChannelState* State = Pair.Value.Get();
+		if (!State)
+		{
+			continue;
+		}
+
+		FULMChannelView View;
+		View.bEnabled = State->bEffectiveEnabled;
+		View.MinVerbosity = State->EffectiveMinVerbosity;
+		View.MaxEntries = State->EffectiveMaxEntries;
+		View.OutputLogMirror = State->EffectiveOutputLogMirror;
+		View.OutputLogSampleRate = State->EffectiveOutputLogSampleRate;
+		View.OverflowPolicy = State->EffectiveOverflowPolicy;
+		View.OverflowBlockTimeoutMs = State->EffectiveOverflowBlockTimeoutMs;
+		View.PressureSampleRate = State->EffectivePressureSampleRate;
+		View.RateLimiter = &State->RateLimiter;
+
+		NewSnapshot->ByName.Add(Pair.Key, View);
+
+		const EULMChannelId ChannelId = ULMChannelIdFromName(Pair.Key);
+		if (ULMIsValidChannelId(ChannelId))
+		{
+			NewSnapshot->ById[static_cast<int32>(ChannelId)] = View;
+			if (bPublishGlobals)
+			{
+				ULMSampling::Configure(ChannelId, State->EffectiveSamplingMode, State->EffectiveSampleRate, State->EffectiveSamplingBudget, State->EffectiveSamplingWindow);
+			}
+		}
+	}
+
+	const FULMChannelSnapshot* Published = NewSnapshot.Release();
+	const FULMChannelSnapshot* Previous = Snapshot.exchange(Published, std::memory_order_seq_cst);
+
+	// Macro gates mirror the snapshot so ULM_LOG call sites reject without loading the pointer
+	for (int32 Index = 0; bPublishGlobals && Index < ULM_CHANNEL_COUNT; ++Index)
+	{
+		const FULMChannelView& View = Published->ById[Index];
+		if (View.IsRegistered())
+		{
+			GULMChannelGates[Index].Publish(View.bEnabled, View.MinVerbosity);
+		}
+		else
+		{
+			GULMChannelGates[Index].Close();
+		}
+	}
+
+	if (Previous)
+	{
+		Retired.AddDefaulted_GetRef().Snapshot = TUniquePtr<const FULMChannelSnapshot>(Previous);
+	}
+
+	// New readers move to the other parity, so the one the retirees may be pinned under can drain
+	ReaderEpoch.fetch_add(1, std::memory_order_seq_cst);
+	ReclaimRetired(false);
+}
+
+void FULMChannelRegistry::ReclaimRetired(bool bForce)
+{
+	// Only runs on publish, so at most the last few retirees outlive their readers until the next config change
+	if (!bForce)
+	{
+		uint8 DrainedNow = 0;
+		for (uint32 Parity = 0; Parity < 2; ++Parity)
+		{
+			bool bDrained = true;
+			for (const FReaderStripe& Stripe : ReaderStripes)
+			{
+				if (Stripe.Count[Parity].load(std::memory_order_seq_cst) != 0)
+				{
+					bDrained = false;
+					break;
+				}
+			}
+			DrainedNow |= bDrained ? static_cast<uint8>(1 << Parity) : 0;
+		}
+
+		// A reader pinned since before a retirement keeps its parity non-zero until it unpins, so seeing both
+		// parities empty at any point after the retirement means nobody can still hold the retiree
+		for (FRetired& Retiree : Retired)
+		{
+			Retiree.DrainedParities |= DrainedNow;
+		}
+	}
+
+	Retired.RemoveAll([bForce](const FRetired& Retiree)
+	{
+		return bForce || Retiree.DrainedParities == 0x3;
+	});
+}
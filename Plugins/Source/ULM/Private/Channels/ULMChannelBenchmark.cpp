@@ -0,0 +1,184 @@
+#include "Channels/ULMChannel.h"
+#include "Channels/ULMLogCategories.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Thread.h"
+#include <atomic>
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Producer contention benchmark for channel admission
+ * Every thread hammers one shared FULMTokenBucket, as all producers on a busy channel do, and then the gate's
+ * fast reject for a verbosity below the channel minimum. The bucket runs at a realistic rate, so past the first
+ * burst most calls are rejections that must not write the shared word. Private instances only.
+ */
+
+static constexpr int32 TokenBucketCallsPerThread = 200000;
+
+enum class EULMAdmissionBenchmarkPath : uint8
+{
+	TokenBucket,
+	GateReject
+};
+
+// Average ns per call across threads, and how many calls were admitted
+struct FULMAdmissionBenchmarkResult
+{
+	double NanosecondsPerCall = 0.0;
+	int64 Admitted = 0;
+};
+
+static FULMAdmissionBenchmarkResult RunAdmissionContention(EULMAdmissionBenchmarkPath Path, int32 NumThreads)
+{
+	FULMTokenBucket Bucket;
+	Bucket.Configure(FULMRateLimit(1000.0f, 100));
+
+	FULMChannelGate Gate;
+	Gate.Publish(true, EULMVerbosity::Warning);
+
+	std::atomic<int32> Ready{0};
+	std::atomic<bool> bGo{false};
+	std::atomic<int64> Admitted{0};
+	std::atomic<uint64> TotalCycles{0};
+
+	TArray<TUniquePtr<FThread>> Threads;
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		Threads.Add(MakeUnique<FThread>(TEXT("ULMTokenBucketBenchmark"), [&]()
+		{
+			Ready.fetch_add(1, std::memory_order_relaxed);
+			while (!bGo.load(std::memory_order_acquire))
+			{
+				FPlatformProcess::YieldThread();
+			}
+
+			int64 LocalAdmitted = 0;
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			if (Path == EULMAdmissionBenchmarkPath::TokenBucket)
+			{
+				for (int32 Call = 0; Call < TokenBucketCallsPerThread; ++Call)
+				{
+					LocalAdmitted += Bucket.TryConsume(FPlatformTime::Seconds()) ? 1 : 0;
+				}
+			}
+			else
+			{
+				for (int32 Call = 0; Call < TokenBucketCallsPerThread; ++Call)
+				{
+					LocalAdmitted += Gate.IsOpen(EULMVerbosity::Message) ? 1 : 0;
+				}
+			}
+			TotalCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+			Admitted.fetch_add(LocalAdmitted, std::memory_order_relaxed);
+		}));
+	}
+
+	while (Ready.load(std::memory_order_relaxed) < NumThreads)
+	{
+		FPlatformProcess::YieldThread();
+	}
+	bGo.store(true, std::memory_order_release);
+
+	for (TUniquePtr<FThread>& Thread : Threads)
+	{
+		Thread->Join();
+	}
+
+	FULMAdmissionBenchmarkResult Result;
+	Result.NanosecondsPerCall = FPlatformTime::ToSeconds64(TotalCycles.load()) * 1.0e9 / (static_cast<double>(TokenBucketCallsPerThread) * NumThreads);
+	Result.Admitted = Admitted.load();
+	return Result;
+}
+
+static void RunTokenBucketContentionBenchmark(const TArray<FString>& Args)
+{
+	const int32 MaxThreads = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 64) : 32;
+
+	// Powers of two up to the requested count
+	TArray<int32> ThreadCounts;
+	for (int32 NumThreads = 1; NumThreads < MaxThreads; NumThreads *= 2)
+	{
+		ThreadCounts.Add(NumThreads);
+	}
+	ThreadCounts.Add(MaxThreads);
+
+	for (const int32 NumThreads : ThreadCounts)
+	{
+		const FULMAdmissionBenchmarkResult Bucket = RunAdmissionContention(EULMAdmissionBenchmarkPath::TokenBucket, NumThreads);
+		const FULMAdmissionBenchmarkResult Reject = RunAdmissionContention(EULMAdmissionBenchmarkPath::GateReject, NumThreads);
+		UE_LOG(ULM, Display, TEXT("ULM admission contention (%2d threads): TryConsume %.1f ns/call (%lld admitted), gate reject %.2f ns/call (%lld admitted)"),
+			NumThreads, Bucket.NanosecondsPerCall, Bucket.Admitted, Reject.NanosecondsPerCall, Reject.Admitted);
+	}
+}
+
+static FAutoConsoleCommand GULMTokenBucketContentionCommand(
+	TEXT("ULM.TokenBucketContention"),
+	TEXT("Benchmark the lock-free token bucket and the gate reject path from 1 to N producer threads. Usage: ULM.TokenBucketContention [Threads=32]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunTokenBucketContentionBenchmark));
+
+/**
+ * Per-call admission cost before and after the single admission decision
+ * "Before" replays the old pipeline on a private registry: a name-keyed cache lookup for the macro check, then
+ * CanChannelLog by name twice - once for ULMLogMessage and once for StoreLogEntryInternal, each taking a token.
+ * "After" is the current path: the channel gate, then one Admit by ID. The rate limit is generous so most calls
+ * are admitted; the admitted counts also show the old path spending two tokens per call.
+ */
+static void RunAdmissionCostBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumCalls = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1000, 100000000) : 1000000;
+
+	FULMChannelConfig Config;
+	Config.RateLimit = FULMRateLimit(100000.0f, 30000);
+
+	FULMChannelRegistry Registry(false);
+	Registry.RegisterChannel(TEXT("Gameplay"), Config);
+
+	FULMChannelGate Gate;
+	Gate.Publish(true, Config.MinVerbosity);
+
+	// Stand-in for the old thread_local ChannelStateCache, keyed by channel name
+	const FString ChannelName(TEXT("Gameplay"));
+	TMap<FString, bool> NameCache;
+	NameCache.Add(ChannelName, true);
+
+	int64 BeforeAdmitted = 0;
+	const uint64 BeforeStart = FPlatformTime::Cycles64();
+	for (int32 Call = 0; Call < NumCalls; ++Call)
+	{
+		const bool* bCachedEnabled = NameCache.Find(ChannelName);
+		if (bCachedEnabled && *bCachedEnabled
+			&& Registry.CanChannelLog(ChannelName, EULMVerbosity::Message)
+			&& Registry.CanChannelLog(ChannelName, EULMVerbosity::Message))
+		{
+			++BeforeAdmitted;
+		}
+	}
+	const double BeforeSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - BeforeStart);
+
+	// Let the bucket refill so the second pass starts from the same state
+	FPlatformProcess::Sleep(0.5f);
+
+	int64 AfterAdmitted = 0;
+	const uint64 AfterStart = FPlatformTime::Cycles64();
+	for (int32 Call = 0; Call < NumCalls; ++Call)
+	{
+		if (Gate.IsOpen(EULMVerbosity::Message) && Registry.Admit(EULMChannelId::Gameplay, EULMVerbosity::Message))
+		{
+			++AfterAdmitted;
+		}
+	}
+	const double AfterSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - AfterStart);
+
+	UE_LOG(ULM, Display, TEXT("ULM admission cost (%d calls): before %.1f ns/call (%lld admitted), after %.1f ns/call (%lld admitted), %.2fx faster"),
+		NumCalls, BeforeSeconds * 1.0e9 / NumCalls, BeforeAdmitted, AfterSeconds * 1.0e9 / NumCalls, AfterAdmitted,
+		AfterSeconds > 0.0 ? BeforeSeconds / AfterSeconds : 0.0);
+}
+
+static FAutoConsoleCommand GULMAdmissionCostCommand(
+	TEXT("ULM.AdmissionCost"),
+	TEXT("Benchmark the per-call admission cost of the old three-check pipeline against the single admission decision. Usage: ULM.AdmissionCost [Calls=1000000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunAdmissionCostBenchmark));
+
+#endif
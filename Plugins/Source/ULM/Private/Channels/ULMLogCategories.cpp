@@ -1,4 +1,5 @@
 #include "Channels/ULMLogCategories.h"
+#include "Channels/ULMChannel.h"
 #include <atomic>
 
 // Forward declarations for atomic global pointers
@@ -31,4 +32,7 @@ DEFINE_LOG_CATEGORY(ULMSubsystem);
 
 // Thread-safe global state using atomic pointers
 ULM_API std::atomic<FULMChannelRegistry*> GULMChannelRegistry(nullptr);
-ULM_API std::atomic<UULMSubsystem*> GULMSubsystem(nullptr);
\ No newline at end of file
+ULM_API std::atomic<UULMSubsystem*> GULMSubsystem(nullptr);
+
+// Flat per-channel admission gates indexed by EULMChannelId (closed until a channel is registered)
+ULM_API FULMChannelGate GULMChannelGates[ULM_CHANNEL_COUNT];
\ No newline at end of file
@@ -19,6 +19,10 @@ UULMSettings::UULMSettings()
 {
 	PerformanceTier = EULMPerformanceTier::Development;
 	ApplyDevelopmentTier();
+	
+	ProcessorWaitStrategy = EULMWaitStrategy::Hybrid;
+	FileWriterWaitStrategy = EULMWaitStrategy::Blocking;
+	RepeatCollapseWindowSeconds = 1.0f;
 }
 
 
@@ -51,13 +55,15 @@ void UULMSettings::ApplyPerformanceTierInternal()
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, TEXT("Applied Tier: %s"), *TierName);
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, TEXT("Memory Budget: %d MB"), MemoryBudgetMB);
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, TEXT("File Logging: %s"), bFileLoggingEnabled ? TEXT("ENABLED") : TEXT("DISABLED"));
-	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, TEXT("Queue Size: %d"), MaxQueueSize);
+	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, TEXT("Queue Size: %d entries / %d MB"), MaxQueueSize, MaxQueueMemoryMB);
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, TEXT("Retention Days: %d"), RotationConfig.RetentionDays);
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, TEXT("Settings saved to DefaultEngine.ini"));
 	
 	if (UULMSubsystem* ULMSys = GEngine->GetEngineSubsystem<UULMSubsystem>())
 	{
 		ULMSys->SetMemoryBudget(MemoryBudgetMB * 1024 * 1024);
+		ULMSys->SetQueueLimits(MaxQueueSize, static_cast<int64>(MaxQueueMemoryMB) * 1024 * 1024);
+		ULMSys->SetBatchingLimits(BatchProcessingSize, ThreadSleepTimeMs, FileWriterFlushInterval);
 		ULMSys->SetJSONConfig(JSONConfig);
 		ULMSys->SetRotationConfig(RotationConfig);
 		ULMSys->SetFileLoggingEnabled(bFileLoggingEnabled);
@@ -77,6 +83,7 @@ void UULMSettings::ApplyProductionTier()
 	bEnabled = true;
 	bFileLoggingEnabled = true;
 	MaxQueueSize = 5000;
+	MaxQueueMemoryMB = 4;
 	QueueHealthThreshold = 0.6f;
 	BatchProcessingSize = 32;
 	MemoryBudgetMB = 25;
@@ -114,6 +121,7 @@ void UULMSettings::ApplyDevelopmentTier()
 	bEnabled = true;
 	bFileLoggingEnabled = true;
 	MaxQueueSize = 10000;  // Default queue size
+	MaxQueueMemoryMB = 8;  // Room for the full depth of short messages
 	QueueHealthThreshold = 0.8f;  // Standard health threshold
 	BatchProcessingSize = 64;  // Standard batch size
 	MemoryBudgetMB = 50;  // Standard memory budget
@@ -152,6 +160,7 @@ void UULMSettings::ApplyDebugTier()
 	bEnabled = true;
 	bFileLoggingEnabled = true;
 	MaxQueueSize = 20000;  // Larger queue for extensive logging
+	MaxQueueMemoryMB = 16;  // Larger byte bound to match
 	QueueHealthThreshold = 0.9f;  // More lenient health threshold
 	BatchProcessingSize = 128;  // Larger batches
 	MemoryBudgetMB = 100;  // Higher memory budget
@@ -195,6 +204,7 @@ bool UULMSettings::DoesCurrentConfigMatchTier(EULMPerformanceTier Tier) const
 			return (MemoryBudgetMB == 25 &&
 					bFileLoggingEnabled == true &&
 					MaxQueueSize == 5000 &&
+					MaxQueueMemoryMB == 4 &&
 					FMath::IsNearlyEqual(QueueHealthThreshold, 0.6f) &&
 					BatchProcessingSize == 32 &&
 					FMath::IsNearlyEqual(MemoryTrimThreshold, 0.7f) &&
@@ -209,6 +219,7 @@ bool UULMSettings::DoesCurrentConfigMatchTier(EULMPerformanceTier Tier) const
 			return (MemoryBudgetMB == 50 &&
 					bFileLoggingEnabled == true &&
 					MaxQueueSize == 10000 &&
+					MaxQueueMemoryMB == 8 &&
 					FMath::IsNearlyEqual(QueueHealthThreshold, 0.8f) &&
 					BatchProcessingSize == 64 &&
 					FMath::IsNearlyEqual(MemoryTrimThreshold, 0.8f) &&
@@ -223,6 +234,7 @@ bool UULMSettings::DoesCurrentConfigMatchTier(EULMPerformanceTier Tier) const
 			return (MemoryBudgetMB == 100 &&
 					bFileLoggingEnabled == true &&
 					MaxQueueSize == 20000 &&
+					MaxQueueMemoryMB == 16 &&
 					FMath::IsNearlyEqual(QueueHealthThreshold, 0.9f) &&
 					BatchProcessingSize == 128 &&
 					FMath::IsNearlyEqual(MemoryTrimThreshold, 0.9f) &&
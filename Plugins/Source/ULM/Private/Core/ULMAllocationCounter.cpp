@@ -0,0 +1,142 @@
+#include "Core/ULMAllocationCounter.h"
+#include "HAL/MemoryBase.h"
+#include <atomic>
+
+#if !UE_BUILD_SHIPPING
+
+static thread_local bool bTrackAllocations = false;
+
+/**
+ * Forwards everything to the allocator it replaced, counting allocations on tracked threads
+ * Blocks allocated before the swap are freed through it unchanged, so it can be installed and removed at any time.
+ */
+class FULMCountingMalloc final : public FMalloc
+{
+public:
+	FMalloc* Inner = nullptr;
+	std::atomic<int64> Allocations{0};
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation();
+		return Inner->Malloc(Count, Alignment);
+	}
+
+	virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation();
+		return Inner->TryMalloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		if (Count > 0)
+		{
+			CountAllocation();
+		}
+		return Inner->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		if (Count > 0)
+		{
+			CountAllocation();
+		}
+		return Inner->TryRealloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override
+	{
+		Inner->Free(Original);
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return Inner->QuantizeSize(Count, Alignment);
+	}
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return Inner->GetAllocationSize(Original, SizeOut);
+	}
+
+	virtual void Trim(bool bTrimThreadCaches) override
+	{
+		Inner->Trim(bTrimThreadCaches);
+	}
+
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		Inner->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		Inner->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return Inner->IsInternallyThreadSafe();
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return Inner->GetDescriptiveName();
+	}
+
+private:
+	FORCEINLINE void CountAllocation()
+	{
+		if (bTrackAllocations)
+		{
+			Allocations.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+};
+
+static FULMCountingMalloc& GetCountingMalloc()
+{
+	// Intentionally leaked - another thread may still be inside a forwarded call after the swap back
+	static FULMCountingMalloc* CountingMalloc = new FULMCountingMalloc();
+	return *CountingMalloc;
+}
+
+FULMAllocationCounter::FULMAllocationCounter()
+{
+	check(IsInGameThread());
+
+	FULMCountingMalloc& CountingMalloc = GetCountingMalloc();
+	check(GMalloc != &CountingMalloc);
+
+	CountingMalloc.Inner = GMalloc;
+	CountingMalloc.Allocations.store(0, std::memory_order_relaxed);
+	GMalloc = &CountingMalloc;
+}
+
+FULMAllocationCounter::~FULMAllocationCounter()
+{
+	FULMCountingMalloc& CountingMalloc = GetCountingMalloc();
+	if (GMalloc == &CountingMalloc)
+	{
+		GMalloc = CountingMalloc.Inner;
+	}
+}
+
+void FULMAllocationCounter::TrackCurrentThread(bool bTrack)
+{
+	bTrackAllocations = bTrack;
+}
+
+int64 FULMAllocationCounter::GetAllocations() const
+{
+	return GetCountingMalloc().Allocations.load(std::memory_order_relaxed);
+}
+
+void FULMAllocationCounter::Reset()
+{
+	GetCountingMalloc().Allocations.store(0, std::memory_order_relaxed);
+}
+
+#endif
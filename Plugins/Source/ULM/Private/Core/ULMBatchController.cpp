@@ -0,0 +1,102 @@
+#include "Core/ULMBatchController.h"
+
+// Smoothing factor for the rate and latency averages
+static constexpr double RateSmoothing = 0.2;
+
+FULMBatchController::FULMBatchController(int32 InMinBatchSize, int32 InMaxBatchSize, int32 InMinWaitMs, int32 InMaxWaitMs, float InTargetBatchMs)
+	: TargetBatchMs(InTargetBatchMs)
+	, BatchSize(InMinBatchSize)
+	, WaitMs(InMaxWaitMs)
+{
+	SetBatchBounds(InMinBatchSize, InMaxBatchSize);
+	SetWaitBounds(InMinWaitMs, InMaxWaitMs);
+	Publish();
+}
+
+void FULMBatchController::SetBatchBounds(int32 InMinBatchSize, int32 InMaxBatchSize)
+{
+	const int32 NewMin = FMath::Max(1, InMinBatchSize);
+	MinBatchSize.store(NewMin, std::memory_order_relaxed);
+	MaxBatchSize.store(FMath::Max(NewMin, InMaxBatchSize), std::memory_order_relaxed);
+}
+
+void FULMBatchController::SetWaitBounds(int32 InMinWaitMs, int32 InMaxWaitMs)
+{
+	const int32 NewMin = FMath::Max(1, InMinWaitMs);
+	MinWaitMs.store(NewMin, std::memory_order_relaxed);
+	MaxWaitMs.store(FMath::Max(NewMin, InMaxWaitMs), std::memory_order_relaxed);
+}
+
+void FULMBatchController::RecordBatch(int32 Processed, int32 RemainingDepth, double BatchSeconds)
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	const double Elapsed = LastUpdateTime > 0.0 ? CurrentTime - LastUpdateTime : 0.0;
+	LastUpdateTime = CurrentTime;
+
+	// Arrivals since the last update are what was drained plus how much the backlog grew
+	if (Elapsed > 0.0)
+	{
+		const int32 Arrivals = FMath::Max(0, Processed + RemainingDepth - LastDepth);
+		ArrivalRate += RateSmoothing * (Arrivals / Elapsed - ArrivalRate);
+		DrainRate += RateSmoothing * (Processed / Elapsed - DrainRate);
+	}
+	LastDepth = RemainingDepth;
+
+	Batches.fetch_add(1, std::memory_order_relaxed);
+	if (Processed == 0)
+	{
+		IdleWakeups.fetch_add(1, std::memory_order_relaxed);
+	}
+	else
+	{
+		AverageBatchMs += RateSmoothing * (BatchSeconds * 1000.0 - AverageBatchMs);
+	}
+
+	const int32 CurrentMinBatch = MinBatchSize.load(std::memory_order_relaxed);
+	const int32 CurrentMaxBatch = MaxBatchSize.load(std::memory_order_relaxed);
+
+	// Latency first - an overrunning batch shrinks even if a backlog remains
+	if (Processed > 0 && BatchSeconds * 1000.0 > TargetBatchMs && BatchSize > CurrentMinBatch)
+	{
+		BatchSize = FMath::Max(CurrentMinBatch, BatchSize - BatchSize / 4);
+		Shrinks.fetch_add(1, std::memory_order_relaxed);
+	}
+	else if (Processed >= BatchSize && RemainingDepth > BatchSize && BatchSize < CurrentMaxBatch)
+	{
+		BatchSize = FMath::Min(CurrentMaxBatch, BatchSize * 2);
+		Grows.fetch_add(1, std::memory_order_relaxed);
+	}
+	BatchSize = FMath::Clamp(BatchSize, CurrentMinBatch, CurrentMaxBatch);
+
+	// Sleep for about as long as a batch takes to arrive - a quiet queue backs off to the maximum
+	const int32 CurrentMinWait = MinWaitMs.load(std::memory_order_relaxed);
+	const int32 CurrentMaxWait = MaxWaitMs.load(std::memory_order_relaxed);
+	const double ExpectedGapMs = ArrivalRate > 1.0 ? BatchSize * 1000.0 / ArrivalRate : static_cast<double>(CurrentMaxWait);
+	WaitMs = FMath::Clamp(static_cast<int32>(ExpectedGapMs), CurrentMinWait, CurrentMaxWait);
+
+	Publish();
+}
+
+void FULMBatchController::Publish()
+{
+	PublishedBatchSize.store(BatchSize, std::memory_order_relaxed);
+	PublishedWaitMs.store(WaitMs, std::memory_order_relaxed);
+	PublishedArrivalRate.store(static_cast<float>(ArrivalRate), std::memory_order_relaxed);
+	PublishedDrainRate.store(static_cast<float>(DrainRate), std::memory_order_relaxed);
+	PublishedAverageBatchMs.store(static_cast<float>(AverageBatchMs), std::memory_order_relaxed);
+}
+
+FULMBatchControllerStats FULMBatchController::GetStats() const
+{
+	FULMBatchControllerStats Stats;
+	Stats.BatchSize = PublishedBatchSize.load(std::memory_order_relaxed);
+	Stats.WaitMs = PublishedWaitMs.load(std::memory_order_relaxed);
+	Stats.ArrivalRate = PublishedArrivalRate.load(std::memory_order_relaxed);
+	Stats.DrainRate = PublishedDrainRate.load(std::memory_order_relaxed);
+	Stats.AverageBatchMs = PublishedAverageBatchMs.load(std::memory_order_relaxed);
+	Stats.Batches = Batches.load(std::memory_order_relaxed);
+	Stats.IdleWakeups = IdleWakeups.load(std::memory_order_relaxed);
+	Stats.Grows = Grows.load(std::memory_order_relaxed);
+	Stats.Shrinks = Shrinks.load(std::memory_order_relaxed);
+	return Stats;
+}
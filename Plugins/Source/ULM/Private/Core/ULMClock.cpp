@@ -0,0 +1,78 @@
+#include "Core/ULMClock.h"
+#include "HAL/PlatformProcess.h"
+#include <atomic>
+
+// Calibration base guarded by a sequence counter - readers retry if a recalibration raced with them
+struct FULMClockCalibration
+{
+	std::atomic<uint32> Sequence{0};
+	std::atomic<int64> BaseTicks{0};
+	std::atomic<uint64> BaseCycles{0};
+	std::atomic<bool> bRecalibrating{false};
+};
+
+static FULMClockCalibration& GetCalibration()
+{
+	static FULMClockCalibration* Calibration = []()
+	{
+		FULMClockCalibration* NewCalibration = new FULMClockCalibration();
+		NewCalibration->BaseCycles.store(FPlatformTime::Cycles64(), std::memory_order_relaxed);
+		NewCalibration->BaseTicks.store(FDateTime::Now().GetTicks(), std::memory_order_relaxed);
+		return NewCalibration;
+	}();
+	return *Calibration;
+}
+
+void FULMClock::Recalibrate()
+{
+	FULMClockCalibration& Calibration = GetCalibration();
+
+	// Single writer - anyone arriving while a recalibration is in flight just keeps the current base
+	if (Calibration.bRecalibrating.exchange(true, std::memory_order_acquire))
+	{
+		return;
+	}
+
+	const uint64 Cycles = FPlatformTime::Cycles64();
+	const int64 Ticks = FDateTime::Now().GetTicks();
+
+	Calibration.Sequence.fetch_add(1, std::memory_order_acq_rel);
+	Calibration.BaseCycles.store(Cycles, std::memory_order_relaxed);
+	Calibration.BaseTicks.store(Ticks, std::memory_order_relaxed);
+	Calibration.Sequence.fetch_add(1, std::memory_order_release);
+
+	Calibration.bRecalibrating.store(false, std::memory_order_release);
+}
+
+FDateTime FULMClock::ToDateTime(uint64 CaptureCycles)
+{
+	FULMClockCalibration& Calibration = GetCalibration();
+
+	int64 BaseTicks;
+	uint64 BaseCycles;
+	for (;;)
+	{
+		const uint32 SequenceBefore = Calibration.Sequence.load(std::memory_order_acquire);
+		BaseCycles = Calibration.BaseCycles.load(std::memory_order_relaxed);
+		BaseTicks = Calibration.BaseTicks.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if ((SequenceBefore & 1) == 0 && Calibration.Sequence.load(std::memory_order_relaxed) == SequenceBefore)
+		{
+			break;
+		}
+		FPlatformProcess::YieldThread();
+	}
+
+	// Signed delta - entries captured before the latest recalibration land before the base
+	const double ElapsedSeconds = static_cast<double>(static_cast<int64>(CaptureCycles - BaseCycles)) * FPlatformTime::GetSecondsPerCycle64();
+	const int64 ElapsedTicks = static_cast<int64>(ElapsedSeconds * ETimespan::TicksPerSecond);
+
+	// Conversion happens on formatting threads, so the base is refreshed from here rather than from producers
+	if (ElapsedSeconds > RECALIBRATION_SECONDS)
+	{
+		Recalibrate();
+	}
+
+	return FDateTime(BaseTicks + ElapsedTicks);
+}
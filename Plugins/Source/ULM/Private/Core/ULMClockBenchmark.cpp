@@ -0,0 +1,84 @@
+#include "Core/ULMClock.h"
+#include "Channels/ULMLogCategories.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Capture cost and accuracy check for FULMClock
+ * Times FULMClock::Capture against FDateTime::Now, then captures a run of timestamps, each followed by a
+ * system clock reading, and converts them afterwards as the formatter would. Converted times must never go
+ * backwards in capture order and must land within CONVERSION_TOLERANCE_SECONDS of the matching Now().
+ */
+
+static constexpr int32 ClockTimingCalls = 1000000;
+
+static void RunClockCheck(const TArray<FString>& Args)
+{
+	const int32 NumSamples = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 2, 10000000) : 100000;
+
+	// Sinks keep the timed calls from being optimized away
+	volatile uint64 CycleSink = 0;
+	volatile int64 TickSink = 0;
+
+	const double CaptureStart = FPlatformTime::Seconds();
+	for (int32 Call = 0; Call < ClockTimingCalls; ++Call)
+	{
+		CycleSink = CycleSink + FULMClock::Capture();
+	}
+	const double CaptureSeconds = FPlatformTime::Seconds() - CaptureStart;
+
+	const double NowStart = FPlatformTime::Seconds();
+	for (int32 Call = 0; Call < ClockTimingCalls; ++Call)
+	{
+		TickSink = TickSink + FDateTime::Now().GetTicks();
+	}
+	const double NowSeconds = FPlatformTime::Seconds() - NowStart;
+
+	UE_LOG(ULM, Display, TEXT("ULM clock cost: FULMClock::Capture %.1f ns/call, FDateTime::Now %.1f ns/call (%.0fx)"),
+		CaptureSeconds * 1.0e9 / ClockTimingCalls, NowSeconds * 1.0e9 / ClockTimingCalls,
+		CaptureSeconds > 0.0 ? NowSeconds / CaptureSeconds : 0.0);
+
+	// Start from a fresh base so no recalibration moves it part way through the run
+	FULMClock::Recalibrate();
+
+	TArray<uint64> Captures;
+	TArray<int64> SystemTicks;
+	Captures.SetNumUninitialized(NumSamples);
+	SystemTicks.SetNumUninitialized(NumSamples);
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		Captures[Index] = FULMClock::Capture();
+		SystemTicks[Index] = FDateTime::Now().GetTicks();
+	}
+
+	const double ConvertStart = FPlatformTime::Seconds();
+	int32 OrderErrors = 0;
+	double MaxErrorSeconds = 0.0;
+	int64 PreviousTicks = 0;
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const int64 ConvertedTicks = FULMClock::ToDateTime(Captures[Index]).GetTicks();
+		if (Index > 0 && ConvertedTicks < PreviousTicks)
+		{
+			++OrderErrors;
+		}
+		PreviousTicks = ConvertedTicks;
+
+		const double ErrorSeconds = FMath::Abs(static_cast<double>(ConvertedTicks - SystemTicks[Index])) / ETimespan::TicksPerSecond;
+		MaxErrorSeconds = FMath::Max(MaxErrorSeconds, ErrorSeconds);
+	}
+	const double ConvertSeconds = FPlatformTime::Seconds() - ConvertStart;
+
+	const bool bPassed = OrderErrors == 0 && MaxErrorSeconds <= FULMClock::CONVERSION_TOLERANCE_SECONDS;
+	UE_LOG(ULM, Display, TEXT("ULM clock accuracy (%d samples): %d out-of-order, max error vs FDateTime::Now %.3f ms (tolerance %.0f ms), conversion %.1f ns/call - %s"),
+		NumSamples, OrderErrors, MaxErrorSeconds * 1000.0, FULMClock::CONVERSION_TOLERANCE_SECONDS * 1000.0,
+		ConvertSeconds * 1.0e9 / NumSamples, bPassed ? TEXT("PASS") : TEXT("FAIL"));
+}
+
+static FAutoConsoleCommand GULMClockCheckCommand(
+	TEXT("ULM.ClockCheck"),
+	TEXT("Benchmark timestamp capture against FDateTime::Now and check converted timestamps keep capture order and time. Usage: ULM.ClockCheck [Samples=100000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunClockCheck));
+
+#endif
@@ -0,0 +1,152 @@
+#include "Core/ULMSubsystem.h"
+#include "Logging/ULMLogging.h"
+#include "Channels/ULMLogCategories.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Thread.h"
+#include <atomic>
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Incremental query check against the live subsystem
+ * Producer threads flood the Gameplay channel, its entry limit lowered so storage evicts constantly, while a
+ * reader thread pages through every channel with GetLogEntriesSince in small pages, racing the processor's stores
+ * and trims. Sequences are global and gapless, so over the run every stored sequence must be either returned
+ * exactly once, in increasing order, or counted in EvictedCount: returned + evicted == sequences stored.
+ */
+
+static constexpr int32 CursorCheckMaxLogEntries = 100;
+static constexpr double CursorCheckDrainTimeoutSeconds = 5.0;
+
+struct FULMCursorCheckTally
+{
+	int64 Returned = 0;
+	int64 Evicted = 0;
+	int64 Polls = 0;
+	int64 TruncatedPolls = 0;
+	int64 OrderErrors = 0;
+	int64 RangeErrors = 0;
+	int64 LastSequence = 0;
+};
+
+// One page - returns whether the page was full, so more may be waiting
+static bool PollCursorPage(const UULMSubsystem& Subsystem, FULMLogCursor& Cursor, int32 PageSize, int64 StartSequence, FULMCursorCheckTally& Tally)
+{
+	const FULMLogQueryResult Result = Subsystem.GetLogEntriesSince(Cursor, FULMLogQueryFilter(), PageSize);
+	for (const FULMLogEntry& Entry : Result.Entries)
+	{
+		Tally.OrderErrors += Entry.Sequence <= Tally.LastSequence ? 1 : 0;
+		Tally.RangeErrors += (Entry.Sequence <= StartSequence || Entry.Sequence > Result.NextCursor.Sequence) ? 1 : 0;
+		Tally.LastSequence = FMath::Max(Tally.LastSequence, Entry.Sequence);
+	}
+
+	Tally.Returned += Result.Entries.Num();
+	Tally.Evicted += Result.EvictedCount;
+	++Tally.Polls;
+	Cursor = Result.NextCursor;
+
+	const bool bFull = Result.Entries.Num() >= PageSize;
+	Tally.TruncatedPolls += bFull ? 1 : 0;
+	return bFull;
+}
+
+static void RunCursorCheck(const TArray<FString>& Args)
+{
+	UULMSubsystem* Subsystem = GULMSubsystem.load(std::memory_order_acquire);
+	if (!Subsystem)
+	{
+		UE_LOG(ULM, Warning, TEXT("ULM cursor check: subsystem not running"));
+		return;
+	}
+
+	const int32 NumThreads = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 64) : 4;
+	const double Seconds = Args.Num() > 1 ? FMath::Clamp(FCString::Atod(*Args[1]), 0.1, 60.0) : 2.0;
+	const int32 PageSize = Args.Num() > 2 ? FMath::Clamp(FCString::Atoi(*Args[2]), 1, 10000) : 50;
+
+	const FULMChannelConfig SavedConfig = Subsystem->GetChannelConfig(TEXT("Gameplay"));
+	FULMChannelConfig Config = SavedConfig;
+	Config.bEnabled = true;
+	Config.MinVerbosity = EULMVerbosity::Message;
+	Config.RateLimit = FULMRateLimit(200000.0f, 30000);
+	Config.MaxLogEntries = CursorCheckMaxLogEntries;
+	Subsystem->UpdateChannelConfig(TEXT("Gameplay"), Config);
+
+	// Start from "now" - everything already stored is consumed by this first unbounded query
+	FULMLogCursor Cursor = Subsystem->GetLogEntriesSince(FULMLogCursor(), FULMLogQueryFilter(), 0).NextCursor;
+	const int64 StartSequence = Cursor.Sequence;
+
+	FULMCursorCheckTally Tally;
+	Tally.LastSequence = StartSequence;
+
+	std::atomic<bool> bStopProducers{false};
+	std::atomic<bool> bStopReader{false};
+
+	FThread Reader(TEXT("ULMCursorCheckReader"), [&]()
+	{
+		while (!bStopReader.load(std::memory_order_relaxed))
+		{
+			// Drain what is there, then give the processor time to store and evict more
+			while (PollCursorPage(*Subsystem, Cursor, PageSize, StartSequence, Tally))
+			{
+			}
+			FPlatformProcess::Sleep(0.001f);
+		}
+	});
+
+	TArray<TUniquePtr<FThread>> Producers;
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		Producers.Add(MakeUnique<FThread>(TEXT("ULMCursorCheckProducer"), [&bStopProducers, ThreadIndex]()
+		{
+			int32 Count = 0;
+			while (!bStopProducers.load(std::memory_order_relaxed))
+			{
+				ULM_LOG(CHANNEL_GAMEPLAY, EULMVerbosity::Message, TEXT("Cursor check %d from thread %d"), Count++, ThreadIndex);
+			}
+		}));
+	}
+
+	FPlatformProcess::Sleep(static_cast<float>(Seconds));
+	bStopProducers.store(true, std::memory_order_relaxed);
+	for (TUniquePtr<FThread>& Producer : Producers)
+	{
+		Producer->Join();
+	}
+
+	// Let the processor store the backlog while the reader keeps paging
+	const double Deadline = FPlatformTime::Seconds() + CursorCheckDrainTimeoutSeconds;
+	while (Subsystem->GetQueueSize() > 0 && FPlatformTime::Seconds() < Deadline)
+	{
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	bStopReader.store(true, std::memory_order_relaxed);
+	Reader.Join();
+
+	// Pick up the tail - the final cursor sits on the last stored sequence
+	while (PollCursorPage(*Subsystem, Cursor, PageSize, StartSequence, Tally))
+	{
+	}
+
+	Subsystem->UpdateChannelConfig(TEXT("Gameplay"), SavedConfig);
+
+	const int64 Stored = Cursor.Sequence - StartSequence;
+	const bool bAccounted = Tally.Returned + Tally.Evicted == Stored;
+	const bool bPassed = bAccounted && Tally.OrderErrors == 0 && Tally.RangeErrors == 0;
+
+	UE_LOG(ULM, Display, TEXT("ULM cursor check (%d producers, %.1f s, pages of %d): %lld sequences stored, %lld returned + %lld evicted over %lld polls (%lld full pages)"),
+		NumThreads, Seconds, PageSize, Stored, Tally.Returned, Tally.Evicted, Tally.Polls, Tally.TruncatedPolls);
+	UE_LOG(ULM, Display, TEXT("ULM cursor check: %lld out-of-order or duplicated, %lld outside the cursor range, %s - %s"),
+		Tally.OrderErrors, Tally.RangeErrors,
+		bAccounted ? TEXT("every sequence accounted for") : *FString::Printf(TEXT("%lld sequences unaccounted for"), Stored - Tally.Returned - Tally.Evicted),
+		bPassed ? TEXT("PASS") : TEXT("FAIL"));
+}
+
+static FAutoConsoleCommand GULMCursorCheckCommand(
+	TEXT("ULM.CursorCheck"),
+	TEXT("Page through storage with GetLogEntriesSince while producers force evictions; checks no sequence is skipped or duplicated and EvictedCount covers the rest. Usage: ULM.CursorCheck [Threads=4] [Seconds=2] [PageSize=50]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunCursorCheck));
+
+#endif
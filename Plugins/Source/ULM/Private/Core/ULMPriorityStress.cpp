@@ -0,0 +1,133 @@
+#include "Core/ULMSubsystem.h"
+#include "Logging/ULMLogging.h"
+#include "Channels/ULMLogCategories.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Thread.h"
+#include <atomic>
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Priority lane stress test against the live subsystem
+ * Spam threads flood the normal lane with Gameplay messages while the queue limit is temporarily shrunk, so it
+ * stays saturated and drops. Meanwhile the game thread logs tagged Error and Critical lines on the Debug channel,
+ * kept separate so spam can't trim them out of storage. Every tagged line must reach storage and the log file.
+ * Channel configs and queue limits are restored afterwards.
+ */
+
+static constexpr int32 PriorityStressQueueEntries = 256;
+static constexpr double PriorityStressDrainTimeoutSeconds = 5.0;
+
+static void RunPriorityStress(const TArray<FString>& Args)
+{
+	UULMSubsystem* Subsystem = GULMSubsystem.load(std::memory_order_acquire);
+	if (!Subsystem)
+	{
+		UE_LOG(ULM, Warning, TEXT("ULM priority stress: subsystem not running"));
+		return;
+	}
+
+	const int32 NumThreads = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 64) : 8;
+	const int32 NumPriorityLines = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 10000) : 200;
+	const double Seconds = Args.Num() > 2 ? FMath::Clamp(FCString::Atod(*Args[2]), 0.1, 60.0) : 3.0;
+
+	// Lift the rate limits so only the queue decides what is lost
+	const FULMChannelConfig SavedSpamConfig = Subsystem->GetChannelConfig(TEXT("Gameplay"));
+	const FULMChannelConfig SavedPriorityConfig = Subsystem->GetChannelConfig(TEXT("Debug"));
+	const int32 SavedQueueEntries = Subsystem->GetMaxQueueEntries();
+	const int64 SavedQueueBytes = Subsystem->GetMaxQueueBytes();
+
+	FULMChannelConfig SpamConfig = SavedSpamConfig;
+	SpamConfig.bEnabled = true;
+	SpamConfig.MinVerbosity = EULMVerbosity::Message;
+	SpamConfig.OverflowPolicy = EULMOverflowPolicy::DropNewest;
+	SpamConfig.RateLimit = FULMRateLimit(200000.0f, 30000);
+	Subsystem->UpdateChannelConfig(TEXT("Gameplay"), SpamConfig);
+
+	FULMChannelConfig PriorityConfig = SavedPriorityConfig;
+	PriorityConfig.bEnabled = true;
+	PriorityConfig.RateLimit = FULMRateLimit(200000.0f, 30000);
+	PriorityConfig.MaxLogEntries = FMath::Max(PriorityConfig.MaxLogEntries, NumPriorityLines);
+	Subsystem->UpdateChannelConfig(TEXT("Debug"), PriorityConfig);
+
+	Subsystem->SetQueueLimits(PriorityStressQueueEntries, SavedQueueBytes);
+
+	const FULMQueueDiagnostics QueueBefore = Subsystem->GetQueueDiagnostics();
+	const int32 WrittenBefore = Subsystem->GetFileIODiagnostics().PriorityLineCount.GetValue();
+	const FString RunTag = FGuid::NewGuid().ToString(EGuidFormats::Short);
+
+	std::atomic<bool> bStop{false};
+	TArray<TUniquePtr<FThread>> Spammers;
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+	{
+		Spammers.Add(MakeUnique<FThread>(TEXT("ULMPriorityStressSpam"), [&bStop, ThreadIndex]()
+		{
+			int32 Count = 0;
+			while (!bStop.load(std::memory_order_relaxed))
+			{
+				ULM_LOG(CHANNEL_GAMEPLAY, EULMVerbosity::Message, TEXT("Priority stress spam %d from thread %d"), Count++, ThreadIndex);
+			}
+		}));
+	}
+
+	// Spread the priority lines over the run so they all land while the normal lane is full
+	const float LineInterval = static_cast<float>(Seconds / NumPriorityLines);
+	for (int32 Index = 0; Index < NumPriorityLines; ++Index)
+	{
+		const EULMVerbosity Verbosity = (Index % 2 == 0) ? EULMVerbosity::Critical : EULMVerbosity::Error;
+		ULM_LOG(CHANNEL_DEBUG, Verbosity, TEXT("Priority stress line %d [%s]"), Index, *RunTag);
+		FPlatformProcess::Sleep(LineInterval);
+	}
+
+	bStop.store(true, std::memory_order_relaxed);
+	for (TUniquePtr<FThread>& Spammer : Spammers)
+	{
+		Spammer->Join();
+	}
+
+	const FULMQueueDiagnostics QueueAfter = Subsystem->GetQueueDiagnostics();
+
+	// Let the processor and file writer catch up before counting
+	const bool bFileLogging = Subsystem->IsFileLoggingEnabled();
+	const double Deadline = FPlatformTime::Seconds() + PriorityStressDrainTimeoutSeconds;
+	while (FPlatformTime::Seconds() < Deadline
+		&& (Subsystem->GetQueueSize() > 0 || (bFileLogging && Subsystem->GetFileIODiagnostics().PriorityLineCount.GetValue() - WrittenBefore < NumPriorityLines)))
+	{
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	int32 Stored = 0;
+	for (const FULMLogEntry& Entry : Subsystem->GetLogEntries(TEXT("Debug"), PriorityConfig.MaxLogEntries))
+	{
+		if (Entry.Message.Contains(RunTag))
+		{
+			++Stored;
+		}
+	}
+	const int32 Written = Subsystem->GetFileIODiagnostics().PriorityLineCount.GetValue() - WrittenBefore;
+
+	Subsystem->SetQueueLimits(SavedQueueEntries, SavedQueueBytes);
+	Subsystem->UpdateChannelConfig(TEXT("Gameplay"), SavedSpamConfig);
+	Subsystem->UpdateChannelConfig(TEXT("Debug"), SavedPriorityConfig);
+
+	const int32 SpamDropped = QueueAfter.DroppedCount.GetValue() - QueueBefore.DroppedCount.GetValue();
+	const int32 LaneFull = QueueAfter.PriorityLaneFullCount.GetValue() - QueueBefore.PriorityLaneFullCount.GetValue();
+	const bool bStoredAll = Stored == NumPriorityLines;
+	const bool bWroteAll = !bFileLogging || Written >= NumPriorityLines;
+
+	UE_LOG(ULM, Display, TEXT("ULM priority stress (%d spam threads, %.1f s): %d normal-lane drops%s, %d priority-lane-full fallbacks"),
+		NumThreads, Seconds, SpamDropped, SpamDropped > 0 ? TEXT("") : TEXT(" - normal lane never saturated, result inconclusive"), LaneFull);
+	UE_LOG(ULM, Display, TEXT("ULM priority stress: %d/%d error and critical lines stored, %s - %s"),
+		Stored, NumPriorityLines,
+		bFileLogging ? *FString::Printf(TEXT("%d/%d written"), Written, NumPriorityLines) : TEXT("file logging disabled, write check skipped"),
+		bStoredAll && bWroteAll ? TEXT("PASS") : TEXT("FAIL"));
+}
+
+static FAutoConsoleCommand GULMPriorityStressCommand(
+	TEXT("ULM.PriorityStress"),
+	TEXT("Saturate the normal lane with Message spam and check every Error/Critical line is stored and written. Usage: ULM.PriorityStress [Threads=8] [Lines=200] [Seconds=3]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunPriorityStress));
+
+#endif
@@ -6,20 +6,11 @@
 #include "MemoryManagement/ULMLogRotation.h"
 #include "Configuration/ULMSettings.h"
 #include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformProcess.h"
 #include "Misc/DateTime.h"
 
 extern ULM_API std::atomic<FULMChannelRegistry*> GULMChannelRegistry;
 extern ULM_API std::atomic<UULMSubsystem*> GULMSubsystem;
-static bool IsChannelInMasterList(const FString& ChannelName)
-{
-#define ULM_CHECK_CHANNEL(EnumName, ChannelStr, DisplayStr) \
-	if (ChannelName == TEXT(ChannelStr)) return true;
-	
-	ULM_CHANNEL_LIST(ULM_CHECK_CHANNEL)
-#undef ULM_CHECK_CHANNEL
-	
-	return false;
-}
 
 void UULMSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -62,6 +53,31 @@ void UULMSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	// Initialize core infrastructure first (no logging yet - system not ready)
 	ChannelRegistry = MakeUnique<FULMChannelRegistry>();
 	
+	// Producer slots from a previous session are invalidated before any producer can log again
+	if (!ProducerRegistry)
+	{
+		ProducerRegistry = MakeUnique<FULMProducerRegistry>();
+	}
+	else
+	{
+		ProducerRegistry->Reset();
+	}
+	ProducerRegistry->RegisterCurrentThread(TEXT("GameThread"), GAME_THREAD_PRODUCER_WEIGHT);
+	
+	// Preallocate the message ring before any producer can see the subsystem - sized past the logical entry
+	// limit so drop-oldest admissions have room until the processor has made their evictions
+	const int32 QueueEntryLimit = Settings ? Settings->MaxQueueSize : DEFAULT_MAX_QUEUE_SIZE;
+	LogMessageQueue.Initialize(FMath::CeilToInt(QueueEntryLimit * QUEUE_HARD_LIMIT_RATIO));
+	PriorityMessageQueue.Initialize(PRIORITY_QUEUE_SIZE);
+	QueuedBytes.store(0, std::memory_order_relaxed);
+	for (int32 ChannelIndex = 0; ChannelIndex < ULM_CHANNEL_COUNT; ++ChannelIndex)
+	{
+		QueuedPerChannel[ChannelIndex].store(0, std::memory_order_relaxed);
+		PendingEvictions[ChannelIndex].store(0, std::memory_order_relaxed);
+		PressureSampleCounters[ChannelIndex].store(0, std::memory_order_relaxed);
+	}
+	SetQueueLimits(QueueEntryLimit, Settings ? static_cast<int64>(Settings->MaxQueueMemoryMB) * 1024 * 1024 : DEFAULT_MAX_QUEUE_BYTES);
+	
 	// Thread-safe global state initialization using memory_order_release
 	GULMChannelRegistry.store(ChannelRegistry.Get(), std::memory_order_release);
 	GULMSubsystem.store(this, std::memory_order_release);
@@ -73,7 +89,7 @@ void UULMSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("Channel registry and global subsystem references established"));
 	
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("Creating log processor thread..."));
-	TUniquePtr<FULMLogProcessor> ProcessorPtr = MakeUnique<FULMLogProcessor>(this, LogMessageQueue);
+	TUniquePtr<FULMLogProcessor> ProcessorPtr = MakeUnique<FULMLogProcessor>(this, LogMessageQueue, PriorityMessageQueue);
 	ProcessorThread = FRunnableThread::Create(ProcessorPtr.Get(), TEXT("ULMLogProcessor"), 0, TPri_Normal);
 	
 	if (ProcessorThread)
@@ -91,7 +107,7 @@ void UULMSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	}
 	
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("Creating file writer thread..."));
-	TUniquePtr<FULMFileWriter> FileWriterPtr = MakeUnique<FULMFileWriter>(this, FileWriteQueue);
+	TUniquePtr<FULMFileWriter> FileWriterPtr = MakeUnique<FULMFileWriter>(this, FileWriteQueue, PriorityFileWriteQueue);
 	FileWriterThread = FRunnableThread::Create(FileWriterPtr.Get(), TEXT("ULMFileWriter"), 0, TPri_Normal);
 	
 	if (FileWriterThread)
@@ -108,6 +124,13 @@ void UULMSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 			TEXT("CRITICAL: Failed to create file writer thread - file logging will be disabled"));
 	}
 	
+	if (Settings)
+	{
+		SetBatchingLimits(Settings->BatchProcessingSize, Settings->ThreadSleepTimeMs, Settings->FileWriterFlushInterval);
+		SetWaitStrategies(Settings->ProcessorWaitStrategy, Settings->FileWriterWaitStrategy);
+		SetRepeatCollapseWindow(Settings->RepeatCollapseWindowSeconds);
+	}
+	
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("Initializing log rotation and retention managers..."));
 	LogRotator = MakeUnique<FULMLogRotator>(this);
 	RetentionManager = MakeUnique<FULMRetentionManager>(this);
@@ -146,6 +169,12 @@ void UULMSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	// Reset diagnostics
 	QueueDiagnostics.Reset();
 	
+	PendingOutputLog.Reset();
+	for (uint32& Counter : OutputLogSampleCounters)
+	{
+		Counter = 0;
+	}
+	
 	// Auto-register all channels from master list if enabled in settings
 	if (!Settings || Settings->bAutoRegisterChannels)
 	{
@@ -174,21 +203,14 @@ void UULMSubsystem::Deinitialize()
 {
 	ULM_LOG_CRITICAL_SYSTEM(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("ULM shutdown initiated - stopping worker threads..."));
 	
-	// Stop the processor thread
+	// Stop the processor thread first - it drains both rings into storage and the file queues on its way out,
+	// so the file writer has to keep running until it is done
 	if (LogProcessor)
 	{
 		ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("Requesting log processor thread shutdown..."));
 		LogProcessor->RequestStop();
 	}
 	
-	// Stop the file writer thread
-	if (FileWriter)
-	{
-		ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("Requesting file writer thread shutdown..."));
-		FileWriter->RequestStop();
-	}
-	
-	// Wait for threads to finish
 	if (ProcessorThread)
 	{
 		ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("Waiting for log processor thread completion..."));
@@ -202,6 +224,24 @@ void UULMSubsystem::Deinitialize()
 		ProcessorThread = nullptr;
 	}
 	
+	// Entries logged while the processor was exiting - this thread is the only consumer now, so store them here,
+	// priority lane first, while the file writer can still write them
+	{
+		FULMLogQueueEntry PendingEntry;
+		while (PriorityMessageQueue.Dequeue(PendingEntry) || LogMessageQueue.Dequeue(PendingEntry))
+		{
+			ProcessLogEntry(PendingEntry);
+		}
+		FlushOutputLog();
+	}
+	
+	// Stop the file writer thread - it writes and flushes everything queued above before exiting
+	if (FileWriter)
+	{
+		ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("Requesting file writer thread shutdown..."));
+		FileWriter->RequestStop();
+	}
+	
 	if (FileWriterThread)
 	{
 		ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("Waiting for file writer thread completion..."));
@@ -236,16 +276,27 @@ void UULMSubsystem::Deinitialize()
 	GULMChannelRegistry.store(nullptr, std::memory_order_release);
 	GULMSubsystem.store(nullptr, std::memory_order_release);
 	
+	// Stragglers logged after the file writer stopped - mirror them to the Output Log so shutdown logs aren't lost
+	FULMLogQueueEntry PendingEntry;
+	while (PriorityMessageQueue.Dequeue(PendingEntry) || LogMessageQueue.Dequeue(PendingEntry))
+	{
+		if (PendingEntry.bSkipOutputLog)
+		{
+			continue;
+		}
+		QueueOutputLogLine(PendingEntry.BuildMessage(), PendingEntry.ChannelId, PendingEntry.Verbosity, PendingEntry.CallsiteId);
+	}
+	FlushOutputLog();
+	
 	// Thread-safe cleanup of stored data
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("Performing final memory cleanup and data purge..."));
-	FScopeLock Lock(&StorageCriticalSection);
 	
-	// Free memory explicitly
-	for (auto& Entry : LogEntries)
+	// Free memory explicitly - whole chunks per channel
+	for (FULMStorageShard& Shard : StorageShards)
 	{
-		Entry.Value.Empty();
+		FWriteScopeLock ShardLock(Shard.Lock);
+		Shard.Store.Empty();
 	}
-	LogEntries.Empty();
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("All log data and memory pools released"));
 	
 	// Clean up channel registry
@@ -262,7 +313,8 @@ void UULMSubsystem::Deinitialize()
 void UULMSubsystem::RegisterChannel(const FString& ChannelName, const FULMChannelConfig& Config)
 {
 	// Only allow channels that are in the master list
-	if (!IsChannelInMasterList(ChannelName))
+	const EULMChannelId ChannelId = ULMChannelIdFromName(ChannelName);
+	if (!ULMIsValidChannelId(ChannelId))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("ULM: Cannot register channel '%s'. Only master list channels are allowed."), *ChannelName);
 		return;
@@ -272,14 +324,10 @@ void UULMSubsystem::RegisterChannel(const FString& ChannelName, const FULMChanne
 	{
 		ChannelRegistry->RegisterChannel(ChannelName, Config);
 		
-		// Create log storage for this channel
-		FScopeLock Lock(&StorageCriticalSection);
-		if (!LogEntries.Contains(ChannelName))
-		{
-			TArray<FULMLogEntry> NewEntries;
-			NewEntries.Reserve(FMath::Min(Config.MaxLogEntries, 100));
-			LogEntries.Emplace(ChannelName, MoveTemp(NewEntries));
-		}
+		// Reserve log storage for this channel
+		FULMStorageShard& Shard = StorageShards[static_cast<int32>(ChannelId)];
+		FWriteScopeLock ShardLock(Shard.Lock);
+		Shard.Store.Reserve(FMath::Min(Config.MaxLogEntries, 100));
 	}
 }
 
@@ -329,35 +377,117 @@ void UULMSubsystem::LogMessage(const FString& Message, const FString& Channel, E
 		return;
 	}
 
-	const FString& ChannelName = Channel.IsEmpty() ? TEXT("Default") : Channel;
+	// Empty channel falls back to the ULM master channel
+	const EULMChannelId ChannelId = Channel.IsEmpty() ? EULMChannelId::ULM : ULMInternal::ResolveChannelId(Channel);
 	
 	// Call ULMLogMessage for full logging (includes Output Log)
-	ULMLogMessage(ChannelName, Verbosity, Message, nullptr, nullptr, 0);
+	ULMLogMessage(ChannelId, Verbosity, Message, nullptr, nullptr, 0);
 }
 
 void UULMSubsystem::StoreLogEntryInternal(const FString& Message, const FString& ChannelName, EULMVerbosity Verbosity)
 {
-	// Fast path: check if channel can log (includes rate limiting)
-	if (ChannelRegistry && !ChannelRegistry->CanChannelLog(ChannelName, Verbosity))
+	StoreLogEntryInternal(Message, ULMInternal::ResolveChannelId(ChannelName), Verbosity);
+}
+
+void UULMSubsystem::StoreLogEntryInternal(const FString& Message, EULMChannelId ChannelId, EULMVerbosity Verbosity, uint32 CallsiteId)
+{
+	// Callers outside ULMLogMessage have not been admitted yet - make the one decision here
+	const FULMAdmissionTicket Ticket = ChannelRegistry ? ChannelRegistry->Admit(ChannelId, Verbosity) : FULMAdmissionTicket::Bypass(ChannelId, Verbosity);
+	StoreLogEntryInternal(Message, Ticket, CallsiteId);
+}
+
+void UULMSubsystem::StoreLogEntryInternal(const FString& Message, const FULMAdmissionTicket& Ticket, uint32 CallsiteId)
+{
+	// Rejected tickets and non-master-list channels are never stored
+	if (!Ticket || !ULMIsValidChannelId(Ticket.ChannelId))
 	{
 		return;
 	}
 
-	// Check queue size to prevent memory issues
-	if (GetQueueSize() >= MAX_QUEUE_SIZE)
+	EnqueueLogEntry(FULMLogQueueEntry(Message, Ticket.ChannelId, Ticket.Verbosity, CallsiteId));
+}
+
+void UULMSubsystem::StoreMirroredLogEntry(const FString& Message, EULMChannelId ChannelId, EULMVerbosity Verbosity, uint32 CallsiteId)
+{
+	// Same admission as any other store - only the processor's Output Log mirror is skipped
+	const FULMAdmissionTicket Ticket = ChannelRegistry ? ChannelRegistry->Admit(ChannelId, Verbosity) : FULMAdmissionTicket::Bypass(ChannelId, Verbosity);
+	if (!Ticket || !ULMIsValidChannelId(Ticket.ChannelId))
+	{
+		return;
+	}
+
+	FULMLogQueueEntry QueueEntry(Message, Ticket.ChannelId, Ticket.Verbosity, CallsiteId);
+	QueueEntry.bSkipOutputLog = true;
+	EnqueueLogEntry(MoveTemp(QueueEntry));
+}
+
+void UULMSubsystem::StoreDeferredLogEntry(FULMDeferredMessage&& Message, const FULMAdmissionTicket& Ticket, uint32 CallsiteId)
+{
+	if (!Ticket || !ULMIsValidChannelId(Ticket.ChannelId))
+	{
+		return;
+	}
+
+	EnqueueLogEntry(FULMLogQueueEntry(MoveTemp(Message), Ticket.ChannelId, Ticket.Verbosity, CallsiteId));
+}
+
+void UULMSubsystem::StoreStructuredLogEntry(const FString& Lead, FULMStructuredFields&& Fields, const FULMAdmissionTicket& Ticket, uint32 CallsiteId)
+{
+	if (!Ticket || !ULMIsValidChannelId(Ticket.ChannelId))
+	{
+		return;
+	}
+
+	EnqueueLogEntry(FULMLogQueueEntry(Lead, MoveTemp(Fields), Ticket.ChannelId, Ticket.Verbosity, CallsiteId));
+}
+
+void UULMSubsystem::StoreSampledLogEntry(FULMLogQueueEntry&& Entry, const FULMAdmissionTicket& Ticket)
+{
+	if (!Ticket || !ULMIsValidChannelId(Ticket.ChannelId))
+	{
+		return;
+	}
+
+	EnqueueLogEntry(MoveTemp(Entry));
+}
+
+void UULMSubsystem::EnqueueLogEntry(FULMLogQueueEntry&& QueueEntry)
+{
+	QueueEntry.ProducerSlot = static_cast<uint8>(ProducerRegistry->GetCurrentSlot());
+	
+	// Errors and criticals take the reserved lane, so a flood of messages can't push them out
+	if (QueueEntry.Verbosity >= EULMVerbosity::Error && EnqueuePriorityEntry(QueueEntry))
+	{
+		return;
+	}
+	
+	// Apply the channel's overflow policy against the entry and byte limits
+	QueueEntry.QueuedBytes = QueueEntry.CalculateQueuedBytes();
+	bool bChargedEviction = false;
+	if (!AdmitToQueue(QueueEntry, bChargedEviction))
 	{
-		QueueDiagnostics.DroppedCount.Increment();
 		return;
 	}
 
 	// Record enqueue time for diagnostics
 	double StartTime = FPlatformTime::Seconds();
+	const bool bOverflowMessage = !QueueEntry.Message.IsInline();
+	const EULMChannelId ChannelId = QueueEntry.ChannelId;
+	const uint32 EntryBytes = QueueEntry.QueuedBytes;
+	const int32 ProducerSlot = QueueEntry.ProducerSlot;
 	
-	// Enqueue the message (lock-free operation)
-	FULMLogQueueEntry QueueEntry(Message, ChannelName, Verbosity);
-	if (LogMessageQueue.Enqueue(QueueEntry))
+	// Counted before publishing so the consumer's decrement can never run first
+	QueuedPerChannel[static_cast<int32>(ChannelId)].fetch_add(1, std::memory_order_relaxed);
+	ProducerRegistry->OnEnqueued(ProducerSlot);
+	
+	// Enqueue the message (lock-free, multi-producer safe)
+	if (LogMessageQueue.Enqueue(MoveTemp(QueueEntry)))
 	{
 		QueueDiagnostics.EnqueueCount.Increment();
+		if (bOverflowMessage)
+		{
+			QueueDiagnostics.OverflowMessageCount.Increment();
+		}
 		
 		// Wake up processor thread
 		if (LogProcessor)
@@ -367,7 +497,21 @@ void UULMSubsystem::StoreLogEntryInternal(const FString& Message, const FString&
 	}
 	else
 	{
-		QueueDiagnostics.DroppedCount.Increment();
+		// The ring itself is full - only reachable when racing producers overshoot the logical limits
+		QueuedPerChannel[static_cast<int32>(ChannelId)].fetch_sub(1, std::memory_order_relaxed);
+		QueuedBytes.fetch_sub(EntryBytes, std::memory_order_relaxed);
+		ProducerRegistry->OnDequeued(ProducerSlot);
+		
+		// Take back the eviction DropOldest charged for this entry, unless it was already cleared or carried out
+		if (bChargedEviction)
+		{
+			std::atomic<int32>& Evictions = PendingEvictions[static_cast<int32>(ChannelId)];
+			int32 Pending = Evictions.load(std::memory_order_relaxed);
+			while (Pending > 0 && !Evictions.compare_exchange_weak(Pending, Pending - 1, std::memory_order_relaxed))
+			{
+			}
+		}
+		RecordQueueDrop(ChannelId, EULMOverflowPolicy::DropNewest, ProducerSlot);
 	}
 	
 	// Update diagnostics
@@ -376,63 +520,385 @@ void UULMSubsystem::StoreLogEntryInternal(const FString& Message, const FString&
 	QueueDiagnostics.TotalEnqueueTime.Add(EnqueueTimeMicros);
 }
 
-TArray<FULMLogEntry> UULMSubsystem::GetLogEntries(const FString& Channel, int32 MaxEntries) const
+bool UULMSubsystem::EnqueuePriorityEntry(FULMLogQueueEntry& QueueEntry)
+{
+	const bool bOverflowMessage = !QueueEntry.Message.IsInline();
+	const int32 ProducerSlot = QueueEntry.ProducerSlot;
+	
+	// A failed enqueue leaves the entry untouched, so the caller can still try the normal lane
+	QueueEntry.bPriorityLane = true;
+	ProducerRegistry->OnEnqueued(ProducerSlot);
+	if (!PriorityMessageQueue.Enqueue(MoveTemp(QueueEntry)))
+	{
+		QueueEntry.bPriorityLane = false;
+		ProducerRegistry->OnDequeued(ProducerSlot);
+		QueueDiagnostics.PriorityLaneFullCount.Increment();
+		return false;
+	}
+	
+	QueueDiagnostics.EnqueueCount.Increment();
+	QueueDiagnostics.PriorityEnqueueCount.Increment();
+	if (bOverflowMessage)
+	{
+		QueueDiagnostics.OverflowMessageCount.Increment();
+	}
+	
+	if (LogProcessor)
+	{
+		LogProcessor->WakeUp();
+	}
+	return true;
+}
+
+bool UULMSubsystem::AdmitToQueue(const FULMLogQueueEntry& QueueEntry, bool& bOutChargedEviction)
+{
+	bOutChargedEviction = false;
+	const EULMChannelId ChannelId = QueueEntry.ChannelId;
+	const int32 ChannelIndex = static_cast<int32>(ChannelId);
+	
+	// Copy the policy out of the snapshot rather than holding the pin - the blocking policy sleeps below
+	EULMOverflowPolicy Policy = EULMOverflowPolicy::DropNewest;
+	int32 PressureSampleRate = 1;
+	int32 OverflowBlockTimeoutMs = 0;
+	{
+		const FULMChannelSnapshotPin Pin(ChannelRegistry.Get());
+		const FULMChannelView* View = Pin.Find(ChannelId);
+		if (View && View->IsRegistered())
+		{
+			Policy = View->OverflowPolicy;
+			PressureSampleRate = View->PressureSampleRate;
+			OverflowBlockTimeoutMs = View->OverflowBlockTimeoutMs;
+		}
+	}
+	
+	// Sampling thins the channel out before the queue is actually full - errors and criticals always pass
+	if (Policy == EULMOverflowPolicy::SampleUnderPressure && QueueEntry.Verbosity < EULMVerbosity::Error && IsQueueUnderPressure(QUEUE_SOFT_LIMIT_RATIO))
+	{
+		const uint32 SampleIndex = PressureSampleCounters[ChannelIndex].fetch_add(1, std::memory_order_relaxed);
+		if (SampleIndex % static_cast<uint32>(PressureSampleRate) != 0)
+		{
+			RecordQueueDrop(ChannelId, Policy, QueueEntry.ProducerSlot);
+			return false;
+		}
+	}
+	
+	if (TryReserveQueueSpace(QueueEntry.QueuedBytes, 1.0f, QueueEntry.ProducerSlot))
+	{
+		// Back under the soft limit the overflow is over - evictions still owed from it would drop entries for nothing
+		if (ULMIsValidChannelId(ChannelId) && PendingEvictions[ChannelIndex].load(std::memory_order_relaxed) > 0
+			&& !IsQueueUnderPressure(QUEUE_SOFT_LIMIT_RATIO))
+		{
+			PendingEvictions[ChannelIndex].store(0, std::memory_order_relaxed);
+		}
+		return true;
+	}
+	
+	switch (Policy)
+	{
+		case EULMOverflowPolicy::DropOldest:
+		{
+			// Admit past the limit and have the processor discard this channel's oldest queued entry instead -
+			// only possible while the channel has an older entry not already marked for eviction
+			if (QueuedPerChannel[ChannelIndex].load(std::memory_order_relaxed) > PendingEvictions[ChannelIndex].load(std::memory_order_relaxed)
+				&& TryReserveQueueSpace(QueueEntry.QueuedBytes, QUEUE_HARD_LIMIT_RATIO, QueueEntry.ProducerSlot))
+			{
+				PendingEvictions[ChannelIndex].fetch_add(1, std::memory_order_relaxed);
+				bOutChargedEviction = true;
+				return true;
+			}
+			break;
+		}
+		case EULMOverflowPolicy::BlockWithTimeout:
+		{
+			// The game thread must never stall on logging, and the processor thread would wait on itself
+			const bool bIsProcessorThread = ProcessorThread && FPlatformTLS::GetCurrentThreadId() == ProcessorThread->GetThreadID();
+			if (IsInGameThread() || bIsProcessorThread)
+			{
+				break;
+			}
+			
+			// One notify is enough - a full queue keeps the processor from parking again while we poll
+			if (LogProcessor)
+			{
+				LogProcessor->WakeUp();
+			}
+			
+			const double Deadline = FPlatformTime::Seconds() + OverflowBlockTimeoutMs / 1000.0;
+			do
+			{
+				FPlatformProcess::SleepNoStats(QUEUE_BLOCK_POLL_SECONDS);
+				
+				if (TryReserveQueueSpace(QueueEntry.QueuedBytes, 1.0f, QueueEntry.ProducerSlot))
+				{
+					return true;
+				}
+			}
+			while (FPlatformTime::Seconds() < Deadline);
+			break;
+		}
+		default:
+			break;
+	}
+	
+	RecordQueueDrop(ChannelId, Policy, QueueEntry.ProducerSlot);
+	return false;
+}
+
+bool UULMSubsystem::TryReserveQueueSpace(uint32 Bytes, float LimitRatio, int32 ProducerSlot)
 {
-	FScopeLock Lock(&StorageCriticalSection);
+	// Entry count is checked without reserving - racing producers may overshoot by a few, which the ring's headroom absorbs
+	const int32 EntryLimit = FMath::Max(1, static_cast<int32>(MaxQueueEntries.load(std::memory_order_relaxed) * LimitRatio));
+	const int32 QueuedEntries = LogMessageQueue.Num();
+	if (QueuedEntries >= EntryLimit)
+	{
+		return false;
+	}
+	
+	// Past the fairness threshold a thread is held to its weighted share, so one spamming worker can't take the rest
+	if (QueuedEntries >= EntryLimit * QUEUE_FAIRNESS_RATIO && !ProducerRegistry->IsWithinQuota(ProducerSlot, EntryLimit))
+	{
+		return false;
+	}
 	
+	const int64 ByteLimit = static_cast<int64>(MaxQueueBytes.load(std::memory_order_relaxed) * LimitRatio);
+	if (QueuedBytes.fetch_add(Bytes, std::memory_order_relaxed) + Bytes > ByteLimit)
+	{
+		QueuedBytes.fetch_sub(Bytes, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+bool UULMSubsystem::IsQueueUnderPressure(float LimitRatio) const
+{
+	return LogMessageQueue.Num() >= MaxQueueEntries.load(std::memory_order_relaxed) * LimitRatio
+		|| QueuedBytes.load(std::memory_order_relaxed) >= MaxQueueBytes.load(std::memory_order_relaxed) * LimitRatio;
+}
+
+void UULMSubsystem::ReleaseQueueSpace(const FULMLogQueueEntry& QueueEntry)
+{
+	QueuedBytes.fetch_sub(QueueEntry.QueuedBytes, std::memory_order_relaxed);
+	if (ULMIsValidChannelId(QueueEntry.ChannelId))
+	{
+		QueuedPerChannel[static_cast<int32>(QueueEntry.ChannelId)].fetch_sub(1, std::memory_order_relaxed);
+	}
+}
+
+bool UULMSubsystem::TryEvictQueuedEntry(EULMChannelId ChannelId, int32 ProducerSlot)
+{
+	if (!ULMIsValidChannelId(ChannelId))
+	{
+		return false;
+	}
+	
+	std::atomic<int32>& Evictions = PendingEvictions[static_cast<int32>(ChannelId)];
+	int32 Pending = Evictions.load(std::memory_order_relaxed);
+	while (Pending > 0)
+	{
+		if (Evictions.compare_exchange_weak(Pending, Pending - 1, std::memory_order_relaxed))
+		{
+			RecordQueueDrop(ChannelId, EULMOverflowPolicy::DropOldest, ProducerSlot);
+			return true;
+		}
+	}
+	return false;
+}
+
+void UULMSubsystem::RecordQueueDrop(EULMChannelId ChannelId, EULMOverflowPolicy Policy, int32 ProducerSlot)
+{
+	ProducerRegistry->OnDropped(ProducerSlot);
+	QueueDiagnostics.DroppedCount.Increment();
+	QueueDiagnostics.PolicyDropCounts[static_cast<int32>(Policy)].Increment();
+	if (ULMIsValidChannelId(ChannelId))
+	{
+		QueueDiagnostics.ChannelDropCounts[static_cast<int32>(ChannelId)].Increment();
+	}
+}
+
+void UULMSubsystem::SetQueueLimits(int32 MaxEntries, int64 MaxBytes)
+{
+	// The ring can't be reallocated under live producers - keep the hard limit inside it
+	const int32 RingEntryLimit = FMath::Max(1, FMath::FloorToInt(LogMessageQueue.GetCapacity() / QUEUE_HARD_LIMIT_RATIO));
+	if (MaxEntries > RingEntryLimit)
+	{
+		ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, 
+			TEXT("Queue size %d exceeds the allocated ring - using %d until the next startup"), MaxEntries, RingEntryLimit);
+	}
+	
+	MaxQueueEntries.store(FMath::Clamp(MaxEntries, 1, RingEntryLimit), std::memory_order_relaxed);
+	MaxQueueBytes.store(FMath::Max<int64>(MaxBytes, 64 * 1024), std::memory_order_relaxed);
+}
+
+TArray<FULMLogEntry> UULMSubsystem::GetLogEntries(const FString& Channel, int32 MaxEntries) const
+{
 	TArray<FULMLogEntry> Result;
-	Result.Reserve(FMath::Max(MaxEntries, 100));
 	
 	if (Channel.IsEmpty())
 	{
-		// Aggregate all channels efficiently
-		for (const auto& ChannelPair : LogEntries)
+		// Merge the channels by capture cycles - exact capture order, unaffected by clock recalibration.
+		// Each store is already in capture order, so only the returned entries are visited.
+		TStaticArray<const FULMChannelLogStore*, ULM_CHANNEL_COUNT> Stores;
+		for (int32 Index = 0; Index < ULM_CHANNEL_COUNT; ++Index)
 		{
-			Result.Append(ChannelPair.Value);
+			Stores[Index] = &StorageShards[Index].Store;
 		}
 		
-		// Sort by timestamp - stable sort for consistent ordering
-		Result.StableSort([](const FULMLogEntry& A, const FULMLogEntry& B)
-		{
-			return A.Timestamp < B.Timestamp;
-		});
+		FULMStorageShard::ReadLockAll(StorageShards);
+		FULMChannelLogStore::CopyNewestMerged(Stores, Result, MaxEntries);
+		FULMStorageShard::ReadUnlockAll(StorageShards);
 	}
 	else
 	{
-		// Single channel lookup
-		if (const TArray<FULMLogEntry>* ChannelEntries = LogEntries.Find(Channel))
-		{
-			Result = *ChannelEntries;
-		}
+		// Single channel lookup - the shard is read-locked only to snapshot the window; the copies Blueprint needs
+		// are made from the view afterwards
+		GetLogView(Channel, MaxEntries)->CopyEntries(Result);
 	}
 	
-	// Trim to requested count from end (most recent)
-	if (MaxEntries > 0 && Result.Num() > MaxEntries)
+	return Result;
+}
+
+FULMLogStoreViewPtr UULMSubsystem::GetLogView(EULMChannelId ChannelId, int32 MaxEntries) const
+{
+	if (!ULMIsValidChannelId(ChannelId))
 	{
-		const int32 StartIndex = Result.Num() - MaxEntries;
-		Result.RemoveAt(0, StartIndex, EAllowShrinking::No);
+		return MakeShared<FULMLogStoreView, ESPMode::ThreadSafe>();
 	}
 	
+	const FULMStorageShard& Shard = StorageShards[static_cast<int32>(ChannelId)];
+	FReadScopeLock ShardLock(Shard.Lock);
+	return Shard.Store.CreateView(ChannelId, MaxEntries);
+}
+
+FULMLogStoreViewPtr UULMSubsystem::GetLogView(const FString& Channel, int32 MaxEntries) const
+{
+	return GetLogView(ULMInternal::ResolveChannelId(Channel), MaxEntries);
+}
+
+FULMLogQueryResult UULMSubsystem::GetLogEntriesSince(const FULMLogCursor& Cursor, const FULMLogQueryFilter& Filter, int32 MaxEntries) const
+{
+	struct FHit
+	{
+		int64 Sequence;
+		int32 Channel;
+		int32 Index;
+	};
+
+	FULMLogQueryResult Result;
+	Result.NextCursor = Cursor;
+
+	int32 FirstChannel = 0;
+	int32 LastChannel = ULM_CHANNEL_COUNT - 1;
+	if (!Filter.Channel.IsEmpty())
+	{
+		const EULMChannelId ChannelId = ULMInternal::ResolveChannelId(Filter.Channel);
+		if (!ULMIsValidChannelId(ChannelId))
+		{
+			return Result;
+		}
+		FirstChannel = LastChannel = static_cast<int32>(ChannelId);
+	}
+
+	// Hold the matched shards for the whole query - a sequence is stamped and stored under its shard's lock, so
+	// every sequence up to LastStoredSequence in these channels is already visible
+	TConstArrayView<FULMStorageShard> Shards = TConstArrayView<FULMStorageShard>(StorageShards).Slice(FirstChannel, LastChannel - FirstChannel + 1);
+	FULMStorageShard::ReadLockAll(Shards);
+
+	// Gather every record stored after the cursor - anything the channel stored since then that is no longer
+	// there was evicted before we saw it
+	TArray<FHit> Hits;
+	TArray<int32> Indices;
+	for (int32 Channel = FirstChannel; Channel <= LastChannel; ++Channel)
+	{
+		const FULMChannelLogStore& Store = StorageShards[Channel].Store;
+
+		Indices.Reset();
+		Store.FindNewerThan(Cursor.Sequence, Indices);
+
+		const int64 Evicted = FMath::Max<int64>(0, Store.GetNumAdded() - Cursor.ChannelStored[Channel] - Indices.Num());
+		Result.EvictedCount += Evicted;
+		Result.NextCursor.ChannelStored[Channel] += Evicted;
+
+		for (const int32 Index : Indices)
+		{
+			Hits.Add({ Store.GetRecord(Index).Sequence, Channel, Index });
+		}
+	}
+
+	Hits.Sort([](const FHit& A, const FHit& B)
+	{
+		return A.Sequence < B.Sequence;
+	});
+
+	// Consume in sequence order - entries below MinVerbosity are consumed without being returned, and a full
+	// result leaves the cursor on the last entry it returned
+	int64 ConsumedSequence = Cursor.Sequence;
+	bool bTruncated = false;
+	for (const FHit& Hit : Hits)
+	{
+		const FULMChannelLogStore& Store = StorageShards[Hit.Channel].Store;
+		if (Store.GetRecord(Hit.Index).Verbosity >= Filter.MinVerbosity)
+		{
+			if (MaxEntries > 0 && Result.Entries.Num() >= MaxEntries)
+			{
+				bTruncated = true;
+				break;
+			}
+			Store.CopyEntry(static_cast<EULMChannelId>(Hit.Channel), Hit.Index, Result.Entries);
+		}
+
+		++Result.NextCursor.ChannelStored[Hit.Channel];
+		ConsumedSequence = Hit.Sequence;
+	}
+
+	Result.NextCursor.Sequence = bTruncated ? ConsumedSequence : FMath::Max(Cursor.Sequence, LastStoredSequence.load());
+	FULMStorageShard::ReadUnlockAll(Shards);
 	return Result;
 }
 
+TArray<FULMLogEntry> UULMSubsystem::PollLogEntries(FULMLogCursor& Cursor, const FULMLogQueryFilter& Filter, int64& EvictedCount, int32 MaxEntries) const
+{
+	FULMLogQueryResult Result = GetLogEntriesSince(Cursor, Filter, MaxEntries);
+	Cursor = Result.NextCursor;
+	EvictedCount = Result.EvictedCount;
+	return MoveTemp(Result.Entries);
+}
+
 void UULMSubsystem::ClearChannel(const FString& ChannelName)
 {
-	FScopeLock Lock(&StorageCriticalSection);
-	
-	if (TArray<FULMLogEntry>* ChannelEntries = LogEntries.Find(ChannelName))
+	const EULMChannelId ChannelId = ULMInternal::ResolveChannelId(ChannelName);
+	if (!ULMIsValidChannelId(ChannelId))
 	{
-		ChannelEntries->Empty();
+		return;
 	}
+	
+	FWriteScopeLock ShardLock(StorageShards[static_cast<int32>(ChannelId)].Lock);
+	ClearChannelStorage(ChannelId);
 }
 
 void UULMSubsystem::ClearAllChannels()
 {
-	FScopeLock Lock(&StorageCriticalSection);
+	// Every shard at once, so no reader sees some channels cleared and others not
+	FULMStorageShard::WriteLockAll(StorageShards);
 	
-	for (auto& ChannelPair : LogEntries)
+	for (int32 Index = 0; Index < ULM_CHANNEL_COUNT; ++Index)
 	{
-		ChannelPair.Value.Empty();
+		ClearChannelStorage(static_cast<EULMChannelId>(Index));
+	}
+	
+	FULMStorageShard::WriteUnlockAll(StorageShards);
+}
+
+void UULMSubsystem::ClearChannelStorage(EULMChannelId ChannelId)
+{
+	// O(chunks) - text chunks are freed wholesale rather than entry by entry
+	FULMChannelLogStore& ChannelEntries = StorageShards[static_cast<int32>(ChannelId)].Store;
+	const int32 NumRemoved = ChannelEntries.Num();
+	const SIZE_T BytesRemoved = ChannelEntries.GetLiveBytes();
+	ChannelEntries.Empty();
+	
+	if (NumRemoved > 0)
+	{
+		MemoryTracker.RemoveMemoryUsage(ChannelId, BytesRemoved, NumRemoved);
 	}
 }
 
@@ -563,19 +1029,132 @@ void UULMSubsystem::RegisterAllChannelsFromMasterList()
 
 void UULMSubsystem::ProcessLogEntry(const FULMLogQueueEntry& QueueEntry)
 {
-	// Convert queue entry to log entry
-	FULMLogEntry LogEntry(QueueEntry.Message, QueueEntry.Channel, QueueEntry.Verbosity);
-	LogEntry.Timestamp = QueueEntry.Timestamp;
-	LogEntry.ThreadId = QueueEntry.ThreadId;
+	ProducerRegistry->OnDequeued(QueueEntry.ProducerSlot);
+	
+	if (!QueueEntry.bPriorityLane)
+	{
+		ReleaseQueueSpace(QueueEntry);
+		
+		// A drop-oldest producer went past the limit on this channel - the oldest queued entry makes way for it
+		if (TryEvictQueuedEntry(QueueEntry.ChannelId, QueueEntry.ProducerSlot))
+		{
+			return;
+		}
+	}
+	
+	StoreQueueEntry(QueueEntry);
+}
+
+void UULMSubsystem::CollapseLogEntry(const FULMLogQueueEntry& QueueEntry)
+{
+	ProducerRegistry->OnDequeued(QueueEntry.ProducerSlot);
+	
+	if (!QueueEntry.bPriorityLane)
+	{
+		ReleaseQueueSpace(QueueEntry);
+		
+		// Repeats pay off drop-oldest debt like any other entry, or the debt would land on the next distinct line
+		if (TryEvictQueuedEntry(QueueEntry.ChannelId, QueueEntry.ProducerSlot))
+		{
+			return;
+		}
+	}
+	
+	QueueDiagnostics.CollapsedCount.Increment();
+}
+
+void UULMSubsystem::ProcessGeneratedLogEntry(const FULMLogQueueEntry& QueueEntry)
+{
+	StoreQueueEntry(QueueEntry);
+}
+
+void UULMSubsystem::StoreQueueEntry(const FULMLogQueueEntry& QueueEntry)
+{
+	// Convert queue entry to log entry - deferred entries are formatted and structured fields rendered here, off the logging thread
+	FULMLogEntry LogEntry(QueueEntry.BuildMessage(),
+		QueueEntry.ChannelId, QueueEntry.Verbosity, QueueEntry.CaptureCycles, QueueEntry.ThreadId, QueueEntry.CallsiteId);
+	LogEntry.Fields = QueueEntry.Fields.IsSet() ? &QueueEntry.Fields : nullptr;
+	LogEntry.SampleWeight = QueueEntry.SampleWeight;
 	
 	// Store the processed entry
 	StoreProcessedLogEntry(LogEntry);
+	
+	// Producers never touch the Output Log - the text is handed to this cycle's mirror batch once storage has copied it
+	if (!QueueEntry.bSkipOutputLog)
+	{
+		QueueOutputLogLine(MoveTemp(LogEntry.Message), LogEntry.ChannelId, LogEntry.Verbosity, LogEntry.CallsiteId);
+	}
+}
+
+bool UULMSubsystem::ShouldMirrorToOutputLog(EULMChannelId ChannelId, EULMVerbosity Verbosity)
+{
+	if (!ULMIsValidChannelId(ChannelId))
+	{
+		return false;
+	}
+	
+	const FULMChannelSnapshotPin Pin(ChannelRegistry.Get());
+	const FULMChannelView* View = Pin.Find(ChannelId);
+	if (!View || !View->IsRegistered())
+	{
+		// No settings to go by - keep the previous always-mirror behaviour
+		return true;
+	}
+	
+	switch (View->OutputLogMirror)
+	{
+		case EULMOutputLogMirror::Off:
+			return false;
+		case EULMOutputLogMirror::WarningsAndAbove:
+			return Verbosity >= EULMVerbosity::Warning;
+		case EULMOutputLogMirror::Sampled:
+		{
+			if (Verbosity >= EULMVerbosity::Error)
+			{
+				return true;
+			}
+			uint32& Counter = OutputLogSampleCounters[static_cast<int32>(ChannelId)];
+			return (Counter++ % static_cast<uint32>(View->OutputLogSampleRate)) == 0;
+		}
+		case EULMOutputLogMirror::Full:
+		default:
+			return true;
+	}
+}
+
+void UULMSubsystem::QueueOutputLogLine(FString&& Message, EULMChannelId ChannelId, EULMVerbosity Verbosity, uint32 CallsiteId)
+{
+	if (!ShouldMirrorToOutputLog(ChannelId, Verbosity))
+	{
+		return;
+	}
+	
+	FULMOutputLogLine& Line = PendingOutputLog.AddDefaulted_GetRef();
+	Line.Message = MoveTemp(Message);
+	Line.ChannelId = ChannelId;
+	Line.Verbosity = Verbosity;
+	Line.CallsiteId = CallsiteId;
+	
+	// Keep a runaway cycle from holding an unbounded batch
+	if (PendingOutputLog.Num() >= MAX_PENDING_OUTPUT_LOG_LINES)
+	{
+		FlushOutputLog();
+	}
+}
+
+void UULMSubsystem::FlushOutputLog()
+{
+	if (PendingOutputLog.Num() > 0)
+	{
+		ULMForwardToOutputLogBatch(PendingOutputLog);
+	}
 }
 
 void UULMSubsystem::StoreProcessedLogEntry(const FULMLogEntry& Entry)
 {
 	// Only allow channels that are in the master list (check outside lock)
-	if (!IsChannelInMasterList(Entry.Channel))
+	const EULMChannelId ChannelId = Entry.ChannelId;
+	if (!ULMIsValidChannelId(ChannelId))
 	{
 		// For non-master-list channels, log a warning and drop the message
 		UE_LOG(LogTemp, Warning, TEXT("ULM: Dropping log for unregistered channel '%s'. Only master list channels are allowed."), *Entry.Channel);
@@ -608,74 +1187,90 @@ void UULMSubsystem::StoreProcessedLogEntry(const FULMLogEntry& Entry)
 		}
 	}
 	
-	// Now acquire lock for actual storage operations
-	FScopeLock Lock(&StorageCriticalSection);
-	
-	// Auto-register channel if needed (only for master list channels)
-	if (!LogEntries.Contains(Entry.Channel))
+	// Only this channel's shard is locked, and only for the insert and trim - readers of other channels never wait
 	{
-		TArray<FULMLogEntry> NewEntries;
-		NewEntries.Reserve(100);
-		LogEntries.Emplace(Entry.Channel, MoveTemp(NewEntries));
+		FULMStorageShard& Shard = StorageShards[static_cast<int32>(ChannelId)];
+		FWriteScopeLock ShardLock(Shard.Lock);
 		
-		// Register in channel registry too
-		if (ChannelRegistry && !ChannelRegistry->IsChannelRegistered(Entry.Channel))
+		// Stamp and insert under the same lock, so a reader holding the shard sees every sequence it can read
+		FULMChannelLogStore& ChannelEntries = Shard.Store;
+		ChannelEntries.Add(Entry, LastStoredSequence.fetch_add(1) + 1);
+		
+		// Track memory usage
+		MemoryTracker.AddMemoryUsage(ChannelId, EntryMemorySize);
+		
+		// Trim based on channel settings - read from the lock-free snapshot rather than copying the config out of the registry map
+		const FULMChannelSnapshotPin Pin(ChannelRegistry.Get());
+		if (const FULMChannelView* View = Pin.Find(ChannelId))
 		{
-			ChannelRegistry->RegisterChannel(Entry.Channel);
+			if (ChannelEntries.Num() > View->MaxEntries)
+			{
+				const int32 ElementsToRemove = ChannelEntries.Num() - View->MaxEntries;
+				TrimChannelForMemory(ChannelId, ElementsToRemove);
+			}
 		}
 	}
 	
-	// Add entry
-	TArray<FULMLogEntry>& ChannelEntries = LogEntries[Entry.Channel];
-	ChannelEntries.Add(Entry);
-	
-	// Track memory usage
-	MemoryTracker.AddMemoryUsage(Entry.Channel, EntryMemorySize);
-	
 	// Queue for file writing if enabled (exclude master ULM channel to avoid redundancy)
-	if (bFileLoggingEnabled && FileWriter && Entry.Channel != TEXT("ULM"))
+	// Formatted outside the shard lock - only the log processor thread stores, so the SPSC file queues keep one producer
+	if (bFileLoggingEnabled && FileWriter && ChannelId != EULMChannelId::ULM)
 	{
 		FString LogLine = FormatLogEntryForFile(Entry);
 		FString FilePath = GenerateLogFilePath(Entry.Channel);
 		FULMFileWriteEntry FileEntry(LogLine, FilePath, Entry.Timestamp.ToUnixTimestamp());
 		
-		// Enqueue for asynchronous file writing
-		if (!FileWriteQueue.Enqueue(FileEntry))
+		// Enqueue for asynchronous file writing - errors and criticals skip ahead of the batch and are flushed on write
+		const bool bPriorityWrite = Entry.Verbosity >= EULMVerbosity::Error;
+		TQueue<FULMFileWriteEntry, EQueueMode::Spsc>& TargetQueue = bPriorityWrite ? PriorityFileWriteQueue : FileWriteQueue;
+		if (!TargetQueue.Enqueue(FileEntry))
 		{
 			// File write queue is full - this is a diagnostic issue
 			UE_LOG(LogTemp, Warning, TEXT("ULM: File write queue full, dropping file write for channel '%s'"), *Entry.Channel);
 		}
-		else
+		else if (bPriorityWrite)
 		{
-			// Wake up file writer thread
 			FileWriter->WakeUp();
 		}
-	}
-	
-	// Trim based on channel settings
-	if (ChannelRegistry)
-	{
-		const FULMChannelConfig Config = ChannelRegistry->GetChannelConfig(Entry.Channel);
-		if (ChannelEntries.Num() > Config.MaxLogEntries)
+		else
 		{
-			const int32 ElementsToRemove = ChannelEntries.Num() - Config.MaxLogEntries;
-			TrimChannelForMemory(Entry.Channel, ElementsToRemove);
+			// Counts toward the writer's batch controller depth and wakes the thread
+			FileWriter->NotifyQueued();
 		}
 	}
 }
 
 int32 UULMSubsystem::GetQueueSize() const
 {
-	// TQueue doesn't have a direct size method, so we estimate based on counters
-	int32 Enqueued = QueueDiagnostics.EnqueueCount.GetValue();
-	int32 Dequeued = QueueDiagnostics.DequeueCount.GetValue();
-	return FMath::Max(0, Enqueued - Dequeued);
+	// Exact occupancy tracked by the rings themselves
+	return LogMessageQueue.Num() + PriorityMessageQueue.Num();
 }
 
 bool UULMSubsystem::IsQueueHealthy() const
 {
-	int32 CurrentSize = GetQueueSize();
-	return CurrentSize < (MAX_QUEUE_SIZE * 0.8f); // Consider unhealthy if 80% full
+	return !IsQueueUnderPressure(0.8f); // Consider unhealthy if 80% full by entries or bytes
+}
+
+void UULMSubsystem::ResetQueueDiagnostics()
+{
+	QueueDiagnostics.Reset();
+	if (ProducerRegistry)
+	{
+		ProducerRegistry->ResetCounters();
+	}
+	ULMSampling::ResetStats();
+}
+
+void UULMSubsystem::RegisterProducerThread(const FString& Name, float Weight, int32 BurstEntries)
+{
+	if (ProducerRegistry)
+	{
+		ProducerRegistry->RegisterCurrentThread(Name, Weight, BurstEntries);
+	}
+}
+
+TArray<FULMProducerStats> UULMSubsystem::GetProducerDiagnostics() const
+{
+	return ProducerRegistry ? ProducerRegistry->GetStats() : TArray<FULMProducerStats>();
 }
 
 void UULMSubsystem::UpdateProcessingDiagnostics(int64 DequeueTimeMicros)
@@ -754,6 +1349,63 @@ FString UULMSubsystem::GetLogFilePath() const
 	return FPaths::ProjectLogDir() / TEXT("ULM");
 }
 
+void UULMSubsystem::SetBatchingLimits(int32 MaxBatchSize, int32 MaxWaitMs, float MaxFlushIntervalSeconds)
+{
+	if (LogProcessor)
+	{
+		LogProcessor->SetBatchingLimits(MaxBatchSize, MaxWaitMs);
+	}
+	
+	if (FileWriter)
+	{
+		// Writes are cheaper per entry than processing, so the writer may batch further than the processor
+		FileWriter->SetBatchSize(MaxBatchSize * FILE_WRITER_BATCH_MULTIPLIER);
+		FileWriter->SetMaxWaitMs(MaxWaitMs);
+		FileWriter->SetFlushInterval(MaxFlushIntervalSeconds);
+	}
+}
+
+void UULMSubsystem::SetRepeatCollapseWindow(float WindowSeconds)
+{
+	if (LogProcessor)
+	{
+		LogProcessor->SetRepeatCollapseWindow(WindowSeconds);
+	}
+}
+
+void UULMSubsystem::SetWaitStrategies(EULMWaitStrategy ProcessorStrategy, EULMWaitStrategy FileWriterStrategy)
+{
+	if (LogProcessor)
+	{
+		LogProcessor->SetWaitStrategy(ProcessorStrategy);
+	}
+	
+	if (FileWriter)
+	{
+		FileWriter->SetWaitStrategy(FileWriterStrategy);
+	}
+}
+
+FULMThreadParkerStats UULMSubsystem::GetProcessorWaitStats() const
+{
+	return LogProcessor ? LogProcessor->GetWaitStats() : FULMThreadParkerStats();
+}
+
+FULMThreadParkerStats UULMSubsystem::GetFileWriterWaitStats() const
+{
+	return FileWriter ? FileWriter->GetWaitStats() : FULMThreadParkerStats();
+}
+
+FULMBatchControllerStats UULMSubsystem::GetProcessorBatchStats() const
+{
+	return LogProcessor ? LogProcessor->GetBatchStats() : FULMBatchControllerStats();
+}
+
+FULMBatchControllerStats UULMSubsystem::GetFileWriterBatchStats() const
+{
+	return FileWriter ? FileWriter->GetBatchStats() : FULMBatchControllerStats();
+}
+
 FULMFileIODiagnostics UULMSubsystem::GetFileIODiagnostics() const
 {
 	if (FileWriter)
@@ -803,7 +1455,7 @@ bool UULMSubsystem::IsMemoryBudgetHealthy() const
 
 int64 UULMSubsystem::GetChannelMemoryUsage(const FString& ChannelName) const
 {
-	return static_cast<int64>(MemoryTracker.GetChannelMemoryUsage(ChannelName));
+	return static_cast<int64>(MemoryTracker.GetChannelMemoryUsage(ULMInternal::ResolveChannelId(ChannelName)));
 }
 
 void UULMSubsystem::TrimMemoryBudget()
@@ -814,9 +1466,7 @@ void UULMSubsystem::TrimMemoryBudget()
 	
 	ULM_WARNING(CHANNEL_PERFORMANCE, TEXT("TrimMemoryBudget called: %lld/%lld bytes"), CurrentUsage, Budget);
 	
-	FScopeLock Lock(&StorageCriticalSection);
-	
-	// Re-check after acquiring lock
+	// No global lock - each channel's shard is taken only while that channel is trimmed
 	CurrentUsage = MemoryTracker.GetTotalMemoryUsage();
 	Budget = MemoryTracker.GetMemoryBudget();
 	
@@ -859,15 +1509,15 @@ void UULMSubsystem::TrimMemoryBudget()
 		CurrentUsage, Budget, OverageRatio * 100.0f, TargetPercent * 100.0f);
 	
 	// Build list of channels sorted by memory usage (largest first)
-	TArray<TPair<FString, SIZE_T>> ChannelsByUsage;
-	for (const auto& LogEntryPair : LogEntries)
+	TArray<TPair<EULMChannelId, SIZE_T>, TInlineAllocator<ULM_CHANNEL_COUNT>> ChannelsByUsage;
+	for (int32 Index = 0; Index < ULM_CHANNEL_COUNT; ++Index)
 	{
-		SIZE_T ChannelUsage = MemoryTracker.GetChannelMemoryUsage(LogEntryPair.Key);
-		ChannelsByUsage.Emplace(LogEntryPair.Key, ChannelUsage);
+		const EULMChannelId ChannelId = static_cast<EULMChannelId>(Index);
+		ChannelsByUsage.Emplace(ChannelId, MemoryTracker.GetChannelMemoryUsage(ChannelId));
 	}
 	
 	// Sort by usage (largest first)
-	ChannelsByUsage.Sort([](const TPair<FString, SIZE_T>& A, const TPair<FString, SIZE_T>& B) {
+	ChannelsByUsage.Sort([](const TPair<EULMChannelId, SIZE_T>& A, const TPair<EULMChannelId, SIZE_T>& B) {
 		return A.Value > B.Value;
 	});
 	
@@ -879,10 +1529,11 @@ void UULMSubsystem::TrimMemoryBudget()
 			break;
 		}
 		
-		const FString& ChannelName = ChannelPair.Key;
-		TArray<FULMLogEntry>* ChannelEntries = LogEntries.Find(ChannelName);
+		const EULMChannelId ChannelId = ChannelPair.Key;
+		FWriteScopeLock ShardLock(StorageShards[static_cast<int32>(ChannelId)].Lock);
+		const int32 NumChannelEntries = StorageShards[static_cast<int32>(ChannelId)].Store.Num();
 		
-		if (ChannelEntries && ChannelEntries->Num() > 0)
+		if (NumChannelEntries > 0)
 		{
 			// Calculate removal percentage based on how much we still need to reduce
 			float RemainingReduction = static_cast<float>(TargetReduction - TotalReduced);
@@ -899,19 +1550,19 @@ void UULMSubsystem::TrimMemoryBudget()
 				RemovalPercent = 0.5f; // Remove 50% if we need moderate reduction
 			}
 			
-			int32 EntriesToRemove = FMath::Max(1, static_cast<int32>(ChannelEntries->Num() * RemovalPercent));
-			EntriesToRemove = FMath::Min(EntriesToRemove, ChannelEntries->Num());
+			int32 EntriesToRemove = FMath::Max(1, static_cast<int32>(NumChannelEntries * RemovalPercent));
+			EntriesToRemove = FMath::Min(EntriesToRemove, NumChannelEntries);
 			
-			SIZE_T MemoryBefore = MemoryTracker.GetChannelMemoryUsage(ChannelName);
-			TrimChannelForMemory(ChannelName, EntriesToRemove);
-			SIZE_T MemoryAfter = MemoryTracker.GetChannelMemoryUsage(ChannelName);
+			SIZE_T MemoryBefore = MemoryTracker.GetChannelMemoryUsage(ChannelId);
+			TrimChannelForMemory(ChannelId, EntriesToRemove);
+			SIZE_T MemoryAfter = MemoryTracker.GetChannelMemoryUsage(ChannelId);
 			
 			SIZE_T ReducedThisChannel = MemoryBefore - MemoryAfter;
 			TotalReduced += ReducedThisChannel;
 			
 			ULM_LOG(CHANNEL_PERFORMANCE, EULMVerbosity::Message, 
 				TEXT("Trimmed %d entries (%.0f%%) from channel '%s', reduced memory by %lld bytes"), 
-				EntriesToRemove, RemovalPercent * 100.0f, *ChannelName, ReducedThisChannel);
+				EntriesToRemove, RemovalPercent * 100.0f, ULMChannelNameFromId(ChannelId), ReducedThisChannel);
 		}
 	}
 	
@@ -925,29 +1576,27 @@ void UULMSubsystem::TrimMemoryBudget()
 		TEXT("Memory trimming performance: freed %lld bytes from %d channels"), TotalReduced, ChannelsByUsage.Num());
 }
 
-void UULMSubsystem::TrimChannelForMemory(const FString& ChannelName, int32 EntriesToRemove)
+void UULMSubsystem::TrimChannelForMemory(EULMChannelId ChannelId, int32 EntriesToRemove)
 {
-	TArray<FULMLogEntry>* ChannelEntries = LogEntries.Find(ChannelName);
-	if (!ChannelEntries || EntriesToRemove <= 0 || ChannelEntries->Num() == 0)
+	if (!ULMIsValidChannelId(ChannelId))
 	{
 		return;
 	}
 	
-	// Ensure we don't remove more entries than exist
-	EntriesToRemove = FMath::Min(EntriesToRemove, ChannelEntries->Num());
-	
-	// Calculate memory to be removed
-	SIZE_T MemoryToRemove = 0;
-	for (int32 i = 0; i < EntriesToRemove; ++i)
+	FULMChannelLogStore& ChannelEntries = StorageShards[static_cast<int32>(ChannelId)].Store;
+	if (EntriesToRemove <= 0 || ChannelEntries.Num() == 0)
 	{
-		MemoryToRemove += MemoryTracker.CalculateLogEntrySize((*ChannelEntries)[i]);
+		return;
 	}
 	
-	// Remove oldest entries (from the beginning of the array)
-	ChannelEntries->RemoveAt(0, EntriesToRemove, EAllowShrinking::No);
+	// Ensure we don't remove more entries than exist
+	EntriesToRemove = FMath::Min(EntriesToRemove, ChannelEntries.Num());
+	
+	// Remove oldest entries - chunks whose entries have all aged out are freed whole
+	const SIZE_T MemoryToRemove = ChannelEntries.RemoveOldest(EntriesToRemove);
 	
 	// Update memory tracking
-	MemoryTracker.RemoveMemoryUsage(ChannelName, MemoryToRemove);
+	MemoryTracker.RemoveMemoryUsage(ChannelId, MemoryToRemove, EntriesToRemove);
 }
 
 
@@ -1153,6 +1802,12 @@ void UULMSubsystem::ApplySettings()
 	// Apply memory budget
 	MemoryTracker.SetMemoryBudget(Settings->MemoryBudgetMB * 1024 * 1024);
 	
+	// Apply queue bounds
+	SetQueueLimits(Settings->MaxQueueSize, static_cast<int64>(Settings->MaxQueueMemoryMB) * 1024 * 1024);
+	SetBatchingLimits(Settings->BatchProcessingSize, Settings->ThreadSleepTimeMs, Settings->FileWriterFlushInterval);
+	SetWaitStrategies(Settings->ProcessorWaitStrategy, Settings->FileWriterWaitStrategy);
+	SetRepeatCollapseWindow(Settings->RepeatCollapseWindowSeconds);
+	
 	// Apply rotation configuration
 	if (LogRotator && RetentionManager)
 	{
@@ -1338,6 +1993,102 @@ void UULMSubsystem::LogSystemHealthStatus() const
 		bQueueHealthy ? TEXT("HEALTHY") : TEXT("DEGRADED"),
 		QueueDiag.ProcessedCount.GetValue(), QueueDiag.DroppedCount.GetValue());
 	
+	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, 
+		TEXT("Repeat Collapsing: %d identical entries folded into summaries"), QueueDiag.CollapsedCount.GetValue());
+	
+	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, 
+		TEXT("Queue Depth: %d/%d entries, %lld/%lld bytes"), 
+		LogMessageQueue.Num(), MaxQueueEntries.load(std::memory_order_relaxed), GetQueuedBytes(), MaxQueueBytes.load(std::memory_order_relaxed));
+	
+	EULMVerbosity PriorityVerbosity = QueueDiag.PriorityLaneFullCount.GetValue() == 0 ? EULMVerbosity::Message : EULMVerbosity::Warning;
+	ULM_LOG(CHANNEL_SUBSYSTEM, PriorityVerbosity, 
+		TEXT("Priority Lane: %d/%d entries, %d enqueued, %d fell back to the normal lane"), 
+		PriorityMessageQueue.Num(), PriorityMessageQueue.GetCapacity(), QueueDiag.PriorityEnqueueCount.GetValue(), QueueDiag.PriorityLaneFullCount.GetValue());
+	
+	// Per-thread throughput - a single producer with most of the drops is the spam source being held to its share
+	for (const FULMProducerStats& Producer : GetProducerDiagnostics())
+	{
+		// Threads that found every slot taken are lumped together and held to one share between them
+		if (Producer.SharedClaims > 0)
+		{
+			ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, 
+				TEXT("Producer %s: %lld threads fell back to the shared slot with all %d slots taken"), 
+				*Producer.Name, Producer.SharedClaims, FULMProducerRegistry::MAX_PRODUCERS);
+		}
+		
+		if (Producer.Enqueued > 0 || Producer.Dropped > 0)
+		{
+			ULM_LOG(CHANNEL_SUBSYSTEM, Producer.Dropped > 0 ? EULMVerbosity::Warning : EULMVerbosity::Message, 
+				TEXT("Producer %s: %lld enqueued, %lld dropped, %d queued (weight %.2f)"), 
+				*Producer.Name, Producer.Enqueued, Producer.Dropped, Producer.Queued, Producer.Weight);
+		}
+	}
+	
+	if (!bQueueHealthy)
+	{
+		ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, 
+			TEXT("Queue Drops by Policy: DropNewest %d, DropOldest %d, BlockWithTimeout %d, SampleUnderPressure %d"), 
+			QueueDiag.GetDropCount(EULMOverflowPolicy::DropNewest), QueueDiag.GetDropCount(EULMOverflowPolicy::DropOldest),
+			QueueDiag.GetDropCount(EULMOverflowPolicy::BlockWithTimeout), QueueDiag.GetDropCount(EULMOverflowPolicy::SampleUnderPressure));
+		
+		for (int32 ChannelIndex = 0; ChannelIndex < ULM_CHANNEL_COUNT; ++ChannelIndex)
+		{
+			const EULMChannelId ChannelId = static_cast<EULMChannelId>(ChannelIndex);
+			if (const int32 ChannelDrops = QueueDiag.GetDropCount(ChannelId))
+			{
+				ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, 
+					TEXT("Queue Drops on %s: %d"), ULMChannelNameFromId(ChannelId), ChannelDrops);
+			}
+		}
+	}
+	
+	// Sampling - kept entries carry weight Seen/Kept on average, so counts rebuilt from the weights match Seen
+	for (int32 ChannelIndex = 0; ChannelIndex < ULM_CHANNEL_COUNT; ++ChannelIndex)
+	{
+		const EULMChannelId ChannelId = static_cast<EULMChannelId>(ChannelIndex);
+		const FULMSamplerStats Sampling = ULMSampling::GetStats(ChannelId);
+		if (Sampling.Seen > 0)
+		{
+			ULM_LOG(CHANNEL_PERFORMANCE, EULMVerbosity::Message, 
+				TEXT("Sampling on %s: %s, %lld kept of %lld, 1 in %u"), 
+				ULMChannelNameFromId(ChannelId), *UEnum::GetDisplayValueAsText(Sampling.Mode).ToString(), Sampling.Kept, Sampling.Seen, Sampling.CurrentRate);
+		}
+	}
+	
+	// Batch controllers - a batch pinned at its limit with a growing backlog means the bound is too low
+	const FULMBatchControllerStats ProcessorBatch = GetProcessorBatchStats();
+	ULM_LOG(CHANNEL_PERFORMANCE, EULMVerbosity::Message, 
+		TEXT("Processor Batching: batch %d, wait %d ms, %.0f/s in, %.0f/s out, %.2f ms/batch, %lld idle wakeups of %lld"), 
+		ProcessorBatch.BatchSize, ProcessorBatch.WaitMs, ProcessorBatch.ArrivalRate, ProcessorBatch.DrainRate, 
+		ProcessorBatch.AverageBatchMs, ProcessorBatch.IdleWakeups, ProcessorBatch.Batches);
+	
+	const FULMBatchControllerStats WriterBatch = GetFileWriterBatchStats();
+	ULM_LOG(CHANNEL_PERFORMANCE, EULMVerbosity::Message, 
+		TEXT("File Writer Batching: batch %d, wait %d ms, flush every %.2f s, %.0f/s in, %.0f/s out, %lld idle wakeups of %lld, %d flushes"), 
+		WriterBatch.BatchSize, WriterBatch.WaitMs, FileWriter ? FileWriter->GetCurrentFlushInterval() : 0.0f, 
+		WriterBatch.ArrivalRate, WriterBatch.DrainRate, WriterBatch.IdleWakeups, WriterBatch.Batches, 
+		GetFileIODiagnostics().FlushCount.GetValue());
+	
+	// Wait strategies - most wakeups should come from spinning under load and from parks when idle
+	const FULMThreadParkerStats ProcessorWait = GetProcessorWaitStats();
+	ULM_LOG(CHANNEL_PERFORMANCE, EULMVerbosity::Message, 
+		TEXT("Processor Waits (%s): %lld spin, %lld yield, %lld parked (%lld timed out), %lld signals, %.1f us average wakeup"), 
+		*UEnum::GetDisplayValueAsText(ProcessorWait.Strategy).ToString(), ProcessorWait.SpinWakeups, ProcessorWait.YieldWakeups, 
+		ProcessorWait.Parks, ProcessorWait.ParkTimeouts, ProcessorWait.Signals, ProcessorWait.AverageWakeupMicros);
+	
+	const FULMThreadParkerStats WriterWait = GetFileWriterWaitStats();
+	ULM_LOG(CHANNEL_PERFORMANCE, EULMVerbosity::Message, 
+		TEXT("File Writer Waits (%s): %lld spin, %lld yield, %lld parked (%lld timed out), %lld signals, %.1f us average wakeup"), 
+		*UEnum::GetDisplayValueAsText(WriterWait.Strategy).ToString(), WriterWait.SpinWakeups, WriterWait.YieldWakeups, 
+		WriterWait.Parks, WriterWait.ParkTimeouts, WriterWait.Signals, WriterWait.AverageWakeupMicros);
+	
+	// A flat overflow block count under load means short messages are enqueued without any heap allocation
+	const FULMMessageBufferStats BufferStats = FULMMessageBuffer::GetStats();
+	const int32 InlineMessages = FMath::Max(0, QueueDiag.EnqueueCount.GetValue() - QueueDiag.OverflowMessageCount.GetValue());
+	ULM_LOG(CHANNEL_PERFORMANCE, EULMVerbosity::Message, 
+		TEXT("Message Storage: %d inline, %lld overflow, %lld overflow block allocations (%d pooled)"), 
+		InlineMessages, BufferStats.OverflowMessages, BufferStats.OverflowBlockAllocations, BufferStats.PooledOverflowBlocks);
+	
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("=== End Health Report ==="));
 	
 	// Log to performance channel for monitoring
@@ -0,0 +1,117 @@
+#include "Core/ULMThreadParker.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+// Smoothing factor for the wakeup latency average
+static constexpr float WakeupSmoothing = 0.1f;
+
+FULMThreadParker::FULMThreadParker(EULMWaitStrategy InStrategy)
+	: Event(FPlatformProcess::GetSynchEventFromPool(false))
+	, Strategy(InStrategy)
+{
+}
+
+FULMThreadParker::~FULMThreadParker()
+{
+	if (Event)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(Event);
+		Event = nullptr;
+	}
+}
+
+void FULMThreadParker::Wait(TFunctionRef<bool()> HasWork, int32 TimeoutMs)
+{
+	const EULMWaitStrategy CurrentStrategy = Strategy.load(std::memory_order_relaxed);
+	if (CurrentStrategy != EULMWaitStrategy::Blocking)
+	{
+		const bool bLowLatency = CurrentStrategy == EULMWaitStrategy::LowLatency;
+		const double StartTime = FPlatformTime::Seconds();
+		const double SpinEnd = StartTime + (bLowLatency ? LOW_LATENCY_SPIN_MICROS : HYBRID_SPIN_MICROS) / 1000000.0;
+		const double YieldEnd = StartTime + (bLowLatency ? LOW_LATENCY_YIELD_MICROS : HYBRID_YIELD_MICROS) / 1000000.0;
+
+		// Spin - catches the next message of a burst without giving up the core
+		do
+		{
+			if (HasWork())
+			{
+				SpinWakeups.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			FPlatformProcess::YieldCycles(SPIN_PAUSE_CYCLES);
+		}
+		while (FPlatformTime::Seconds() < SpinEnd);
+
+		// Yield - lets other ready threads run while staying off the event
+		do
+		{
+			if (HasWork())
+			{
+				YieldWakeups.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			FPlatformProcess::Yield();
+		}
+		while (FPlatformTime::Seconds() < YieldEnd);
+	}
+
+	// Park - the flag store and the HasWork recheck pair with the producer's enqueue and flag load in Notify,
+	// so either the producer sees the flag and triggers, or we see its entry here
+	bParked.store(true, std::memory_order_seq_cst);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (HasWork())
+	{
+		bParked.store(false, std::memory_order_relaxed);
+		SpinWakeups.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Parks.fetch_add(1, std::memory_order_relaxed);
+	const bool bSignalled = Event->Wait(FMath::Max(1, TimeoutMs));
+	bParked.store(false, std::memory_order_relaxed);
+
+	if (!bSignalled)
+	{
+		ParkTimeouts.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	const uint64 SignalStamp = SignalCycles.exchange(0, std::memory_order_relaxed);
+	if (SignalStamp != 0)
+	{
+		const float WakeupMicros = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - SignalStamp) * 1000.0);
+		const float Average = AverageWakeupMicros.load(std::memory_order_relaxed);
+		AverageWakeupMicros.store(Average + WakeupSmoothing * (WakeupMicros - Average), std::memory_order_relaxed);
+	}
+}
+
+void FULMThreadParker::Notify()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	
+	// Only the first producer to see the flag pays for the trigger
+	if (bParked.load(std::memory_order_relaxed) && bParked.exchange(false, std::memory_order_relaxed))
+	{
+		SignalCycles.store(FPlatformTime::Cycles64(), std::memory_order_relaxed);
+		Signals.fetch_add(1, std::memory_order_relaxed);
+		Event->Trigger();
+	}
+}
+
+void FULMThreadParker::WakeUp()
+{
+	Event->Trigger();
+}
+
+FULMThreadParkerStats FULMThreadParker::GetStats() const
+{
+	FULMThreadParkerStats Stats;
+	Stats.Strategy = Strategy.load(std::memory_order_relaxed);
+	Stats.SpinWakeups = SpinWakeups.load(std::memory_order_relaxed);
+	Stats.YieldWakeups = YieldWakeups.load(std::memory_order_relaxed);
+	Stats.Parks = Parks.load(std::memory_order_relaxed);
+	Stats.ParkTimeouts = ParkTimeouts.load(std::memory_order_relaxed);
+	Stats.Signals = Signals.load(std::memory_order_relaxed);
+	Stats.AverageWakeupMicros = AverageWakeupMicros.load(std::memory_order_relaxed);
+	return Stats;
+}
@@ -0,0 +1,114 @@
+#include "Core/ULMThreadParker.h"
+#include "Channels/ULMLogCategories.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Thread.h"
+#include <atomic>
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Wakeup latency and idle cost of each EULMWaitStrategy
+ * A consumer thread waits on a private FULMThreadParker while this thread publishes a timestamp and calls
+ * Notify, GapMs apart, as producers do on enqueue; the consumer records signal-to-run latency. A second pass
+ * leaves the consumer idle with the processor's longest wait timeout and counts how often it wakes up.
+ */
+
+static constexpr int32 IdleWaitTimeoutMs = 100;
+static constexpr double IdleMeasureSeconds = 1.0;
+
+static void MeasureWakeupLatency(EULMWaitStrategy Strategy, int32 NumSignals, float GapSeconds, TArray<double>& OutLatencyMicros)
+{
+	FULMThreadParker Parker(Strategy);
+	std::atomic<uint64> SignalStamp{0};
+	std::atomic<bool> bStop{false};
+
+	OutLatencyMicros.Reset(NumSignals);
+
+	FThread Consumer(TEXT("ULMWaitBenchmarkConsumer"), [&]()
+	{
+		while (!bStop.load(std::memory_order_relaxed))
+		{
+			Parker.Wait([&]() { return SignalStamp.load(std::memory_order_acquire) != 0 || bStop.load(std::memory_order_relaxed); }, IdleWaitTimeoutMs);
+
+			const uint64 Stamp = SignalStamp.exchange(0, std::memory_order_acq_rel);
+			if (Stamp != 0)
+			{
+				OutLatencyMicros.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Stamp) * 1000.0);
+			}
+		}
+	});
+
+	for (int32 Signal = 0; Signal < NumSignals; ++Signal)
+	{
+		FPlatformProcess::Sleep(GapSeconds);
+		SignalStamp.store(FPlatformTime::Cycles64(), std::memory_order_release);
+		Parker.Notify();
+	}
+
+	// Give the last signal time to land before stopping
+	FPlatformProcess::Sleep(GapSeconds);
+	bStop.store(true, std::memory_order_relaxed);
+	Parker.WakeUp();
+	Consumer.Join();
+}
+
+static FULMThreadParkerStats MeasureIdleWakeups(EULMWaitStrategy Strategy, int64& OutWakeups)
+{
+	FULMThreadParker Parker(Strategy);
+	std::atomic<bool> bStop{false};
+	std::atomic<int64> Wakeups{0};
+
+	FThread Consumer(TEXT("ULMWaitBenchmarkIdle"), [&]()
+	{
+		while (!bStop.load(std::memory_order_relaxed))
+		{
+			Parker.Wait([&]() { return bStop.load(std::memory_order_relaxed); }, IdleWaitTimeoutMs);
+			Wakeups.fetch_add(1, std::memory_order_relaxed);
+		}
+	});
+
+	FPlatformProcess::Sleep(static_cast<float>(IdleMeasureSeconds));
+	OutWakeups = Wakeups.load(std::memory_order_relaxed);
+	const FULMThreadParkerStats Stats = Parker.GetStats();
+
+	bStop.store(true, std::memory_order_relaxed);
+	Parker.WakeUp();
+	Consumer.Join();
+	return Stats;
+}
+
+static void RunWaitStrategyBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumSignals = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 10, 100000) : 1000;
+	const float GapSeconds = (Args.Num() > 1 ? FMath::Clamp(FCString::Atof(*Args[1]), 0.0f, 1000.0f) : 1.0f) / 1000.0f;
+
+	const UEnum* StrategyEnum = StaticEnum<EULMWaitStrategy>();
+	for (const EULMWaitStrategy Strategy : { EULMWaitStrategy::Blocking, EULMWaitStrategy::Hybrid, EULMWaitStrategy::LowLatency })
+	{
+		TArray<double> Latencies;
+		MeasureWakeupLatency(Strategy, NumSignals, GapSeconds, Latencies);
+		Latencies.Sort();
+
+		const auto Percentile = [&Latencies](double Fraction)
+		{
+			return Latencies.Num() > 0 ? Latencies[FMath::Min(Latencies.Num() - 1, static_cast<int32>(Latencies.Num() * Fraction))] : 0.0;
+		};
+
+		int64 IdleWakeups = 0;
+		const FULMThreadParkerStats IdleStats = MeasureIdleWakeups(Strategy, IdleWakeups);
+
+		UE_LOG(ULM, Display, TEXT("ULM wait strategy %s: signal-to-run median %.1f us, p99 %.1f us, max %.1f us (%d/%d signals seen); idle %.1f wakeups/s (%lld spin, %lld yield, %lld parks)"),
+			*StrategyEnum->GetDisplayNameTextByValue(static_cast<int64>(Strategy)).ToString(),
+			Percentile(0.5), Percentile(0.99), Latencies.Num() > 0 ? Latencies.Last() : 0.0, Latencies.Num(), NumSignals,
+			IdleWakeups / IdleMeasureSeconds, IdleStats.SpinWakeups, IdleStats.YieldWakeups, IdleStats.Parks);
+	}
+}
+
+static FAutoConsoleCommand GULMWaitStrategiesCommand(
+	TEXT("ULM.WaitStrategies"),
+	TEXT("Measure signal-to-run latency and idle wakeups/s for each worker wait strategy. Usage: ULM.WaitStrategies [Signals=1000] [GapMs=1]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunWaitStrategyBenchmark));
+
+#endif
@@ -9,31 +9,28 @@
 #include "Misc/Paths.h"
 #include "Engine/Engine.h"
 
-FULMFileWriter::FULMFileWriter(UULMSubsystem* InOwner, TQueue<FULMFileWriteEntry, EQueueMode::Spsc>& InWriteQueue)
+FULMFileWriter::FULMFileWriter(UULMSubsystem* InOwner, TQueue<FULMFileWriteEntry, EQueueMode::Spsc>& InWriteQueue, TQueue<FULMFileWriteEntry, EQueueMode::Spsc>& InPriorityWriteQueue)
 	: bStopRequested(false)
-	, WakeUpEvent(nullptr)
+	, Parker(EULMWaitStrategy::Blocking)
 	, Owner(InOwner)
 	, WriteQueue(InWriteQueue)
-	, BatchSize(DEFAULT_BATCH_SIZE)
+	, PriorityWriteQueue(InPriorityWriteQueue)
+	, BatchController(MIN_BATCH_SIZE, MAX_BATCH_SIZE, MIN_WAIT_MS, DEFAULT_MAX_WAIT_MS, TARGET_BATCH_MS)
 	, FlushIntervalSeconds(5.0f)
+	, CurrentFlushIntervalSeconds(MIN_FLUSH_INTERVAL)
 	, LastFlushTime(0.0)
+	, BytesSinceFlush(0)
 	, BaseLogPath(FPaths::ProjectLogDir() / TEXT("ULM"))
 {
-	WakeUpEvent = FPlatformProcess::GetSynchEventFromPool(false);
 }
 
 FULMFileWriter::~FULMFileWriter()
 {
-	if (WakeUpEvent)
-	{
-		FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
-		WakeUpEvent = nullptr;
-	}
 }
 
 bool FULMFileWriter::Init()
 {
-	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("ULMFileWriter: Initializing asynchronous file writer with batch size %d"), BatchSize);
+	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("ULMFileWriter: Initializing asynchronous file writer with adaptive batch size (starting at %d)"), BatchController.GetBatchSize());
 	
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 	if (!PlatformFile.DirectoryExists(*BaseLogPath))
@@ -60,23 +57,46 @@ uint32 FULMFileWriter::Run()
 	
 	while (!bStopRequested.Load())
 	{
-		ProcessWriteQueue();
+		ProcessPriorityQueue();
+		
+		const double BatchStartTime = FPlatformTime::Seconds();
+		const int32 Processed = ProcessWriteQueue(BatchController.GetBatchSize());
+		BatchController.RecordBatch(Processed, PendingWrites.load(std::memory_order_relaxed), FPlatformTime::Seconds() - BatchStartTime);
 		
 		if (ShouldFlush())
 		{
-			FlushAllFiles();
-			LastFlushTime = FPlatformTime::Seconds();
+			const double CurrentTime = FPlatformTime::Seconds();
+			UpdateFlushInterval(CurrentTime - LastFlushTime);
+			
+			// Nothing written since the last flush - skip the syscalls
+			if (BytesSinceFlush > 0)
+			{
+				FlushAllFiles();
+				Diagnostics.FlushCount.Increment();
+			}
+			BytesSinceFlush = 0;
+			LastFlushTime = CurrentTime;
 		}
 		
-		if (WriteQueue.IsEmpty())
+		if (WriteQueue.IsEmpty() && PriorityWriteQueue.IsEmpty())
 		{
-			WakeUpEvent->Wait(FTimespan::FromMilliseconds(100));
+			// Never sleep past the next due flush while unflushed data is pending
+			int32 WaitMs = BatchController.GetWaitMs();
+			if (BytesSinceFlush > 0)
+			{
+				const double UntilFlushMs = (LastFlushTime + CurrentFlushIntervalSeconds.load(std::memory_order_relaxed) - FPlatformTime::Seconds()) * 1000.0;
+				WaitMs = FMath::Clamp(FMath::CeilToInt(UntilFlushMs), 1, WaitMs);
+			}
+			Parker.Wait([this]() { return !WriteQueue.IsEmpty() || !PriorityWriteQueue.IsEmpty(); }, WaitMs);
 		}
 	}
 	
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("File writer thread shutdown requested - flushing and closing files..."));
 	
-	ProcessWriteQueue();
+	ProcessPriorityQueue();
+	while (ProcessWriteQueue(MAX_BATCH_SIZE) > 0)
+	{
+	}
 	FlushAllFiles();
 	CloseAllFiles();
 	
@@ -99,27 +119,32 @@ void FULMFileWriter::Stop()
 void FULMFileWriter::RequestStop()
 {
 	bStopRequested.Store(true);
-	WakeUp();
+	Parker.WakeUp();
 }
 
-void FULMFileWriter::WakeUp()
+void FULMFileWriter::NotifyQueued()
 {
-	if (WakeUpEvent)
-	{
-		WakeUpEvent->Trigger();
-	}
+	PendingWrites.fetch_add(1, std::memory_order_relaxed);
+	Parker.Notify();
 }
 
 void FULMFileWriter::SetBatchSize(int32 NewBatchSize)
 {
-	BatchSize = FMath::Clamp(NewBatchSize, 1, MAX_BATCH_SIZE);
-	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("ULMFileWriter: Batch size set to %d"), BatchSize);
+	const int32 MaxBatch = FMath::Clamp(NewBatchSize, 1, MAX_BATCH_SIZE);
+	BatchController.SetBatchBounds(FMath::Min(MIN_BATCH_SIZE, MaxBatch), MaxBatch);
+	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("ULMFileWriter: Batch size limit set to %d"), MaxBatch);
 }
 
 void FULMFileWriter::SetFlushInterval(float NewFlushIntervalSeconds)
 {
-	FlushIntervalSeconds = FMath::Max(0.1f, NewFlushIntervalSeconds);
-	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("ULMFileWriter: Flush interval set to %.2f seconds"), FlushIntervalSeconds);
+	const float MaxInterval = FMath::Max(0.1f, NewFlushIntervalSeconds);
+	FlushIntervalSeconds.store(MaxInterval, std::memory_order_relaxed);
+	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("ULMFileWriter: Flush interval limit set to %.2f seconds"), MaxInterval);
+}
+
+void FULMFileWriter::SetMaxWaitMs(int32 NewMaxWaitMs)
+{
+	BatchController.SetWaitBounds(MIN_WAIT_MS, NewMaxWaitMs);
 }
 
 void FULMFileWriter::SetBaseLogPath(const FString& NewBasePath)
@@ -135,29 +160,49 @@ void FULMFileWriter::SetBaseLogPath(const FString& NewBasePath)
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("ULMFileWriter: Base log path set to %s"), *BaseLogPath);
 }
 
-void FULMFileWriter::ProcessWriteQueue()
+int32 FULMFileWriter::ProcessWriteQueue(int32 MaxEntries)
 {
 	if (WriteQueue.IsEmpty())
 	{
-		return;
+		return 0;
 	}
 	
 	TArray<FULMFileWriteEntry> Batch;
-	Batch.Reserve(BatchSize);
+	Batch.Reserve(MaxEntries);
 	
 	FULMFileWriteEntry Entry;
-	while (Batch.Num() < BatchSize && WriteQueue.Dequeue(Entry))
+	while (Batch.Num() < MaxEntries && WriteQueue.Dequeue(Entry))
 	{
-		Batch.Add(Entry);
+		Batch.Add(MoveTemp(Entry));
 	}
 	
 	if (Batch.Num() > 0)
 	{
+		PendingWrites.fetch_sub(Batch.Num(), std::memory_order_relaxed);
 		ProcessBatch(Batch);
 	}
+	return Batch.Num();
+}
+
+void FULMFileWriter::ProcessPriorityQueue()
+{
+	if (PriorityWriteQueue.IsEmpty())
+	{
+		return;
+	}
+	
+	// Drain completely - error and critical lines are rare, and none should wait behind the batch limit
+	TArray<FULMFileWriteEntry> Batch;
+	FULMFileWriteEntry Entry;
+	while (PriorityWriteQueue.Dequeue(Entry))
+	{
+		Batch.Add(MoveTemp(Entry));
+	}
+	
+	ProcessBatch(Batch, true);
 }
 
-void FULMFileWriter::ProcessBatch(TArray<FULMFileWriteEntry>& Batch)
+void FULMFileWriter::ProcessBatch(TArray<FULMFileWriteEntry>& Batch, bool bFlushAfterWrite)
 {
 	double StartTime = FPlatformTime::Seconds();
 	
@@ -183,7 +228,10 @@ void FULMFileWriter::ProcessBatch(TArray<FULMFileWriteEntry>& Batch)
 			CombinedContent += Line + TEXT("\n");
 		}
 		
-		WriteToFile(FilePath, CombinedContent);
+		if (WriteToFile(FilePath, CombinedContent, bFlushAfterWrite) && bFlushAfterWrite)
+		{
+			Diagnostics.PriorityLineCount.Add(Lines.Num());
+		}
 	}
 	
 	double EndTime = FPlatformTime::Seconds();
@@ -191,7 +239,7 @@ void FULMFileWriter::ProcessBatch(TArray<FULMFileWriteEntry>& Batch)
 	Diagnostics.BatchCount.Increment();
 }
 
-void FULMFileWriter::WriteToFile(const FString& FilePath, const FString& Content)
+bool FULMFileWriter::WriteToFile(const FString& FilePath, const FString& Content, bool bFlush)
 {
 	FScopeLock Lock(&FileMapLock);
 	
@@ -200,7 +248,7 @@ void FULMFileWriter::WriteToFile(const FString& FilePath, const FString& Content
 	{
 		Diagnostics.FailedWrites.Increment();
 		ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Warning, TEXT("ULMFileWriter: Failed to open file for writing: %s"), *FilePath);
-		return;
+		return false;
 	}
 	
 	FTCHARToUTF8 UTF8Content(*Content);
@@ -211,11 +259,23 @@ void FULMFileWriter::WriteToFile(const FString& FilePath, const FString& Content
 	Diagnostics.WriteCount.Increment();
 	Diagnostics.TotalBytesWritten.Add(BytesToWrite);
 	
+	if (bFlush)
+	{
+		FileArchive->Flush();
+		Diagnostics.PriorityFlushCount.Increment();
+	}
+	else
+	{
+		BytesSinceFlush += BytesToWrite;
+	}
+	
 	if (FileArchive->IsError())
 	{
 		Diagnostics.FailedWrites.Increment();
 		ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Error, TEXT("ULMFileWriter: Error writing to file: %s"), *FilePath);
+		return false;
 	}
+	return true;
 }
 
 void FULMFileWriter::FlushAllFiles()
@@ -279,5 +339,15 @@ void FULMFileWriter::UpdateWriteTimeDiagnostics(double StartTime, double EndTime
 bool FULMFileWriter::ShouldFlush() const
 {
 	double CurrentTime = FPlatformTime::Seconds();
-	return (CurrentTime - LastFlushTime) >= FlushIntervalSeconds;
+	return (CurrentTime - LastFlushTime) >= CurrentFlushIntervalSeconds.load(std::memory_order_relaxed);
+}
+
+void FULMFileWriter::UpdateFlushInterval(double ElapsedSeconds)
+{
+	const float MaxInterval = FlushIntervalSeconds.load(std::memory_order_relaxed);
+	const float MinInterval = FMath::Min(MIN_FLUSH_INTERVAL, MaxInterval);
+	
+	const double WriteRate = ElapsedSeconds > 0.0 ? BytesSinceFlush / ElapsedSeconds : 0.0;
+	const float Alpha = static_cast<float>(FMath::Clamp(WriteRate / HIGH_WRITE_RATE, 0.0, 1.0));
+	CurrentFlushIntervalSeconds.store(FMath::Lerp(MinInterval, MaxInterval, Alpha), std::memory_order_relaxed);
 }
\ No newline at end of file
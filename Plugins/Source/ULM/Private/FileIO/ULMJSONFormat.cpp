@@ -1,6 +1,7 @@
 #include "FileIO/ULMJSONFormat.h"
 #include "Core/ULMSubsystem.h"
 #include "Logging/ULMLogging.h"
+#include "Core/ULMClock.h"
 #include "Misc/DateTime.h"
 #include "Misc/Guid.h"
 #include "HAL/PlatformFilemanager.h"
@@ -44,6 +45,28 @@ FString FULMJSONFormatter::FormatAsJSON(const FULMLogEntry& Entry, const FULMJSO
 		JSONLog += FString::Printf(TEXT("\"thread_id\":\"%08X\","), Entry.ThreadId);
 		JSONLog += FString::Printf(TEXT("\"message\":\"%s\""), *EscapeJSONString(Entry.Message));
 		
+		if (Entry.Fields)
+		{
+			JSONLog += TEXT(",\"fields\":");
+			Entry.Fields->AppendJSON(JSONLog);
+		}
+		
+		// Only sampled entries carry a weight - every other entry counts once
+		if (Entry.SampleWeight != 1.0f)
+		{
+			JSONLog += FString::Printf(TEXT(",\"sample_weight\":%s"), *FString::SanitizeFloat(Entry.SampleWeight));
+		}
+		
+		if (Config.bIncludeSourceLocation)
+		{
+			if (const FULMCallsite* Callsite = Entry.GetCallsite())
+			{
+				JSONLog += FString::Printf(TEXT(",\"file\":\"%s\",\"line\":%d,\"function\":\"%s\",\"class\":\"%s\""),
+					*EscapeJSONString(Callsite->File), Callsite->Line,
+					*EscapeJSONString(Callsite->Function), *EscapeJSONString(Callsite->Class));
+			}
+		}
+		
 		if (Config.bIncludeSessionId)
 		{
 			JSONLog += FString::Printf(TEXT(",\"session_id\":\"%s\""), *SessionId);
@@ -72,6 +95,27 @@ FString FULMJSONFormatter::FormatAsJSON(const FULMLogEntry& Entry, const FULMJSO
 		JSONLog += FString::Printf(TEXT("  \"thread_id\": \"%08X\",\n"), Entry.ThreadId);
 		JSONLog += FString::Printf(TEXT("  \"message\": \"%s\""), *EscapeJSONString(Entry.Message));
 		
+		if (Entry.Fields)
+		{
+			JSONLog += TEXT(",\n  \"fields\": ");
+			Entry.Fields->AppendJSON(JSONLog);
+		}
+		
+		if (Entry.SampleWeight != 1.0f)
+		{
+			JSONLog += FString::Printf(TEXT(",\n  \"sample_weight\": %s"), *FString::SanitizeFloat(Entry.SampleWeight));
+		}
+		
+		if (Config.bIncludeSourceLocation)
+		{
+			if (const FULMCallsite* Callsite = Entry.GetCallsite())
+			{
+				JSONLog += FString::Printf(TEXT(",\n  \"file\": \"%s\",\n  \"line\": %d,\n  \"function\": \"%s\",\n  \"class\": \"%s\""),
+					*EscapeJSONString(Callsite->File), Callsite->Line,
+					*EscapeJSONString(Callsite->Function), *EscapeJSONString(Callsite->Class));
+			}
+		}
+		
 		if (Config.bIncludeSessionId)
 		{
 			JSONLog += FString::Printf(TEXT(",\n  \"session_id\": \"%s\""), *SessionId);
@@ -104,13 +148,13 @@ FString FULMJSONFormatter::FormatAsJSON(const FULMLogEntry& Entry, const FULMJSO
 
 FString FULMJSONFormatter::GetLocalTimestamp()
 {
-	return GetLocalTimestamp(FDateTime::Now());
+	return GetLocalTimestamp(FULMClock::Now());
 }
 
 FString FULMJSONFormatter::GetLocalTimestamp(const FDateTime& DateTime)
 {
-	// Use system local time instead of hardcoded timezone
-	FDateTime LocalTime = FDateTime::Now();
+	// DateTime is already local time - converted from the entry's capture cycles
+	const FDateTime& LocalTime = DateTime;
 	
 	// Get microseconds from the fractional part
 	int64 Ticks = LocalTime.GetTicks();
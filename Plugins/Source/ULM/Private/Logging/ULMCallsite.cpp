@@ -0,0 +1,77 @@
+#include "Logging/ULMCallsite.h"
+#include "Logging/ULMLogging.h"
+#include "FileIO/ULMInternalPath.h"
+#include "Misc/ScopeLock.h"
+
+// Descriptors live in fixed chunks so published entries never move - readers index without a lock
+static constexpr uint32 CallsiteChunkSize = 256;
+static constexpr uint32 MaxCallsiteChunks = 256;
+
+struct FULMCallsiteTable
+{
+	FCriticalSection RegisterLock;
+	std::atomic<FULMCallsite*> Chunks[MaxCallsiteChunks] = {};
+	std::atomic<uint32> NumCallsites{0};
+};
+
+static FULMCallsiteTable& GetCallsiteTable()
+{
+	// Intentionally leaked - callsite statics can outlive module shutdown ordering
+	static FULMCallsiteTable* Table = new FULMCallsiteTable();
+	return *Table;
+}
+
+static const FULMCallsite AnonymousCallsite;
+
+const FULMCallsite* FULMCallsiteRegistry::Register(const char* SourceFile, int32 Line, const char* Function, EULMChannelId ChannelId, const TCHAR* Format)
+{
+	FULMCallsiteTable& Table = GetCallsiteTable();
+	FScopeLock Lock(&Table.RegisterLock);
+
+	// IDs start at 1 so 0 can mean "no callsite"
+	const uint32 Index = Table.NumCallsites.load(std::memory_order_relaxed);
+	const uint32 ChunkIndex = Index / CallsiteChunkSize;
+	if (ChunkIndex >= MaxCallsiteChunks)
+	{
+		return &AnonymousCallsite;
+	}
+
+	FULMCallsite* Chunk = Table.Chunks[ChunkIndex].load(std::memory_order_relaxed);
+	if (!Chunk)
+	{
+		Chunk = new FULMCallsite[CallsiteChunkSize];
+		Table.Chunks[ChunkIndex].store(Chunk, std::memory_order_release);
+	}
+
+	FULMCallsite& Callsite = Chunk[Index % CallsiteChunkSize];
+	Callsite.Id = Index + 1;
+	Callsite.ChannelId = ChannelId;
+	Callsite.Line = Line;
+	Callsite.SourceFile = SourceFile;
+	Callsite.Format = Format;
+	Callsite.File = SourceFile ? ULMInternal::ToMinimalRiderPath(SourceFile) : FString();
+	Callsite.Function = Function ? ULMInternal::ExtractFunctionName(Function) : FString();
+	Callsite.Class = Function ? ULMInternal::ExtractClassName(Function) : FString();
+
+	// Publish after the descriptor is fully written
+	Table.NumCallsites.store(Index + 1, std::memory_order_release);
+	return &Callsite;
+}
+
+const FULMCallsite* FULMCallsiteRegistry::Find(uint32 CallsiteId)
+{
+	FULMCallsiteTable& Table = GetCallsiteTable();
+	if (CallsiteId == 0 || CallsiteId > Table.NumCallsites.load(std::memory_order_acquire))
+	{
+		return nullptr;
+	}
+
+	const uint32 Index = CallsiteId - 1;
+	const FULMCallsite* Chunk = Table.Chunks[Index / CallsiteChunkSize].load(std::memory_order_acquire);
+	return Chunk ? &Chunk[Index % CallsiteChunkSize] : nullptr;
+}
+
+int32 FULMCallsiteRegistry::Num()
+{
+	return static_cast<int32>(GetCallsiteTable().NumCallsites.load(std::memory_order_acquire));
+}
@@ -0,0 +1,46 @@
+#include "Logging/ULMDeferredFormat.h"
+#include "Hash/CityHash.h"
+
+void ULMFormatDeferredVarArgs(FString& OutMessage, const TCHAR* Format, ...)
+{
+	// Same growth strategy as FString::Printf - try a stack buffer first, then double on the heap until it fits
+	constexpr int32 StartingBufferSize = 512;
+	TCHAR StartingBuffer[StartingBufferSize];
+	TCHAR* Buffer = StartingBuffer;
+	int32 BufferSize = StartingBufferSize;
+
+	const TCHAR* Fmt = Format;
+	va_list ArgPtr;
+	va_start(ArgPtr, Format);
+	int32 Result = FCString::GetVarArgs(Buffer, BufferSize, Fmt, ArgPtr);
+	va_end(ArgPtr);
+
+	if (Result == -1)
+	{
+		Buffer = nullptr;
+		while (Result == -1)
+		{
+			BufferSize *= 2;
+			Buffer = static_cast<TCHAR*>(FMemory::Realloc(Buffer, BufferSize * sizeof(TCHAR)));
+
+			Fmt = Format;
+			va_start(ArgPtr, Format);
+			Result = FCString::GetVarArgs(Buffer, BufferSize, Fmt, ArgPtr);
+			va_end(ArgPtr);
+		}
+	}
+
+	Buffer[Result] = TEXT('\0');
+	OutMessage = Buffer;
+
+	if (Buffer != StartingBuffer)
+	{
+		FMemory::Free(Buffer);
+	}
+}
+
+uint64 FULMDeferredMessage::GetHash() const
+{
+	// The format literal's address identifies the format - string arguments are copied into the words
+	return CityHash64WithSeed(reinterpret_cast<const char*>(ArgWords.GetData()), static_cast<uint32>(ArgWords.Num() * sizeof(uint64)), static_cast<uint64>(reinterpret_cast<UPTRINT>(FormatString)));
+}
@@ -1,26 +1,21 @@
 #include "Logging/ULMLogProcessor.h"
 #include "Core/ULMSubsystem.h"
 #include "Logging/ULMLogging.h"
+#include "FileIO/ULMJSONFormat.h"
 #include "HAL/PlatformFilemanager.h"
-#include "HAL/Event.h"
 #include "Misc/DateTime.h"
 
-FULMLogProcessor::FULMLogProcessor(UULMSubsystem* InSubsystem, TQueue<FULMLogQueueEntry, EQueueMode::Spsc>& InQueue)
+FULMLogProcessor::FULMLogProcessor(UULMSubsystem* InSubsystem, TULMMpscQueue<FULMLogQueueEntry>& InQueue, TULMMpscQueue<FULMLogQueueEntry>& InPriorityQueue)
 	: Subsystem(InSubsystem)
 	, MessageQueue(InQueue)
-	, WakeUpEvent(nullptr)
+	, PriorityQueue(InPriorityQueue)
 	, bStopRequested(false)
+	, BatchController(MIN_BATCH_SIZE, DEFAULT_MAX_BATCH_SIZE, MIN_WAIT_MS, DEFAULT_MAX_WAIT_MS, TARGET_BATCH_MS)
 {
-	WakeUpEvent = FPlatformProcess::GetSynchEventFromPool(false);
 }
 
 FULMLogProcessor::~FULMLogProcessor()
 {
-	if (WakeUpEvent)
-	{
-		FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
-		WakeUpEvent = nullptr;
-	}
 }
 
 bool FULMLogProcessor::Init()
@@ -39,17 +34,33 @@ uint32 FULMLogProcessor::Run()
 	
 	while (!bStopRequested)
 	{
-		ProcessBatch();
+		const double BatchStartTime = FPlatformTime::Seconds();
+		const int32 Processed = ProcessBatch(BatchController.GetBatchSize());
+		BatchController.RecordBatch(Processed, MessageQueue.Num() + PriorityQueue.Num(), FPlatformTime::Seconds() - BatchStartTime);
 		
-		if (MessageQueue.IsEmpty())
+		// Reservoir windows close here even when their channel has gone quiet
+		ULMSampling::FlushReservoirs();
+		
+		// Producers signal us on enqueue once parked, so the timeout only bounds how long a quiet queue goes unchecked
+		if (MessageQueue.IsEmpty() && PriorityQueue.IsEmpty())
 		{
-			WakeUpEvent->Wait(SLEEP_TIME_MS);
+			Parker.Wait([this]() { return !MessageQueue.IsEmpty() || !PriorityQueue.IsEmpty(); }, BatchController.GetWaitMs());
 		}
 	}
 	
 	ULM_LOG(CHANNEL_SUBSYSTEM, EULMVerbosity::Message, TEXT("Log processor thread shutdown requested - processing remaining entries..."));
 	
-	ProcessBatch();
+	ULMSampling::FlushReservoirs(true);
+	
+	while (ProcessBatch(BatchController.GetBatchSize()) > 0)
+	{
+	}
+	
+	if (Subsystem)
+	{
+		FlushRepeatRuns(true);
+		Subsystem->FlushOutputLog();
+	}
 	
 	double EndTime = FPlatformTime::Seconds();
 	double RuntimeSeconds = EndTime - StartTime;
@@ -70,35 +81,41 @@ void FULMLogProcessor::Stop()
 void FULMLogProcessor::RequestStop()
 {
 	bStopRequested = true;
-	WakeUp();
+	Parker.WakeUp();
 }
 
-void FULMLogProcessor::WakeUp()
+void FULMLogProcessor::SetBatchingLimits(int32 MaxBatchSize, int32 MaxWaitMs)
 {
-	if (WakeUpEvent)
-	{
-		WakeUpEvent->Trigger();
-	}
+	BatchController.SetBatchBounds(FMath::Min(MIN_BATCH_SIZE, MaxBatchSize), MaxBatchSize);
+	BatchController.SetWaitBounds(MIN_WAIT_MS, MaxWaitMs);
 }
 
-void FULMLogProcessor::ProcessBatch()
+int32 FULMLogProcessor::ProcessBatch(int32 MaxEntries)
 {
 	if (!Subsystem)
 	{
-		return;
+		return 0;
 	}
 	
 	FULMLogQueueEntry Entry;
 	int32 ProcessedCount = 0;
 	
-	// Process entries in batches for better performance
-	while (ProcessedCount < BATCH_SIZE && MessageQueue.Dequeue(Entry))
+	// Process entries in batches for better performance - the priority lane is re-checked before every
+	// normal entry, so an error never waits behind more than the entry already in flight
+	while (ProcessedCount < MaxEntries && (PriorityQueue.Dequeue(Entry) || MessageQueue.Dequeue(Entry)))
 	{
 		// Record dequeue time for diagnostics
 		double StartTime = FPlatformTime::Seconds();
 		
-		// Process the entry
-		Subsystem->ProcessLogEntry(Entry);
+		// Process the entry - repeats of the channel's current run only free their queue space
+		if (TryCollapseRepeat(Entry))
+		{
+			Subsystem->CollapseLogEntry(Entry);
+		}
+		else
+		{
+			Subsystem->ProcessLogEntry(Entry);
+		}
 		
 		// Update diagnostics through subsystem
 		double EndTime = FPlatformTime::Seconds();
@@ -107,4 +124,91 @@ void FULMLogProcessor::ProcessBatch()
 		
 		ProcessedCount++;
 	}
+	
+	// Runs that outlived their window report now rather than waiting for a different entry
+	FlushRepeatRuns(false);
+	
+	// Mirror this cycle's entries to the Output Log in one pass
+	Subsystem->FlushOutputLog();
+	
+	return ProcessedCount;
+}
+
+void FULMLogProcessor::SetRepeatCollapseWindow(float WindowSeconds)
+{
+	const uint64 WindowCycles = WindowSeconds > 0.0f ? static_cast<uint64>(WindowSeconds / FPlatformTime::GetSecondsPerCycle64()) : 0;
+	RepeatWindowCycles.store(WindowCycles, std::memory_order_relaxed);
+}
+
+bool FULMLogProcessor::TryCollapseRepeat(const FULMLogQueueEntry& Entry)
+{
+	const uint64 WindowCycles = RepeatWindowCycles.load(std::memory_order_relaxed);
+	if (WindowCycles == 0 || !ULMIsValidChannelId(Entry.ChannelId))
+	{
+		return false;
+	}
+	
+	FRepeatRun& Run = RepeatRuns[static_cast<int32>(Entry.ChannelId)];
+	const uint64 ContentHash = Entry.GetContentHash();
+	
+	const bool bSameEntry = Run.bActive && Run.ContentHash == ContentHash && Run.CallsiteId == Entry.CallsiteId && Run.Verbosity == Entry.Verbosity;
+	if (bSameEntry && Entry.CaptureCycles <= Run.FirstCycles + WindowCycles)
+	{
+		++Run.Repeats;
+		Run.LastCycles = FMath::Max(Run.LastCycles, Entry.CaptureCycles);
+		Run.LastThreadId = Entry.ThreadId;
+		return true;
+	}
+	
+	// Anything else ends the run - its summary is stored ahead of the entry that broke it
+	EmitRepeatSummary(Entry.ChannelId, Run);
+	
+	Run.bActive = true;
+	Run.ContentHash = ContentHash;
+	Run.CallsiteId = Entry.CallsiteId;
+	Run.Verbosity = Entry.Verbosity;
+	Run.LastThreadId = Entry.ThreadId;
+	Run.FirstCycles = Entry.CaptureCycles;
+	Run.LastCycles = Entry.CaptureCycles;
+	Run.Repeats = 0;
+	return false;
+}
+
+void FULMLogProcessor::FlushRepeatRuns(bool bForce)
+{
+	// Disabling collapsing reports whatever was folded so far
+	const uint64 WindowCycles = RepeatWindowCycles.load(std::memory_order_relaxed);
+	const bool bExpireAll = bForce || WindowCycles == 0;
+	const uint64 Now = FULMClock::Capture();
+	
+	for (int32 Index = 0; Index < ULM_CHANNEL_COUNT; ++Index)
+	{
+		FRepeatRun& Run = RepeatRuns[Index];
+		if (Run.bActive && (bExpireAll || Now > Run.FirstCycles + WindowCycles))
+		{
+			EmitRepeatSummary(static_cast<EULMChannelId>(Index), Run);
+			Run.bActive = false;
+		}
+	}
+}
+
+void FULMLogProcessor::EmitRepeatSummary(EULMChannelId ChannelId, FRepeatRun& Run)
+{
+	if (!Run.bActive || Run.Repeats == 0)
+	{
+		return;
+	}
+	
+	FULMStructuredFields Fields;
+	Fields.AddInt(TEXT("repeats"), Run.Repeats);
+	Fields.AddString(TEXT("first"), FULMJSONFormatter::GetLocalTimestamp(FULMClock::ToDateTime(Run.FirstCycles)));
+	Fields.AddString(TEXT("last"), FULMJSONFormatter::GetLocalTimestamp(FULMClock::ToDateTime(Run.LastCycles)));
+	
+	// Same channel, callsite and verbosity as the entry it summarises, stamped at the last repeat
+	FULMLogQueueEntry Summary(TEXT("Previous message repeated"), MoveTemp(Fields), ChannelId, Run.Verbosity, Run.CallsiteId);
+	Summary.CaptureCycles = Run.LastCycles;
+	Summary.ThreadId = Run.LastThreadId;
+	Subsystem->ProcessGeneratedLogEntry(Summary);
+	
+	Run.Repeats = 0;
 }
\ No newline at end of file
@@ -5,34 +5,25 @@
 #include "Engine/Engine.h"
 #include "Engine/World.h"
 
-static TMap<FString, FLogCategoryBase*> DynamicLogCategories;
-
-// Channel-to-category mapping table to replace repetitive if/else chains
-static TMap<FString, FLogCategoryBase*> ChannelCategoryMap;
-static bool bChannelCategoryMapInitialized = false;
-
-static void InitializeChannelCategoryMap()
+// Channel-to-category mapping indexed by channel ID
+static FLogCategoryBase* GetChannelCategory(EULMChannelId ChannelId)
 {
-	if (bChannelCategoryMapInitialized)
+	switch (ChannelId)
 	{
-		return;
+		case EULMChannelId::Gameplay:		return &ULMGameplay;
+		case EULMChannelId::Network:		return &ULMNetwork;
+		case EULMChannelId::Performance:	return &ULMPerformance;
+		case EULMChannelId::Debug:			return &ULMDebug;
+		case EULMChannelId::AI:				return &ULMAI;
+		case EULMChannelId::Physics:		return &ULMPhysics;
+		case EULMChannelId::Audio:			return &ULMAudio;
+		case EULMChannelId::Animation:		return &ULMAnimation;
+		case EULMChannelId::UI:				return &ULMUI;
+		case EULMChannelId::Subsystem:		return &ULMSubsystem;
+		default:							return &ULM; // ULM, Custom and unknown channels use the master category
 	}
-	
-	ChannelCategoryMap.Add(TEXT("ULM"), &ULM);
-	ChannelCategoryMap.Add(TEXT("Default"), &ULM);
-	ChannelCategoryMap.Add(TEXT("Gameplay"), &ULMGameplay);
-	ChannelCategoryMap.Add(TEXT("Network"), &ULMNetwork);
-	ChannelCategoryMap.Add(TEXT("Performance"), &ULMPerformance);
-	ChannelCategoryMap.Add(TEXT("Debug"), &ULMDebug);
-	ChannelCategoryMap.Add(TEXT("AI"), &ULMAI);
-	ChannelCategoryMap.Add(TEXT("Physics"), &ULMPhysics);
-	ChannelCategoryMap.Add(TEXT("Audio"), &ULMAudio);
-	ChannelCategoryMap.Add(TEXT("Animation"), &ULMAnimation);
-	ChannelCategoryMap.Add(TEXT("UI"), &ULMUI);
-	ChannelCategoryMap.Add(TEXT("Subsystem"), &ULMSubsystem);
-	
-	bChannelCategoryMapInitialized = true;
 }
+
 static ELogVerbosity::Type GetUEVerbosity(EULMVerbosity Verbosity)
 {
 	switch (Verbosity)
@@ -50,13 +41,13 @@ static ELogVerbosity::Type GetUEVerbosity(EULMVerbosity Verbosity)
 	}
 }
 
-static void LogToUECategory(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const char* FileName = nullptr, int32 LineNumber = 0)
+static void LogToUECategory(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Message, const char* FileName = nullptr, int32 LineNumber = 0)
 {
 #if UE_BUILD_SHIPPING
 	// In shipping builds, UE disables logging categories (they become FNoLoggingCategory)
 	// So we fall back to LogTemp with channel prefixes
 	ELogVerbosity::Type UEVerbosity = GetUEVerbosity(Verbosity);
-	FString PrefixedMessage = FString::Printf(TEXT("[ULM %s] %s"), *ChannelName, *Message);
+	FString PrefixedMessage = FString::Printf(TEXT("[ULM %s] %s"), ULMChannelNameFromId(ChannelId), *Message);
 	UE_LOG(LogTemp, Log, TEXT("%s"), *PrefixedMessage);
 #else
 	// Full logging for development builds
@@ -81,33 +72,58 @@ static void LogToUECategory(const FString& ChannelName, EULMVerbosity Verbosity,
 	const char* LogFileName = FileName ? FileName : __FILE__;
 	int32 LogLineNumber = LineNumber > 0 ? LineNumber : __LINE__;
 	
-	// Initialize channel mapping on first use
-	InitializeChannelCategoryMap();
-	
 	// Look up the appropriate log category for this channel
-	FLogCategoryBase** FoundCategory = ChannelCategoryMap.Find(ChannelName);
-	FLogCategoryBase* CategoryToUse = FoundCategory ? *FoundCategory : &ULM; // Default to ULM category
+	FLogCategoryBase* CategoryToUse = GetChannelCategory(ChannelId);
 	
 	FMsg::Logf(LogFileName, LogLineNumber, CategoryToUse->GetCategoryName(), UEVerbosity, TEXT("%s"), *FormattedMessage);
 #endif
 }
 
 
-void ULMLogCriticalSystem(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const char* FileName, int32 LineNumber)
+void ULMLogCriticalSystem(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Message, const char* FileName, int32 LineNumber, uint32 CallsiteId)
 {
 	// Critical system logging - always logs to UE console, bypasses all checks
 	// Used for initialization/shutdown when ULM system might not be fully ready
-	LogToUECategory(ChannelName, Verbosity, Message, FileName, LineNumber);
+	LogToUECategory(ChannelId, Verbosity, Message, FileName, LineNumber);
 	
-	// If subsystem is available, also store internally for JSON output
+	// If subsystem is available, also store internally for JSON output - storage still honours the channel settings,
+	// and the processor skips its Output Log mirror since the line was just written above
 	UULMSubsystem* Subsystem = GULMSubsystem.load(std::memory_order_acquire);
 	if (Subsystem)
 	{
-		Subsystem->StoreLogEntryInternal(Message, ChannelName, Verbosity);
+		Subsystem->StoreMirroredLogEntry(Message, ChannelId, Verbosity, CallsiteId);
+	}
+}
+
+void ULMLogCriticalSystem(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const char* FileName, int32 LineNumber, uint32 CallsiteId)
+{
+	ULMLogCriticalSystem(ULMInternal::ResolveChannelId(ChannelName), Verbosity, Message, FileName, LineNumber, CallsiteId);
+}
+
+void ULMLogMessage(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName, int32 LineNumber, uint32 CallsiteId)
+{
+	// Thread-safe access to global state
+	FULMChannelRegistry* Registry = GULMChannelRegistry.load(std::memory_order_acquire);
+	UULMSubsystem* Subsystem = GULMSubsystem.load(std::memory_order_acquire);
+	
+	if (!Registry || !Subsystem)
+	{
+		UE_LOG(ULM, Warning, TEXT("ULM not initialized, falling back: [%s] %s"), ULMChannelNameFromId(ChannelId), *Message);
+		return;
+	}
+
+	// One admission decision per call - the ticket is handed down so storage never re-checks or takes a second token
+	const FULMAdmissionTicket Ticket = Registry->Admit(ChannelId, Verbosity);
+	if (!Ticket)
+	{
+		return;
 	}
+	
+	// Output Log mirroring happens in batches on the processor thread - the producer only pays for the enqueue
+	Subsystem->StoreLogEntryInternal(Message, Ticket, CallsiteId);
 }
 
-void ULMLogMessage(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName, int32 LineNumber)
+void ULMLogMessageDeferred(EULMChannelId ChannelId, EULMVerbosity Verbosity, FULMDeferredMessage&& Message, uint32 CallsiteId)
 {
 	// Thread-safe access to global state
 	FULMChannelRegistry* Registry = GULMChannelRegistry.load(std::memory_order_acquire);
@@ -115,59 +131,218 @@ void ULMLogMessage(const FString& ChannelName, EULMVerbosity Verbosity, const FS
 	
 	if (!Registry || !Subsystem)
 	{
-		UE_LOG(ULM, Warning, TEXT("ULM not initialized, falling back: [%s] %s"), *ChannelName, *Message);
+		// No processor thread to hand the message to - format it here
+		UE_LOG(ULM, Warning, TEXT("ULM not initialized, falling back: [%s] %s"), ULMChannelNameFromId(ChannelId), *Message.Format());
 		return;
 	}
 
-	if (!Registry->CanChannelLog(ChannelName, Verbosity))
+	const FULMAdmissionTicket Ticket = Registry->Admit(ChannelId, Verbosity);
+	if (!Ticket)
 	{
 		return;
 	}
 	
-	if (ChannelName == TEXT("ULM") || ChannelName == TEXT("Default"))
+	// Formatting and Output Log forwarding both happen on the processor thread
+	Subsystem->StoreDeferredLogEntry(MoveTemp(Message), Ticket, CallsiteId);
+}
+
+FULMAdmissionTicket ULMAdmit(EULMChannelId ChannelId, EULMVerbosity Verbosity)
+{
+	FULMChannelRegistry* Registry = GULMChannelRegistry.load(std::memory_order_acquire);
+	UULMSubsystem* Subsystem = GULMSubsystem.load(std::memory_order_acquire);
+	
+	// Not initialized - let the call through so submission can fall back to the Output Log
+	if (!Registry || !Subsystem)
 	{
-		LogToUECategory(ChannelName, Verbosity, Message, FileName, LineNumber);
+		return FULMAdmissionTicket::Bypass(ChannelId, Verbosity);
 	}
-	else if (ChannelName == TEXT("Subsystem"))
+
+	return Registry->Admit(ChannelId, Verbosity);
+}
+
+void ULMLogAdmitted(const FULMAdmissionTicket& Ticket, const FString& Message, uint32 CallsiteId)
+{
+	UULMSubsystem* Subsystem = GULMSubsystem.load(std::memory_order_acquire);
+	if (!Subsystem)
 	{
-		// SUBSYSTEM channel is isolated - only logs to its own channel, NOT to ULM master
-		LogToUECategory(ChannelName, Verbosity, Message, FileName, LineNumber);
+		UE_LOG(ULM, Warning, TEXT("ULM not initialized, falling back: [%s] %s"), ULMChannelNameFromId(Ticket.ChannelId), *Message);
+		return;
 	}
-	else
+
+	Subsystem->StoreLogEntryInternal(Message, Ticket, CallsiteId);
+}
+
+void ULMLogAdmitted(const FULMAdmissionTicket& Ticket, FULMDeferredMessage&& Message, uint32 CallsiteId)
+{
+	UULMSubsystem* Subsystem = GULMSubsystem.load(std::memory_order_acquire);
+	if (!Subsystem)
+	{
+		UE_LOG(ULM, Warning, TEXT("ULM not initialized, falling back: [%s] %s"), ULMChannelNameFromId(Ticket.ChannelId), *Message.Format());
+		return;
+	}
+
+	Subsystem->StoreDeferredLogEntry(MoveTemp(Message), Ticket, CallsiteId);
+}
+
+void ULMLogMessageStructured(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Lead, FULMStructuredFields&& Fields, uint32 CallsiteId)
+{
+	FULMChannelRegistry* Registry = GULMChannelRegistry.load(std::memory_order_acquire);
+	UULMSubsystem* Subsystem = GULMSubsystem.load(std::memory_order_acquire);
+	
+	if (!Registry || !Subsystem)
+	{
+		FString FieldText;
+		Fields.AppendText(FieldText);
+		UE_LOG(ULM, Warning, TEXT("ULM not initialized, falling back: [%s] %s: %s"), ULMChannelNameFromId(ChannelId), *Lead, *FieldText);
+		return;
+	}
+
+	const FULMAdmissionTicket Ticket = Registry->Admit(ChannelId, Verbosity);
+	if (!Ticket)
+	{
+		return;
+	}
+	
+	// Field rendering and Output Log forwarding both happen on the processor thread
+	Subsystem->StoreStructuredLogEntry(Lead, MoveTemp(Fields), Ticket, CallsiteId);
+}
+
+void ULMForwardToOutputLogBatch(TArray<FULMOutputLogLine>& Lines)
+{
+#if UE_BUILD_SHIPPING
+	for (const FULMOutputLogLine& Line : Lines)
 	{
-		LogToUECategory(ChannelName, Verbosity, Message, FileName, LineNumber);
+		LogToUECategory(Line.ChannelId, Line.Verbosity, Line.Message);
+	}
+#else
+	// One buffer for the whole batch: "[Channel] CRITICAL: Message [File:Line]" - the channel category logs
+	// from just past the prefix, the ULM master category logs the whole line
+	FString Buffer;
+	Buffer.Reserve(512);
+	
+	for (const FULMOutputLogLine& Line : Lines)
+	{
+		const bool bMirrorToMaster = Line.ChannelId != EULMChannelId::ULM && Line.ChannelId != EULMChannelId::Subsystem;
+		const FULMCallsite* Callsite = FULMCallsiteRegistry::Find(Line.CallsiteId);
 		
-		const FString PrefixedMessage = FString::Printf(TEXT("[%s] %s"), *ChannelName, *Message);
-		LogToUECategory(TEXT("ULM"), Verbosity, PrefixedMessage, FileName, LineNumber);
+		Buffer.Reset();
+		int32 ChannelStart = 0;
+		if (bMirrorToMaster)
+		{
+			Buffer += TEXT("[");
+			Buffer += ULMChannelNameFromId(Line.ChannelId);
+			Buffer += TEXT("] ");
+			ChannelStart = Buffer.Len();
+		}
+		
+		if (Line.Verbosity == EULMVerbosity::Critical)
+		{
+			Buffer += TEXT("CRITICAL: ");
+		}
+		Buffer += Line.Message;
+		
+		if (Callsite && Callsite->Line > 0)
+		{
+			const int32 SlashIndex = Callsite->File.FindLastCharByPredicate([](TCHAR Char) { return Char == TEXT('/') || Char == TEXT('\\'); });
+			Buffer.Appendf(TEXT(" [%s:%d]"), *Callsite->File + SlashIndex + 1, Callsite->Line);
+		}
+		
+		const char* LogFileName = (Callsite && Callsite->SourceFile) ? Callsite->SourceFile : __FILE__;
+		const int32 LogLineNumber = (Callsite && Callsite->Line > 0) ? Callsite->Line : __LINE__;
+		const ELogVerbosity::Type UEVerbosity = GetUEVerbosity(Line.Verbosity);
+		
+		FMsg::Logf(LogFileName, LogLineNumber, GetChannelCategory(Line.ChannelId)->GetCategoryName(), UEVerbosity, TEXT("%s"), *Buffer + ChannelStart);
+		if (bMirrorToMaster)
+		{
+			FMsg::Logf(LogFileName, LogLineNumber, ULM.GetCategoryName(), UEVerbosity, TEXT("%s"), *Buffer);
+		}
 	}
+#endif
+	
+	Lines.Reset();
+}
 
-	Subsystem->StoreLogEntryInternal(Message, ChannelName, Verbosity);
+void ULMLogMessage(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName, int32 LineNumber, uint32 CallsiteId)
+{
+	const EULMChannelId ChannelId = ULMInternal::ResolveChannelId(ChannelName);
+	if (!ULMIsValidChannelId(ChannelId))
+	{
+		// Only master list channels can log
+		return;
+	}
+	
+	ULMLogMessage(ChannelId, Verbosity, Message, WorldContext, FileName, LineNumber, CallsiteId);
 }
 
-void ULMLogMessageServer(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName, int32 LineNumber)
+void ULMLogMessageServer(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName, int32 LineNumber, uint32 CallsiteId)
 {
 	// Only log if we have authority (server or standalone)
 	if (ULMInternal::HasNetworkAuthority(WorldContext))
 	{
-		ULMLogMessage(ChannelName, Verbosity, Message, WorldContext, FileName, LineNumber);
+		ULMLogMessage(ChannelId, Verbosity, Message, WorldContext, FileName, LineNumber, CallsiteId);
 	}
 }
 
-void ULMLogMessageClient(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName, int32 LineNumber)
+void ULMLogMessageServer(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName, int32 LineNumber, uint32 CallsiteId)
+{
+	ULMLogMessageServer(ULMInternal::ResolveChannelId(ChannelName), Verbosity, Message, WorldContext, FileName, LineNumber, CallsiteId);
+}
+
+void ULMLogMessageClient(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName, int32 LineNumber, uint32 CallsiteId)
 {
 	// Only log if we're a client
 	if (!ULMInternal::HasNetworkAuthority(WorldContext))
 	{
-		ULMLogMessage(ChannelName, Verbosity, Message, WorldContext, FileName, LineNumber);
+		ULMLogMessage(ChannelId, Verbosity, Message, WorldContext, FileName, LineNumber, CallsiteId);
+	}
+}
+
+void ULMLogMessageClient(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName, int32 LineNumber, uint32 CallsiteId)
+{
+	ULMLogMessageClient(ULMInternal::ResolveChannelId(ChannelName), Verbosity, Message, WorldContext, FileName, LineNumber, CallsiteId);
+}
+
+void ULMLogMessageSampled(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Message, const FULMSampleDecision& Decision, uint32 CallsiteId)
+{
+	if (!Decision)
+	{
+		return;
+	}
+
+	FULMChannelRegistry* Registry = GULMChannelRegistry.load(std::memory_order_acquire);
+	UULMSubsystem* Subsystem = GULMSubsystem.load(std::memory_order_acquire);
+	
+	if (!Registry || !Subsystem)
+	{
+		UE_LOG(ULM, Warning, TEXT("ULM not initialized, falling back: [%s] %s"), ULMChannelNameFromId(ChannelId), *Message);
+		return;
+	}
+
+	// Reservoir samples are admitted when their window closes, so the rate limit only sees what is emitted
+	if (Decision.IsReservoir())
+	{
+		ULMSampling::FillReservoir(ChannelId, Decision, FULMLogQueueEntry(Message, ChannelId, Verbosity, CallsiteId));
+		return;
 	}
+
+	const FULMAdmissionTicket Ticket = Registry->Admit(ChannelId, Verbosity);
+	if (!Ticket)
+	{
+		return;
+	}
+
+	FULMLogQueueEntry Entry(Message, Ticket.ChannelId, Ticket.Verbosity, CallsiteId);
+	Entry.SampleWeight = Decision.Weight;
+	Subsystem->StoreSampledLogEntry(MoveTemp(Entry), Ticket);
 }
 
-void ULMLogMessageSampled(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, uint32 SampleRate, const UObject* WorldContext, const char* FileName, int32 LineNumber)
+void ULMLogMessageSampled(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, uint32 SampleRate, const UObject* WorldContext, const char* FileName, int32 LineNumber, uint32 CallsiteId)
 {
-	// Apply sampling before channel checks for maximum performance
-	if (ULMInternal::ShouldSample(ChannelName, SampleRate))
+	// Gate first so closed channels never advance the sampler
+	const EULMChannelId ChannelId = ULMInternal::ResolveChannelId(ChannelName);
+	if (ULMInternal::IsChannelOpen(ChannelId, Verbosity))
 	{
-		ULMLogMessage(ChannelName, Verbosity, Message, WorldContext, FileName, LineNumber);
+		ULMLogMessageSampled(ChannelId, Verbosity, Message, ULMSampling::Sample(ChannelId, SampleRate), CallsiteId);
 	}
 }
 
@@ -222,14 +397,30 @@ void ULMLogDirectToFile(const FString& ChannelName, EULMVerbosity Verbosity, con
 }
 
 // Structured logging implementation
-FULMStructuredLog::FULMStructuredLog(const FString& InChannelName, EULMVerbosity InVerbosity, const FString& InFileName, int32 InLineNumber, const FString& InFunctionName)
-	: ChannelName(InChannelName)
+FULMStructuredLog::FULMStructuredLog(EULMChannelId InChannelId, EULMVerbosity InVerbosity, const FString& InFileName, int32 InLineNumber, const FString& InFunctionName)
+	: ChannelId(InChannelId)
 	, Verbosity(InVerbosity)
-	, FileName(InFileName)
-	, LineNumber(InLineNumber)
 	, FunctionName(InFunctionName)
+	, bEnabled(ULMInternal::IsChannelOpen(InChannelId, InVerbosity))
+{
+}
+
+FULMStructuredLog::FULMStructuredLog(const FString& InChannelName, EULMVerbosity InVerbosity, const FString& InFileName, int32 InLineNumber, const FString& InFunctionName)
+	: FULMStructuredLog(ULMInternal::ResolveChannelId(InChannelName), InVerbosity, InFileName, InLineNumber, InFunctionName)
+{
+}
+
+FULMStructuredLog::FULMStructuredLog(EULMChannelId InChannelId, EULMVerbosity InVerbosity, const FULMCallsite* InCallsite)
+	: ChannelId(InChannelId)
+	, Verbosity(InVerbosity)
+	, Callsite(InCallsite)
+	, bEnabled(ULMInternal::IsChannelOpen(InChannelId, InVerbosity))
+{
+}
+
+FULMStructuredLog::FULMStructuredLog(const FString& InChannelName, EULMVerbosity InVerbosity, const FULMCallsite* InCallsite)
+	: FULMStructuredLog(ULMInternal::ResolveChannelId(InChannelName), InVerbosity, InCallsite)
 {
-	Fields.Reserve(8); // Reserve space for common number of fields
 }
 
 FULMStructuredLog::~FULMStructuredLog()
@@ -240,39 +431,72 @@ FULMStructuredLog::~FULMStructuredLog()
 	}
 }
 
-FULMStructuredLog& FULMStructuredLog::Add(const FString& Key, const FString& Value)
+FULMStructuredLog& FULMStructuredLog::Add(FStringView Key, FStringView Value)
 {
-	Fields.Emplace(Key, Value);
+	if (bEnabled)
+	{
+		Fields.AddString(Key, Value);
+	}
 	return *this;
 }
 
-FULMStructuredLog& FULMStructuredLog::Add(const FString& Key, int32 Value)
+FULMStructuredLog& FULMStructuredLog::Add(FStringView Key, const TCHAR* Value)
 {
-	Fields.Emplace(Key, FString::FromInt(Value));
+	return Add(Key, FStringView(Value ? Value : TEXT("")));
+}
+
+FULMStructuredLog& FULMStructuredLog::Add(FStringView Key, int32 Value)
+{
+	return Add(Key, static_cast<int64>(Value));
+}
+
+FULMStructuredLog& FULMStructuredLog::Add(FStringView Key, int64 Value)
+{
+	if (bEnabled)
+	{
+		Fields.AddInt(Key, Value);
+	}
 	return *this;
 }
 
-FULMStructuredLog& FULMStructuredLog::Add(const FString& Key, float Value)
+FULMStructuredLog& FULMStructuredLog::Add(FStringView Key, float Value)
 {
-	Fields.Emplace(Key, FString::SanitizeFloat(Value));
+	return Add(Key, static_cast<double>(Value));
+}
+
+FULMStructuredLog& FULMStructuredLog::Add(FStringView Key, double Value)
+{
+	if (bEnabled)
+	{
+		Fields.AddFloat(Key, Value);
+	}
 	return *this;
 }
 
-FULMStructuredLog& FULMStructuredLog::Add(const FString& Key, bool Value)
+FULMStructuredLog& FULMStructuredLog::Add(FStringView Key, bool Value)
 {
-	Fields.Emplace(Key, Value ? TEXT("true") : TEXT("false"));
+	if (bEnabled)
+	{
+		Fields.AddBool(Key, Value);
+	}
 	return *this;
 }
 
-FULMStructuredLog& FULMStructuredLog::Add(const FString& Key, const FVector& Value)
+FULMStructuredLog& FULMStructuredLog::Add(FStringView Key, const FVector& Value)
 {
-	Fields.Emplace(Key, Value.ToString());
+	if (bEnabled)
+	{
+		Fields.AddVector(Key, Value);
+	}
 	return *this;
 }
 
-FULMStructuredLog& FULMStructuredLog::Add(const FString& Key, const FRotator& Value)
+FULMStructuredLog& FULMStructuredLog::Add(FStringView Key, const FRotator& Value)
 {
-	Fields.Emplace(Key, Value.ToString());
+	if (bEnabled)
+	{
+		Fields.AddRotator(Key, Value);
+	}
 	return *this;
 }
 
@@ -282,36 +506,14 @@ void FULMStructuredLog::Commit()
 	{
 		return;
 	}
+	bCommitted = true;
 
-	// Build structured message
-	FString StructuredMessage;
-	StructuredMessage.Reserve(256); // Reserve reasonable space
-
-	for (const auto& Field : Fields)
+	if (!bEnabled)
 	{
-		if (!StructuredMessage.IsEmpty())
-		{
-			StructuredMessage += TEXT(", ");
-		}
-		StructuredMessage += FString::Printf(TEXT("%s=%s"), *Field.Key, *Field.Value);
+		return;
 	}
 
-	// Add function information to structured message (file/line will be passed to FMsg::Logf for Rider clickability)
-	FString FinalMessage;
-	if (!FunctionName.IsEmpty())
-	{
-		FinalMessage = FString::Printf(TEXT("%s: %s"), *FunctionName, *StructuredMessage);
-	}
-	else
-	{
-		FinalMessage = StructuredMessage;
-	}
-	
-	// Log the structured message
-	// Convert FString file path to char* for the API
-	const char* FileNameCStr = FileName.IsEmpty() ? __FILE__ : TCHAR_TO_ANSI(*FileName);
-	int32 LogLineNumber = LineNumber > 0 ? LineNumber : __LINE__;
-	ULMLogMessage(ChannelName, Verbosity, FinalMessage, nullptr, FileNameCStr, LogLineNumber);
-	
-	bCommitted = true;
+	// The fields go through the queue as they are - rendering happens on the processor thread
+	const FString& Lead = Callsite ? Callsite->Function : FunctionName;
+	ULMLogMessageStructured(ChannelId, Verbosity, Lead, MoveTemp(Fields), Callsite ? Callsite->Id : 0);
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "Logging/ULMMessageBuffer.h"
+#include "Containers/LockFreeList.h"
+#include "Hash/CityHash.h"
+#include <atomic>
+
+// Recycled blocks keep up to this much capacity; anything larger is released so one huge message can't pin memory
+static constexpr int32 MaxRetainedOverflowBytes = 64 * 1024;
+static constexpr int32 MaxPooledOverflowBlocks = 256;
+
+struct FULMMessageOverflowBlock
+{
+	TArray<UTF8CHAR> Text;
+};
+
+struct FULMMessageOverflowPool
+{
+	TLockFreePointerListUnordered<FULMMessageOverflowBlock, PLATFORM_CACHE_LINE_SIZE> FreeBlocks;
+	std::atomic<int32> NumPooled{0};
+
+	std::atomic<int64> OverflowMessages{0};
+	std::atomic<int64> BlockAllocations{0};
+};
+
+static FULMMessageOverflowPool& GetOverflowPool()
+{
+	// Intentionally leaked - queue entries can be destroyed during static shutdown
+	static FULMMessageOverflowPool* Pool = new FULMMessageOverflowPool();
+	return *Pool;
+}
+
+static FULMMessageOverflowBlock* AcquireOverflowBlock()
+{
+	FULMMessageOverflowPool& Pool = GetOverflowPool();
+	if (FULMMessageOverflowBlock* Block = Pool.FreeBlocks.Pop())
+	{
+		Pool.NumPooled.fetch_sub(1, std::memory_order_relaxed);
+		return Block;
+	}
+
+	Pool.BlockAllocations.fetch_add(1, std::memory_order_relaxed);
+	return new FULMMessageOverflowBlock();
+}
+
+static void ReleaseOverflowBlock(FULMMessageOverflowBlock* Block)
+{
+	FULMMessageOverflowPool& Pool = GetOverflowPool();
+	if (Pool.NumPooled.load(std::memory_order_relaxed) >= MaxPooledOverflowBlocks)
+	{
+		delete Block;
+		return;
+	}
+
+	if (Block->Text.Max() > MaxRetainedOverflowBytes)
+	{
+		Block->Text.Empty();
+	}
+	else
+	{
+		Block->Text.Reset();
+	}
+
+	Pool.NumPooled.fetch_add(1, std::memory_order_relaxed);
+	Pool.FreeBlocks.Push(Block);
+}
+
+FULMMessageBuffer::~FULMMessageBuffer()
+{
+	Reset();
+}
+
+FULMMessageBuffer::FULMMessageBuffer(FULMMessageBuffer&& Other)
+{
+	MoveFrom(Other);
+}
+
+FULMMessageBuffer& FULMMessageBuffer::operator=(FULMMessageBuffer&& Other)
+{
+	if (this != &Other)
+	{
+		Reset();
+		MoveFrom(Other);
+	}
+	return *this;
+}
+
+void FULMMessageBuffer::MoveFrom(FULMMessageBuffer& Other)
+{
+	Overflow = Other.Overflow;
+	Length = Other.Length;
+	if (!Overflow && Length > 0)
+	{
+		FMemory::Memcpy(InlineData, Other.InlineData, Length);
+	}
+
+	Other.Overflow = nullptr;
+	Other.Length = 0;
+}
+
+void FULMMessageBuffer::Assign(const TCHAR* Text, int32 TextLen)
+{
+	const int32 EncodedLen = (Text && TextLen > 0) ? FPlatformString::ConvertedLength<UTF8CHAR>(Text, TextLen) : 0;
+	UTF8CHAR* Dest = InlineData;
+	if (EncodedLen <= INLINE_CAPACITY)
+	{
+		if (Overflow)
+		{
+			ReleaseOverflowBlock(Overflow);
+			Overflow = nullptr;
+		}
+	}
+	else
+	{
+		if (!Overflow)
+		{
+			Overflow = AcquireOverflowBlock();
+		}
+		Overflow->Text.SetNumUninitialized(EncodedLen, EAllowShrinking::No);
+		Dest = Overflow->Text.GetData();
+		GetOverflowPool().OverflowMessages.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if (EncodedLen > 0)
+	{
+		FPlatformString::Convert(Dest, EncodedLen, Text, TextLen);
+	}
+	Length = EncodedLen;
+}
+
+void FULMMessageBuffer::Reset()
+{
+	if (Overflow)
+	{
+		ReleaseOverflowBlock(Overflow);
+		Overflow = nullptr;
+	}
+	Length = 0;
+}
+
+const UTF8CHAR* FULMMessageBuffer::GetData() const
+{
+	return Overflow ? Overflow->Text.GetData() : InlineData;
+}
+
+uint64 FULMMessageBuffer::GetHash() const
+{
+	return CityHash64(reinterpret_cast<const char*>(GetData()), static_cast<uint32>(Length));
+}
+
+FString FULMMessageBuffer::ToString() const
+{
+	FString Result;
+	if (Length == 0)
+	{
+		return Result;
+	}
+
+	const UTF8CHAR* Data = GetData();
+	const int32 DecodedLen = FPlatformString::ConvertedLength<TCHAR>(Data, Length);
+
+	// Decode straight into the string's buffer - one allocation, no intermediate conversion buffer
+	TArray<TCHAR>& Chars = Result.GetCharArray();
+	Chars.SetNumUninitialized(DecodedLen + 1);
+	FPlatformString::Convert(Chars.GetData(), DecodedLen, Data, Length);
+	Chars[DecodedLen] = TEXT('\0');
+	return Result;
+}
+
+FULMMessageBufferStats FULMMessageBuffer::GetStats()
+{
+	const FULMMessageOverflowPool& Pool = GetOverflowPool();
+
+	FULMMessageBufferStats Stats;
+	Stats.OverflowMessages = Pool.OverflowMessages.load(std::memory_order_relaxed);
+	Stats.OverflowBlockAllocations = Pool.BlockAllocations.load(std::memory_order_relaxed);
+	Stats.PooledOverflowBlocks = Pool.NumPooled.load(std::memory_order_relaxed);
+	return Stats;
+}
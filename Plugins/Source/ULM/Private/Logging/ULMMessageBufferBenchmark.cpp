@@ -0,0 +1,65 @@
+#include "Logging/ULMMessageBuffer.h"
+#include "Logging/ULMLogQueue.h"
+#include "Core/ULMSubsystem.h"
+#include "Core/ULMAllocationCounter.h"
+#include "Channels/ULMLogCategories.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Heap allocation sample for queued message text
+ * Pushes a burst of pre-formatted messages through queue entry construction, a private ring and the consumer's
+ * dequeue, counting every heap allocation the calling thread makes. Short messages must stay inline and allocate
+ * nothing; long ones may only allocate while the overflow pool warms up, which the untracked first pass covers.
+ */
+
+static void RunMessageBurst(TULMMpscQueue<FULMLogQueueEntry>& Queue, const FString& Message, int32 NumMessages)
+{
+	FULMLogQueueEntry Dequeued;
+	for (int32 Index = 0; Index < NumMessages; ++Index)
+	{
+		FULMLogQueueEntry Entry(Message, EULMChannelId::Performance, EULMVerbosity::Message);
+		Queue.Enqueue(MoveTemp(Entry));
+		Queue.Dequeue(Dequeued);
+	}
+}
+
+static void RunMessageAllocationSample(const TArray<FString>& Args)
+{
+	const int32 NumMessages = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 10000000) : 100000;
+
+	TULMMpscQueue<FULMLogQueueEntry> Queue;
+	Queue.Initialize(1024);
+
+	const FString ShortMessage(TEXT("Player 7 picked up item 1234 at (100.0, 200.0, 50.0)"));
+	const FString LongMessage = FString::ChrN(FULMMessageBuffer::INLINE_CAPACITY * 4, TEXT('x'));
+
+	for (const FString* Message : { &ShortMessage, &LongMessage })
+	{
+		RunMessageBurst(Queue, *Message, Queue.GetCapacity());
+		const int64 BlocksBefore = FULMMessageBuffer::GetStats().OverflowBlockAllocations;
+
+		int64 Allocations = 0;
+		{
+			FULMAllocationCounter AllocationCounter;
+			FULMAllocationCounter::TrackCurrentThread(true);
+			RunMessageBurst(Queue, *Message, NumMessages);
+			FULMAllocationCounter::TrackCurrentThread(false);
+			Allocations = AllocationCounter.GetAllocations();
+		}
+
+		const bool bShort = Message == &ShortMessage;
+		UE_LOG(ULM, Display, TEXT("ULM message allocations (%s, %d chars): %lld heap allocations over %d messages (%.4f per message), %lld new overflow blocks%s"),
+			bShort ? TEXT("short") : TEXT("long"), Message->Len(), Allocations, NumMessages, static_cast<double>(Allocations) / NumMessages,
+			FULMMessageBuffer::GetStats().OverflowBlockAllocations - BlocksBefore,
+			bShort ? (Allocations == 0 ? TEXT(" - PASS") : TEXT(" - FAIL")) : TEXT(""));
+	}
+}
+
+static FAutoConsoleCommand GULMMessageAllocationsCommand(
+	TEXT("ULM.MessageAllocations"),
+	TEXT("Count heap allocations while a burst of short and then long messages goes through the queue entry path. Usage: ULM.MessageAllocations [Messages=100000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunMessageAllocationSample));
+
+#endif
@@ -0,0 +1,283 @@
+#include "Logging/ULMProducerRegistry.h"
+#include "Misc/ScopeLock.h"
+
+// Process-wide so a registry recreated at the same address still invalidates old caches
+static std::atomic<uint32> GProducerRegistryGeneration{0};
+
+// Registries still alive - an exiting thread only touches its registry if it is still listed here
+static FCriticalSection& GetLiveRegistriesLock()
+{
+	static FCriticalSection Lock;
+	return Lock;
+}
+
+static TArray<FULMProducerRegistry*>& GetLiveRegistries()
+{
+	static TArray<FULMProducerRegistry*> Registries;
+	return Registries;
+}
+
+struct FULMProducerSlotCache
+{
+	FULMProducerRegistry* Owner = nullptr;
+	uint32 Generation = 0;
+	int32 Slot = FULMProducerRegistry::SHARED_SLOT;
+
+	// Runs on thread exit
+	~FULMProducerSlotCache()
+	{
+		Release();
+	}
+
+	// Hand the slot back, unless its registry has been destroyed or reset since the slot was claimed
+	void Release()
+	{
+		if (Owner && Slot != FULMProducerRegistry::SHARED_SLOT)
+		{
+			FScopeLock Lock(&GetLiveRegistriesLock());
+			if (GetLiveRegistries().Contains(Owner) && Owner->Generation.load(std::memory_order_acquire) == Generation)
+			{
+				Owner->ReleaseSlot(Slot);
+			}
+		}
+		Owner = nullptr;
+		Slot = FULMProducerRegistry::SHARED_SLOT;
+	}
+};
+
+// Defined here rather than in the header so every translation unit sees the same cache
+static thread_local FULMProducerSlotCache GProducerSlotCache;
+
+FULMProducerRegistry::FULMProducerRegistry()
+{
+	Reset();
+
+	FScopeLock Lock(&GetLiveRegistriesLock());
+	GetLiveRegistries().Add(this);
+}
+
+FULMProducerRegistry::~FULMProducerRegistry()
+{
+	FScopeLock Lock(&GetLiveRegistriesLock());
+	GetLiveRegistries().RemoveSingleSwap(this);
+}
+
+void FULMProducerRegistry::Reset()
+{
+	// Held so a thread exiting right now can't release a slot into the new session
+	FScopeLock LiveLock(&GetLiveRegistriesLock());
+
+	for (FSlot& Slot : Slots)
+	{
+		Slot.ThreadId.store(0, std::memory_order_relaxed);
+		Slot.WeightFixed.store(WEIGHT_ONE, std::memory_order_relaxed);
+		Slot.BurstEntries.store(DEFAULT_BURST_ENTRIES, std::memory_order_relaxed);
+		Slot.Queued.store(0, std::memory_order_relaxed);
+		Slot.Enqueued.store(0, std::memory_order_relaxed);
+		Slot.Dropped.store(0, std::memory_order_relaxed);
+		Slot.bReleased.store(false, std::memory_order_relaxed);
+	}
+
+	{
+		FScopeLock Lock(&NamesLock);
+		for (FString& Name : Names)
+		{
+			Name.Reset();
+		}
+		Names[SHARED_SLOT] = TEXT("Other");
+	}
+
+	NumSlots.store(1, std::memory_order_relaxed);
+	NumReleased.store(0, std::memory_order_relaxed);
+	SharedClaims.store(0, std::memory_order_relaxed);
+	Generation.store(GProducerRegistryGeneration.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+int32 FULMProducerRegistry::GetCurrentSlot()
+{
+	FULMProducerSlotCache& Cache = GProducerSlotCache;
+	const uint32 CurrentGeneration = Generation.load(std::memory_order_acquire);
+	const bool bCached = Cache.Owner == this && Cache.Generation == CurrentGeneration;
+	if (bCached && (Cache.Slot != SHARED_SLOT || NumReleased.load(std::memory_order_relaxed) == 0))
+	{
+		return Cache.Slot;
+	}
+
+	const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
+	int32 Slot = SHARED_SLOT;
+	if (bCached)
+	{
+		// A shared-slot thread retries while a released slot drains, and stays shared until one is free
+		Slot = ClaimSlot(ThreadId);
+		if (Slot == SHARED_SLOT)
+		{
+			return SHARED_SLOT;
+		}
+	}
+	else
+	{
+		// First call on this thread, or a cache from another registry or session - give that slot back first
+		Cache.Release();
+		Slot = ClaimSlot(ThreadId);
+		if (Slot == SHARED_SLOT)
+		{
+			SharedClaims.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	if (Slot != SHARED_SLOT)
+	{
+		FScopeLock Lock(&NamesLock);
+		Names[Slot] = FString::Printf(TEXT("Thread %u"), ThreadId);
+	}
+
+	Cache.Owner = this;
+	Cache.Generation = CurrentGeneration;
+	Cache.Slot = Slot;
+	return Slot;
+}
+
+int32 FULMProducerRegistry::RegisterCurrentThread(const FString& Name, float Weight, int32 BurstEntries)
+{
+	// Reuse the slot the thread may already have claimed by logging before it registered
+	const int32 Slot = GetCurrentSlot();
+	if (Slot != SHARED_SLOT)
+	{
+		ConfigureSlot(Slot, Name, Weight, BurstEntries);
+	}
+	return Slot;
+}
+
+int32 FULMProducerRegistry::ClaimSlot(uint32 ThreadId)
+{
+	int32 Slot = ClaimReleasedSlot();
+	if (Slot == INDEX_NONE)
+	{
+		Slot = NumSlots.fetch_add(1, std::memory_order_relaxed);
+		if (Slot >= MAX_PRODUCERS)
+		{
+			NumSlots.store(MAX_PRODUCERS, std::memory_order_relaxed);
+			return SHARED_SLOT;
+		}
+	}
+
+	// A reused slot starts over with default weight and fresh counters for its new owner
+	FSlot& Claimed = Slots[Slot];
+	Claimed.WeightFixed.store(WEIGHT_ONE, std::memory_order_relaxed);
+	Claimed.BurstEntries.store(DEFAULT_BURST_ENTRIES, std::memory_order_relaxed);
+	Claimed.Enqueued.store(0, std::memory_order_relaxed);
+	Claimed.Dropped.store(0, std::memory_order_relaxed);
+	Claimed.ThreadId.store(ThreadId, std::memory_order_relaxed);
+	return Slot;
+}
+
+int32 FULMProducerRegistry::ClaimReleasedSlot()
+{
+	if (NumReleased.load(std::memory_order_relaxed) == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// Nothing enqueues on a released slot, so once its queued count reaches zero it stays there
+	const int32 ClaimedSlots = FMath::Min(NumSlots.load(std::memory_order_relaxed), MAX_PRODUCERS);
+	for (int32 Index = SHARED_SLOT + 1; Index < ClaimedSlots; ++Index)
+	{
+		FSlot& Slot = Slots[Index];
+		bool bExpected = true;
+		if (Slot.bReleased.load(std::memory_order_relaxed) && Slot.Queued.load(std::memory_order_relaxed) == 0
+			&& Slot.bReleased.compare_exchange_strong(bExpected, false, std::memory_order_acq_rel))
+		{
+			NumReleased.fetch_sub(1, std::memory_order_relaxed);
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void FULMProducerRegistry::ReleaseSlot(int32 Slot)
+{
+	bool bExpected = false;
+	if (Slots[Slot].bReleased.compare_exchange_strong(bExpected, true, std::memory_order_acq_rel))
+	{
+		NumReleased.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void FULMProducerRegistry::ConfigureSlot(int32 Slot, const FString& Name, float Weight, int32 BurstEntries)
+{
+	Slots[Slot].WeightFixed.store(FMath::Max(1, FMath::RoundToInt(Weight * WEIGHT_ONE)), std::memory_order_relaxed);
+	Slots[Slot].BurstEntries.store(FMath::Max(0, BurstEntries), std::memory_order_relaxed);
+
+	FScopeLock Lock(&NamesLock);
+	Names[Slot] = Name;
+}
+
+bool FULMProducerRegistry::IsWithinQuota(int32 Slot, int32 EntryLimit) const
+{
+	const FSlot& Self = Slots[Slot];
+	const int32 Queued = Self.Queued.load(std::memory_order_relaxed);
+	const int32 SelfWeight = Self.WeightFixed.load(std::memory_order_relaxed);
+
+	// Share the limit among producers that currently have entries in flight - idle threads don't dilute it
+	int64 TotalWeight = SelfWeight;
+	const int32 ClaimedSlots = FMath::Min(NumSlots.load(std::memory_order_relaxed), MAX_PRODUCERS);
+	for (int32 Index = 0; Index < ClaimedSlots; ++Index)
+	{
+		if (Index != Slot && Slots[Index].Queued.load(std::memory_order_relaxed) > 0)
+		{
+			TotalWeight += Slots[Index].WeightFixed.load(std::memory_order_relaxed);
+		}
+	}
+
+	const int64 Share = static_cast<int64>(EntryLimit) * SelfWeight / TotalWeight;
+	return Queued < Share + Self.BurstEntries.load(std::memory_order_relaxed);
+}
+
+void FULMProducerRegistry::OnEnqueued(int32 Slot)
+{
+	Slots[Slot].Queued.fetch_add(1, std::memory_order_relaxed);
+	Slots[Slot].Enqueued.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FULMProducerRegistry::OnDequeued(int32 Slot)
+{
+	Slots[Slot].Queued.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void FULMProducerRegistry::OnDropped(int32 Slot)
+{
+	Slots[Slot].Dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FULMProducerRegistry::ResetCounters()
+{
+	for (FSlot& Slot : Slots)
+	{
+		Slot.Enqueued.store(0, std::memory_order_relaxed);
+		Slot.Dropped.store(0, std::memory_order_relaxed);
+	}
+	SharedClaims.store(0, std::memory_order_relaxed);
+}
+
+TArray<FULMProducerStats> FULMProducerRegistry::GetStats() const
+{
+	TArray<FULMProducerStats> Result;
+	const int32 ClaimedSlots = FMath::Min(NumSlots.load(std::memory_order_relaxed), MAX_PRODUCERS);
+	Result.Reserve(ClaimedSlots);
+
+	FScopeLock Lock(&NamesLock);
+	for (int32 Index = 0; Index < ClaimedSlots; ++Index)
+	{
+		const FSlot& Slot = Slots[Index];
+
+		FULMProducerStats& Stats = Result.AddDefaulted_GetRef();
+		Stats.Name = Names[Index];
+		Stats.ThreadId = Slot.ThreadId.load(std::memory_order_relaxed);
+		Stats.Weight = static_cast<float>(Slot.WeightFixed.load(std::memory_order_relaxed)) / WEIGHT_ONE;
+		Stats.Queued = Slot.Queued.load(std::memory_order_relaxed);
+		Stats.Enqueued = Slot.Enqueued.load(std::memory_order_relaxed);
+		Stats.Dropped = Slot.Dropped.load(std::memory_order_relaxed);
+		Stats.SharedClaims = Index == SHARED_SLOT ? SharedClaims.load(std::memory_order_relaxed) : 0;
+	}
+	return Result;
+}
@@ -0,0 +1,144 @@
+#include "Logging/ULMLogQueue.h"
+#include "Core/ULMSubsystem.h"
+#include "Core/ULMAllocationCounter.h"
+#include "Channels/ULMLogCategories.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Thread.h"
+#include <atomic>
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Multi-producer throughput benchmark for TULMMpscQueue
+ * N producer threads enqueue short log entries into a private ring while one consumer drains it, as the game,
+ * render and worker threads feed the log processor. Producers retry on a full ring instead of dropping, so the
+ * result measures the queue rather than a backpressure policy. After a warm-up every thread counts its heap
+ * allocations, which must stay at zero, and the consumer checks each producer's entries arrive once and in order.
+ */
+
+static constexpr int32 QueueBenchmarkCapacity = 8192;
+static constexpr double QueueBenchmarkWarmupSeconds = 0.25;
+
+static void RunQueueThroughputBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumProducers = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 64) : 4;
+	const double Seconds = Args.Num() > 1 ? FMath::Clamp(FCString::Atod(*Args[1]), 0.1, 60.0) : 2.0;
+
+	TULMMpscQueue<FULMLogQueueEntry> Queue;
+	Queue.Initialize(QueueBenchmarkCapacity);
+
+	FULMAllocationCounter AllocationCounter;
+	std::atomic<bool> bMeasuring{false};
+	std::atomic<bool> bStop{false};
+	std::atomic<int64> Dequeued{0};
+	std::atomic<int64> FullRetries{0};
+	std::atomic<int64> OrderErrors{0};
+
+	TArray<TUniquePtr<FThread>> Producers;
+	for (int32 ProducerIndex = 0; ProducerIndex < NumProducers; ++ProducerIndex)
+	{
+		Producers.Add(MakeUnique<FThread>(TEXT("ULMQueueBenchmarkProducer"), [&, ProducerIndex]()
+		{
+			const FString Message = FString::Printf(TEXT("Queue benchmark entry from producer %d"), ProducerIndex);
+			bool bTracking = false;
+			uint32 Sequence = 0;
+			int64 Retries = 0;
+
+			while (!bStop.load(std::memory_order_relaxed))
+			{
+				if (!bTracking && bMeasuring.load(std::memory_order_relaxed))
+				{
+					FULMAllocationCounter::TrackCurrentThread(true);
+					bTracking = true;
+				}
+
+				// The sequence rides in CallsiteId so the consumer can check per-producer FIFO order
+				FULMLogQueueEntry Entry(Message, EULMChannelId::Performance, EULMVerbosity::Message, Sequence + 1);
+				Entry.ProducerSlot = static_cast<uint8>(ProducerIndex);
+				while (!Queue.Enqueue(MoveTemp(Entry)))
+				{
+					++Retries;
+					if (bStop.load(std::memory_order_relaxed))
+					{
+						break;
+					}
+					FPlatformProcess::YieldThread();
+				}
+				++Sequence;
+			}
+
+			FULMAllocationCounter::TrackCurrentThread(false);
+			FullRetries.fetch_add(Retries, std::memory_order_relaxed);
+		}));
+	}
+
+	FThread Consumer(TEXT("ULMQueueBenchmarkConsumer"), [&]()
+	{
+		TArray<uint32> LastSequence;
+		LastSequence.SetNumZeroed(NumProducers);
+		FULMLogQueueEntry Entry;
+		bool bTracking = false;
+		int64 Count = 0;
+
+		for (;;)
+		{
+			if (!bTracking && bMeasuring.load(std::memory_order_relaxed))
+			{
+				FULMAllocationCounter::TrackCurrentThread(true);
+				bTracking = true;
+			}
+
+			if (!Queue.Dequeue(Entry))
+			{
+				if (bStop.load(std::memory_order_acquire) && Queue.IsEmpty())
+				{
+					break;
+				}
+				continue;
+			}
+
+			uint32& Last = LastSequence[Entry.ProducerSlot];
+			if (Entry.CallsiteId != Last + 1)
+			{
+				OrderErrors.fetch_add(1, std::memory_order_relaxed);
+			}
+			Last = Entry.CallsiteId;
+			Dequeued.store(++Count, std::memory_order_relaxed);
+		}
+
+		FULMAllocationCounter::TrackCurrentThread(false);
+	});
+
+	FPlatformProcess::Sleep(static_cast<float>(QueueBenchmarkWarmupSeconds));
+	AllocationCounter.Reset();
+	bMeasuring.store(true, std::memory_order_relaxed);
+
+	const int64 StartCount = Dequeued.load(std::memory_order_relaxed);
+	const double StartTime = FPlatformTime::Seconds();
+	FPlatformProcess::Sleep(static_cast<float>(Seconds));
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+	const int64 MeasuredCount = Dequeued.load(std::memory_order_relaxed) - StartCount;
+
+	bStop.store(true, std::memory_order_release);
+	for (TUniquePtr<FThread>& Producer : Producers)
+	{
+		Producer->Join();
+	}
+	Consumer.Join();
+
+	const int64 Allocations = AllocationCounter.GetAllocations();
+	UE_LOG(ULM, Display, TEXT("ULM queue throughput (%d producers, capacity %d): %.0f entries/s, %.1f ns/entry, %lld full-ring retries, %lld order errors"),
+		NumProducers, Queue.GetCapacity(), MeasuredCount / Elapsed, MeasuredCount > 0 ? Elapsed * 1.0e9 / MeasuredCount : 0.0,
+		FullRetries.load(), OrderErrors.load());
+	UE_LOG(ULM, Display, TEXT("ULM queue steady-state allocations: %lld (%s)"),
+		Allocations, Allocations == 0 ? TEXT("PASS") : TEXT("FAIL"));
+}
+
+static FAutoConsoleCommand GULMQueueThroughputCommand(
+	TEXT("ULM.QueueThroughput"),
+	TEXT("Benchmark the MPSC log queue with N producers and check steady state allocates nothing. Usage: ULM.QueueThroughput [Producers=4] [Seconds=2]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunQueueThroughputBenchmark));
+
+#endif
@@ -0,0 +1,135 @@
+#include "Core/ULMSubsystem.h"
+#include "Configuration/ULMSettings.h"
+#include "Logging/ULMLogging.h"
+#include "FileIO/ULMJSONFormat.h"
+#include "Channels/ULMLogCategories.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Repeat collapse check against the live subsystem
+ * Logs one line Repeats times in a row from a single callsite on the Debug channel, then a different line to close
+ * the run. Storage must hold the first copy and one "Previous message repeated" summary on the same callsite,
+ * counting the other Repeats - 1 copies, with first/last matching the first and last capture. Other Debug traffic
+ * during the run splits it, so run this on a quiet channel.
+ */
+
+static constexpr float RepeatCheckWindowSeconds = 5.0f;
+static constexpr double RepeatCheckDrainTimeoutSeconds = 5.0;
+static constexpr int32 RepeatCheckStoredEntries = 1000;
+
+static void RunRepeatCollapseCheck(const TArray<FString>& Args)
+{
+	UULMSubsystem* Subsystem = GULMSubsystem.load(std::memory_order_acquire);
+	if (!Subsystem)
+	{
+		UE_LOG(ULM, Warning, TEXT("ULM repeat collapse check: subsystem not running"));
+		return;
+	}
+
+	const int32 NumRepeats = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 2, 20000) : 1000;
+
+	// Lift the rate limit so every copy reaches the processor, and hold the run open for the whole burst
+	const FULMChannelConfig SavedConfig = Subsystem->GetChannelConfig(TEXT("Debug"));
+	FULMChannelConfig Config = SavedConfig;
+	Config.bEnabled = true;
+	Config.MinVerbosity = EULMVerbosity::Message;
+	Config.RateLimit = FULMRateLimit(200000.0f, 30000);
+	Config.MaxLogEntries = FMath::Max(Config.MaxLogEntries, RepeatCheckStoredEntries);
+	Subsystem->UpdateChannelConfig(TEXT("Debug"), Config);
+	Subsystem->SetRepeatCollapseWindow(RepeatCheckWindowSeconds);
+
+	const FULMQueueDiagnostics QueueBefore = Subsystem->GetQueueDiagnostics();
+	const FString RunTag = FGuid::NewGuid().ToString(EGuidFormats::Short);
+	const FString RepeatedText = FString::Printf(TEXT("Repeat collapse check [%s]"), *RunTag);
+	const FString EndText = FString::Printf(TEXT("Repeat collapse check end [%s]"), *RunTag);
+
+	uint64 FirstBefore = 0;
+	uint64 FirstAfter = 0;
+	uint64 LastBefore = 0;
+	uint64 LastAfter = 0;
+	for (int32 Index = 0; Index < NumRepeats; ++Index)
+	{
+		const uint64 Before = FULMClock::Capture();
+		ULM_LOG(CHANNEL_DEBUG, EULMVerbosity::Message, TEXT("Repeat collapse check [%s]"), *RunTag);
+		const uint64 After = FULMClock::Capture();
+
+		if (Index == 0)
+		{
+			FirstBefore = Before;
+			FirstAfter = After;
+		}
+		LastBefore = Before;
+		LastAfter = After;
+	}
+	ULM_LOG(CHANNEL_DEBUG, EULMVerbosity::Message, TEXT("Repeat collapse check end [%s]"), *RunTag);
+
+	// The run's summary is stored just ahead of the line that ended it
+	TArray<FULMLogEntry> Entries;
+	const double Deadline = FPlatformTime::Seconds() + RepeatCheckDrainTimeoutSeconds;
+	bool bEnded = false;
+	while (!bEnded && FPlatformTime::Seconds() < Deadline)
+	{
+		FPlatformProcess::Sleep(0.01f);
+		Entries = Subsystem->GetLogEntries(TEXT("Debug"), Config.MaxLogEntries);
+		bEnded = Entries.ContainsByPredicate([&EndText](const FULMLogEntry& Entry) { return Entry.Message == EndText; });
+	}
+
+	const FULMQueueDiagnostics QueueAfter = Subsystem->GetQueueDiagnostics();
+	Subsystem->SetRepeatCollapseWindow(UULMSettings::Get()->RepeatCollapseWindowSeconds);
+	Subsystem->UpdateChannelConfig(TEXT("Debug"), SavedConfig);
+
+	const FULMLogEntry* First = nullptr;
+	int32 Copies = 0;
+	for (const FULMLogEntry& Entry : Entries)
+	{
+		if (Entry.Message == RepeatedText)
+		{
+			First = First ? First : &Entry;
+			++Copies;
+		}
+	}
+
+	TArray<const FULMLogEntry*> Summaries;
+	if (First)
+	{
+		for (const FULMLogEntry& Entry : Entries)
+		{
+			if (Entry.CallsiteId == First->CallsiteId && Entry.Message.StartsWith(TEXT("Previous message repeated")))
+			{
+				Summaries.Add(&Entry);
+			}
+		}
+	}
+
+	// Summary text is rendered from its fields; last is stamped with the summary's own capture time
+	bool bSummaryMatches = false;
+	if (First && Summaries.Num() == 1)
+	{
+		const FULMLogEntry& Summary = *Summaries[0];
+		const FString Expected = FString::Printf(TEXT("Previous message repeated: repeats=%d, first=%s, last=%s"), NumRepeats - 1,
+			*FULMJSONFormatter::GetLocalTimestamp(First->Timestamp), *FULMJSONFormatter::GetLocalTimestamp(Summary.Timestamp));
+		bSummaryMatches = Summary.Message == Expected
+			&& First->CaptureCycles >= FirstBefore && First->CaptureCycles <= FirstAfter
+			&& Summary.CaptureCycles >= LastBefore && Summary.CaptureCycles <= LastAfter;
+
+		UE_LOG(ULM, Display, TEXT("ULM repeat collapse check: summary \"%s\""), *Summary.Message);
+	}
+
+	const int32 Dropped = QueueAfter.DroppedCount.GetValue() - QueueBefore.DroppedCount.GetValue();
+	const int32 Collapsed = QueueAfter.CollapsedCount.GetValue() - QueueBefore.CollapsedCount.GetValue();
+	const bool bPassed = bEnded && Dropped == 0 && Copies == 1 && bSummaryMatches;
+
+	UE_LOG(ULM, Display, TEXT("ULM repeat collapse check (%d repeats): %d stored copies, %d summaries, %d collapsed, %d dropped%s - %s"),
+		NumRepeats, Copies, Summaries.Num(), Collapsed, Dropped,
+		bEnded ? TEXT("") : TEXT(", run never closed"), bPassed ? TEXT("PASS") : TEXT("FAIL"));
+}
+
+static FAutoConsoleCommand GULMRepeatCollapseCheckCommand(
+	TEXT("ULM.RepeatCollapseCheck"),
+	TEXT("Log one line repeatedly and check storage holds one copy plus a summary with the right count and first/last times. Usage: ULM.RepeatCollapseCheck [Repeats=1000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunRepeatCollapseCheck));
+
+#endif
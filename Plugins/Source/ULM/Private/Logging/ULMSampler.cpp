@@ -0,0 +1,376 @@
+#include "Logging/ULMSampler.h"
+#include "Logging/ULMLogging.h"
+#include "Core/ULMSubsystem.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+// Largest keep-one-in-N a Budget window can retune to, and most entries one reservoir window may hold
+static constexpr uint32 MaxSampleRate = 1u << 20;
+static constexpr int32 MaxReservoirSize = 4096;
+
+// A Budget window closes early once it has seen this many times its expected calls, so a burst is caught mid-window
+static constexpr uint32 BurstRetuneFactor = 4;
+
+// A closed reservoir window waiting for the log processor to weight and queue it
+struct FULMClosedReservoir
+{
+	TArray<FULMLogQueueEntry> Entries;
+	TArray<bool> Filled;
+	uint64 Offered = 0;
+};
+
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FULMChannelSampler
+{
+	// Settings published by the channel registry
+	std::atomic<EULMSamplingMode> Mode{EULMSamplingMode::EveryN};
+	std::atomic<uint32> FixedRate{100};
+	std::atomic<float> Budget{50.0f};
+	std::atomic<uint64> WindowCycles{0};
+
+	// Keep-one-in-N for Budget decisions and keyed calls - retuned when a window closes
+	std::atomic<uint32> CurrentRate{100};
+	std::atomic<uint64> WindowEnd{0};
+	std::atomic<uint32> WindowCalls{0};
+
+	// Every call offered, and every entry kept
+	std::atomic<uint64> Counter{0};
+	std::atomic<int64> Kept{0};
+
+	// Reservoir, guarded by ReservoirLock - ReservoirEnd and bHasClosedWindows are also read without it so idle
+	// channels are skipped. Slot arrays grow as slots are filled, so starting a window never touches Capacity entries.
+	FCriticalSection ReservoirLock;
+	TArray<FULMLogQueueEntry> ReservoirEntries;
+	TArray<bool> ReservoirFilled;
+	int32 ReservoirCapacity = 0;
+	uint64 ReservoirOffered = 0;
+	uint32 ReservoirWindow = 0;
+	uint64 RandomState = 0x9E3779B97F4A7C15ull;
+	std::atomic<uint64> ReservoirEnd{0};
+
+	// Windows closed by whichever thread noticed first, emitted by the processor in FlushReservoirs
+	TArray<FULMClosedReservoir> ClosedWindows;
+	std::atomic<bool> bHasClosedWindows{false};
+};
+
+static FULMChannelSampler GULMSamplers[ULM_CHANNEL_COUNT];
+
+static uint64 SecondsToCycles(float Seconds)
+{
+	return static_cast<uint64>(static_cast<double>(Seconds) / FPlatformTime::GetSecondsPerCycle64());
+}
+
+// Murmur3 finalizer - spreads sequential IDs and pointer hashes over the full range for the threshold test
+static uint32 MixKeyHash(uint32 Hash)
+{
+	Hash ^= Hash >> 16;
+	Hash *= 0x85EBCA6Bu;
+	Hash ^= Hash >> 13;
+	Hash *= 0xC2B2AE35u;
+	Hash ^= Hash >> 16;
+	return Hash;
+}
+
+static uint64 NextRandom(FULMChannelSampler& Sampler)
+{
+	// xorshift64 - only called under ReservoirLock
+	uint64 State = Sampler.RandomState;
+	State ^= State << 13;
+	State ^= State >> 7;
+	State ^= State << 17;
+	Sampler.RandomState = State;
+	return State;
+}
+
+static FULMSampleDecision KeepEveryN(FULMChannelSampler& Sampler, uint32 Rate)
+{
+	if (Sampler.Counter.fetch_add(1, std::memory_order_relaxed) % Rate != 0)
+	{
+		return FULMSampleDecision();
+	}
+
+	Sampler.Kept.fetch_add(1, std::memory_order_relaxed);
+	return FULMSampleDecision::Keep(static_cast<float>(Rate));
+}
+
+// Count one call against the current window and retune N when it closes - returns the rate to sample at
+static uint32 TrackWindow(FULMChannelSampler& Sampler)
+{
+	const uint64 Window = Sampler.WindowCycles.load(std::memory_order_relaxed);
+	const float Budget = Sampler.Budget.load(std::memory_order_relaxed);
+	const uint32 Rate = Sampler.CurrentRate.load(std::memory_order_relaxed);
+	const uint32 Calls = Sampler.WindowCalls.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	const double WindowSeconds = static_cast<double>(Window) * FPlatformTime::GetSecondsPerCycle64();
+	const double BurstCalls = Budget * WindowSeconds * Rate * BurstRetuneFactor;
+
+	const uint64 Now = FPlatformTime::Cycles64();
+	uint64 End = Sampler.WindowEnd.load(std::memory_order_relaxed);
+	if ((Now < End && Calls < BurstCalls) || !Sampler.WindowEnd.compare_exchange_strong(End, Now + Window, std::memory_order_relaxed))
+	{
+		return Rate;
+	}
+
+	// This call closed the window - the first window only starts the clock
+	const uint32 WindowTotal = Sampler.WindowCalls.exchange(0, std::memory_order_relaxed);
+	if (End == 0)
+	{
+		return Rate;
+	}
+
+	// Spread the window's arrival rate over the budget
+	const uint64 Start = End > Window ? End - Window : 0;
+	const double Elapsed = FMath::Max(static_cast<double>(Now - FMath::Min(Start, Now)) * FPlatformTime::GetSecondsPerCycle64(), 0.001);
+	const double Needed = FMath::CeilToDouble(WindowTotal / Elapsed / FMath::Max(Budget, 0.1f));
+	const uint32 NewRate = static_cast<uint32>(FMath::Clamp(Needed, 1.0, static_cast<double>(MaxSampleRate)));
+	Sampler.CurrentRate.store(NewRate, std::memory_order_relaxed);
+	return NewRate;
+}
+
+// Close the sampler's reservoir window and start the next - expects ReservoirLock held. Constant time: the closed
+// slots are moved whole onto ClosedWindows for the processor, so a producer never walks or emits them.
+static void RollReservoir(FULMChannelSampler& Sampler, uint64 Now)
+{
+	if (Sampler.ReservoirOffered > 0)
+	{
+		FULMClosedReservoir& Closed = Sampler.ClosedWindows.AddDefaulted_GetRef();
+		Closed.Entries = MoveTemp(Sampler.ReservoirEntries);
+		Closed.Filled = MoveTemp(Sampler.ReservoirFilled);
+		Closed.Offered = Sampler.ReservoirOffered;
+		Sampler.bHasClosedWindows.store(true, std::memory_order_relaxed);
+	}
+
+	const bool bActive = Sampler.Mode.load(std::memory_order_relaxed) == EULMSamplingMode::Reservoir;
+	const uint64 Window = Sampler.WindowCycles.load(std::memory_order_relaxed);
+	const double WindowSeconds = static_cast<double>(Window) * FPlatformTime::GetSecondsPerCycle64();
+	Sampler.ReservoirCapacity = bActive ? FMath::Clamp(FMath::RoundToInt(Sampler.Budget.load(std::memory_order_relaxed) * WindowSeconds), 1, MaxReservoirSize) : 0;
+
+	Sampler.ReservoirEntries.Reset();
+	Sampler.ReservoirFilled.Reset();
+	Sampler.ReservoirOffered = 0;
+	++Sampler.ReservoirWindow;
+
+	// Channels that left Reservoir mode go idle once their last window is out
+	Sampler.ReservoirEnd.store(bActive ? Now + Window : 0, std::memory_order_relaxed);
+}
+
+// Weight, admit and queue a closed window's entries - processor thread only, outside the reservoir lock
+static void EmitReservoir(FULMChannelSampler& Sampler, EULMChannelId ChannelId, FULMClosedReservoir& Closed)
+{
+	int32 NumFilled = 0;
+	for (const bool bFilled : Closed.Filled)
+	{
+		NumFilled += bFilled ? 1 : 0;
+	}
+	if (NumFilled == 0)
+	{
+		return;
+	}
+
+	// Each kept entry stands for an equal share of the calls offered in its window
+	const float Weight = static_cast<float>(Closed.Offered) / NumFilled;
+	Sampler.Kept.fetch_add(NumFilled, std::memory_order_relaxed);
+
+	FULMChannelRegistry* Registry = GULMChannelRegistry.load(std::memory_order_acquire);
+	UULMSubsystem* Subsystem = GULMSubsystem.load(std::memory_order_acquire);
+	if (!Registry || !Subsystem)
+	{
+		return;
+	}
+
+	for (int32 Slot = 0; Slot < Closed.Entries.Num(); ++Slot)
+	{
+		if (Closed.Filled[Slot])
+		{
+			FULMLogQueueEntry& Entry = Closed.Entries[Slot];
+			const FULMAdmissionTicket Ticket = Registry->Admit(ChannelId, Entry.Verbosity);
+			Entry.SampleWeight = Weight;
+			Subsystem->StoreSampledLogEntry(MoveTemp(Entry), Ticket);
+		}
+	}
+}
+
+static FULMSampleDecision OfferReservoir(FULMChannelSampler& Sampler)
+{
+	Sampler.Counter.fetch_add(1, std::memory_order_relaxed);
+
+	FULMSampleDecision Decision;
+	FScopeLock Lock(&Sampler.ReservoirLock);
+
+	// A producer that finds the window over only starts the next one - the processor emits the closed one
+	const uint64 Now = FPlatformTime::Cycles64();
+	if (Now >= Sampler.ReservoirEnd.load(std::memory_order_relaxed))
+	{
+		RollReservoir(Sampler, Now);
+	}
+
+	// Algorithm R - the first Capacity calls fill the slots, call k then replaces a random slot with probability Capacity/k
+	const uint64 Offered = ++Sampler.ReservoirOffered;
+	const uint64 Capacity = static_cast<uint64>(Sampler.ReservoirCapacity);
+	const uint64 Slot = Offered <= Capacity ? Offered - 1 : NextRandom(Sampler) % Offered;
+	if (Slot < Capacity)
+	{
+		// Weight is only known when the window closes - the entry is queued then
+		Decision.Weight = 1.0f;
+		Decision.ReservoirSlot = static_cast<int32>(Slot);
+		Decision.ReservoirWindow = Sampler.ReservoirWindow;
+	}
+	return Decision;
+}
+
+namespace ULMSampling
+{
+	void Configure(EULMChannelId ChannelId, EULMSamplingMode Mode, int32 SampleRate, float BudgetPerSecond, float WindowSeconds)
+	{
+		if (!ULMIsValidChannelId(ChannelId))
+		{
+			return;
+		}
+
+		FULMChannelSampler& Sampler = GULMSamplers[static_cast<int32>(ChannelId)];
+		const uint32 FixedRate = static_cast<uint32>(FMath::Clamp(SampleRate, 1, static_cast<int32>(MaxSampleRate)));
+
+		Sampler.FixedRate.store(FixedRate, std::memory_order_relaxed);
+		Sampler.Budget.store(FMath::Max(0.1f, BudgetPerSecond), std::memory_order_relaxed);
+		Sampler.WindowCycles.store(SecondsToCycles(FMath::Max(0.1f, WindowSeconds)), std::memory_order_relaxed);
+
+		// Every snapshot republishes every channel - adaptive state only restarts when the mode actually changes
+		const EULMSamplingMode PreviousMode = Sampler.Mode.exchange(Mode, std::memory_order_relaxed);
+		if (Mode == EULMSamplingMode::EveryN)
+		{
+			Sampler.CurrentRate.store(FixedRate, std::memory_order_relaxed);
+		}
+		else if (PreviousMode != Mode)
+		{
+			// Keep everything until the first window has measured the arrival rate
+			Sampler.CurrentRate.store(1, std::memory_order_relaxed);
+			Sampler.WindowEnd.store(0, std::memory_order_relaxed);
+			Sampler.WindowCalls.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	FULMSampleDecision Sample(EULMChannelId ChannelId, uint32 RateOverride)
+	{
+		if (!ULMIsValidChannelId(ChannelId))
+		{
+			return FULMSampleDecision();
+		}
+
+		FULMChannelSampler& Sampler = GULMSamplers[static_cast<int32>(ChannelId)];
+		if (RateOverride > 0)
+		{
+			return KeepEveryN(Sampler, RateOverride);
+		}
+
+		switch (Sampler.Mode.load(std::memory_order_relaxed))
+		{
+			case EULMSamplingMode::Budget:
+				return KeepEveryN(Sampler, TrackWindow(Sampler));
+			case EULMSamplingMode::Reservoir:
+				return OfferReservoir(Sampler);
+			case EULMSamplingMode::EveryN:
+			default:
+				return KeepEveryN(Sampler, Sampler.FixedRate.load(std::memory_order_relaxed));
+		}
+	}
+
+	FULMSampleDecision SampleKey(EULMChannelId ChannelId, uint32 KeyHash)
+	{
+		if (!ULMIsValidChannelId(ChannelId))
+		{
+			return FULMSampleDecision();
+		}
+
+		FULMChannelSampler& Sampler = GULMSamplers[static_cast<int32>(ChannelId)];
+		Sampler.Counter.fetch_add(1, std::memory_order_relaxed);
+
+		const uint32 Rate = Sampler.Mode.load(std::memory_order_relaxed) == EULMSamplingMode::EveryN
+			? Sampler.FixedRate.load(std::memory_order_relaxed)
+			: TrackWindow(Sampler);
+
+		// Keep keys whose mixed hash falls below 2^32 / N
+		if (static_cast<uint64>(MixKeyHash(KeyHash)) * Rate >= (1ull << 32))
+		{
+			return FULMSampleDecision();
+		}
+
+		Sampler.Kept.fetch_add(1, std::memory_order_relaxed);
+		return FULMSampleDecision::Keep(static_cast<float>(Rate));
+	}
+
+	void FillReservoir(EULMChannelId ChannelId, const FULMSampleDecision& Decision, FULMLogQueueEntry&& Entry)
+	{
+		if (!ULMIsValidChannelId(ChannelId) || !Decision.IsReservoir())
+		{
+			return;
+		}
+
+		FULMChannelSampler& Sampler = GULMSamplers[static_cast<int32>(ChannelId)];
+		FScopeLock Lock(&Sampler.ReservoirLock);
+		if (Sampler.ReservoirWindow == Decision.ReservoirWindow && Decision.ReservoirSlot < Sampler.ReservoirCapacity)
+		{
+			if (Sampler.ReservoirEntries.Num() <= Decision.ReservoirSlot)
+			{
+				Sampler.ReservoirEntries.SetNum(Decision.ReservoirSlot + 1);
+				Sampler.ReservoirFilled.SetNumZeroed(Decision.ReservoirSlot + 1);
+			}
+			Sampler.ReservoirEntries[Decision.ReservoirSlot] = MoveTemp(Entry);
+			Sampler.ReservoirFilled[Decision.ReservoirSlot] = true;
+		}
+	}
+
+	void FlushReservoirs(bool bForce)
+	{
+		const uint64 Now = FPlatformTime::Cycles64();
+		for (int32 Index = 0; Index < ULM_CHANNEL_COUNT; ++Index)
+		{
+			FULMChannelSampler& Sampler = GULMSamplers[Index];
+			const uint64 End = Sampler.ReservoirEnd.load(std::memory_order_relaxed);
+			const bool bDue = End != 0 && (bForce || Now >= End);
+			if (!bDue && !Sampler.bHasClosedWindows.load(std::memory_order_relaxed))
+			{
+				continue;
+			}
+
+			TArray<FULMClosedReservoir> Closed;
+			{
+				FScopeLock Lock(&Sampler.ReservoirLock);
+				const uint64 LockedEnd = Sampler.ReservoirEnd.load(std::memory_order_relaxed);
+				if (LockedEnd != 0 && (bForce || Now >= LockedEnd))
+				{
+					RollReservoir(Sampler, Now);
+				}
+				Closed = MoveTemp(Sampler.ClosedWindows);
+				Sampler.bHasClosedWindows.store(false, std::memory_order_relaxed);
+			}
+
+			for (FULMClosedReservoir& Window : Closed)
+			{
+				EmitReservoir(Sampler, static_cast<EULMChannelId>(Index), Window);
+			}
+		}
+	}
+
+	FULMSamplerStats GetStats(EULMChannelId ChannelId)
+	{
+		FULMSamplerStats Stats;
+		if (ULMIsValidChannelId(ChannelId))
+		{
+			const FULMChannelSampler& Sampler = GULMSamplers[static_cast<int32>(ChannelId)];
+			Stats.Mode = Sampler.Mode.load(std::memory_order_relaxed);
+			Stats.Seen = static_cast<int64>(Sampler.Counter.load(std::memory_order_relaxed));
+			Stats.Kept = Sampler.Kept.load(std::memory_order_relaxed);
+			Stats.CurrentRate = Sampler.CurrentRate.load(std::memory_order_relaxed);
+		}
+		return Stats;
+	}
+
+	void ResetStats()
+	{
+		for (FULMChannelSampler& Sampler : GULMSamplers)
+		{
+			Sampler.Counter.store(0, std::memory_order_relaxed);
+			Sampler.Kept.store(0, std::memory_order_relaxed);
+		}
+	}
+}
@@ -0,0 +1,339 @@
+#include "Logging/ULMStructuredFields.h"
+#include "Containers/LockFreeList.h"
+#include "Hash/CityHash.h"
+#include <atomic>
+
+// Idle blocks kept for reuse - blocks that grew past their inline storage are freed instead, so one huge log can't pin memory
+static constexpr int32 MaxPooledFieldBlocks = 256;
+
+struct FULMStructuredFieldBlock
+{
+	TArray<FULMStructuredField, TInlineAllocator<FULMStructuredFields::INLINE_FIELDS>> Fields;
+	TArray<TCHAR, TInlineAllocator<FULMStructuredFields::INLINE_TEXT_CHARS>> Text;
+};
+
+struct FULMStructuredFieldPool
+{
+	TLockFreePointerListUnordered<FULMStructuredFieldBlock, PLATFORM_CACHE_LINE_SIZE> FreeBlocks;
+	std::atomic<int32> NumPooled{0};
+};
+
+static FULMStructuredFieldPool& GetFieldPool()
+{
+	// Intentionally leaked - queue entries can be destroyed during static shutdown
+	static FULMStructuredFieldPool* Pool = new FULMStructuredFieldPool();
+	return *Pool;
+}
+
+static FULMStructuredFieldBlock* AcquireFieldBlock()
+{
+	FULMStructuredFieldPool& Pool = GetFieldPool();
+	if (FULMStructuredFieldBlock* Block = Pool.FreeBlocks.Pop())
+	{
+		Pool.NumPooled.fetch_sub(1, std::memory_order_relaxed);
+		return Block;
+	}
+	return new FULMStructuredFieldBlock();
+}
+
+static void ReleaseFieldBlock(FULMStructuredFieldBlock* Block)
+{
+	FULMStructuredFieldPool& Pool = GetFieldPool();
+	const bool bSpilled = Block->Fields.Max() > FULMStructuredFields::INLINE_FIELDS || Block->Text.Max() > FULMStructuredFields::INLINE_TEXT_CHARS;
+	if (bSpilled || Pool.NumPooled.load(std::memory_order_relaxed) >= MaxPooledFieldBlocks)
+	{
+		delete Block;
+		return;
+	}
+
+	Block->Fields.Reset();
+	Block->Text.Reset();
+	Pool.NumPooled.fetch_add(1, std::memory_order_relaxed);
+	Pool.FreeBlocks.Push(Block);
+}
+
+// Append Source to the block's text buffer - returns its offset
+static int32 AppendBlockText(FULMStructuredFieldBlock& Block, FStringView Source)
+{
+	const int32 Offset = Block.Text.Num();
+	if (Source.Len() > 0)
+	{
+		Block.Text.Append(Source.GetData(), Source.Len());
+	}
+	return Offset;
+}
+
+static FStringView GetBlockText(const FULMStructuredFieldBlock& Block, int32 Offset, int32 Len)
+{
+	return FStringView(Block.Text.GetData() + Offset, Len);
+}
+
+static void AppendView(FString& Out, FStringView Text)
+{
+	Out.Append(Text.GetData(), Text.Len());
+}
+
+static void AppendJSONEscaped(FString& Out, FStringView Text)
+{
+	for (const TCHAR Char : Text)
+	{
+		switch (Char)
+		{
+			case TEXT('\\'): Out += TEXT("\\\\"); break;
+			case TEXT('"'): Out += TEXT("\\\""); break;
+			case TEXT('\n'): Out += TEXT("\\n"); break;
+			case TEXT('\r'): Out += TEXT("\\r"); break;
+			case TEXT('\t'): Out += TEXT("\\t"); break;
+			case TEXT('\b'): Out += TEXT("\\b"); break;
+			case TEXT('\f'): Out += TEXT("\\f"); break;
+			default:
+				if (Char < 0x20)
+				{
+					Out.Appendf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+				}
+				else
+				{
+					Out.AppendChar(Char);
+				}
+				break;
+		}
+	}
+}
+
+// JSON has no NaN or infinity - those become null
+static void AppendJSONNumber(FString& Out, double Value)
+{
+	if (FMath::IsFinite(Value))
+	{
+		Out += FString::SanitizeFloat(Value);
+	}
+	else
+	{
+		Out += TEXT("null");
+	}
+}
+
+static uint64 DoubleBits(double Value)
+{
+	uint64 Bits;
+	FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+	return Bits;
+}
+
+FULMStructuredFields::~FULMStructuredFields()
+{
+	Reset();
+}
+
+FULMStructuredFields::FULMStructuredFields(FULMStructuredFields&& Other)
+	: Block(Other.Block)
+{
+	Other.Block = nullptr;
+}
+
+FULMStructuredFields& FULMStructuredFields::operator=(FULMStructuredFields&& Other)
+{
+	if (this != &Other)
+	{
+		Reset();
+		Block = Other.Block;
+		Other.Block = nullptr;
+	}
+	return *this;
+}
+
+void FULMStructuredFields::Reset()
+{
+	if (Block)
+	{
+		ReleaseFieldBlock(Block);
+		Block = nullptr;
+	}
+}
+
+int32 FULMStructuredFields::Num() const
+{
+	return Block ? Block->Fields.Num() : 0;
+}
+
+FULMStructuredField& FULMStructuredFields::AddField(EULMFieldType Type, FStringView Key)
+{
+	if (!Block)
+	{
+		Block = AcquireFieldBlock();
+	}
+
+	FULMStructuredField& Field = Block->Fields.AddDefaulted_GetRef();
+	Field.Type = Type;
+	Field.KeyOffset = AppendBlockText(*Block, Key);
+	Field.KeyLen = Key.Len();
+	return Field;
+}
+
+void FULMStructuredFields::AddString(FStringView Key, FStringView Value)
+{
+	FULMStructuredField& Field = AddField(EULMFieldType::String, Key);
+	Field.TextOffset = AppendBlockText(*Block, Value);
+	Field.TextLen = Value.Len();
+}
+
+void FULMStructuredFields::AddInt(FStringView Key, int64 Value)
+{
+	AddField(EULMFieldType::Int, Key).IntValue = Value;
+}
+
+void FULMStructuredFields::AddFloat(FStringView Key, double Value)
+{
+	AddField(EULMFieldType::Float, Key).Numbers[0] = Value;
+}
+
+void FULMStructuredFields::AddBool(FStringView Key, bool Value)
+{
+	AddField(EULMFieldType::Bool, Key).bValue = Value;
+}
+
+void FULMStructuredFields::AddVector(FStringView Key, const FVector& Value)
+{
+	FULMStructuredField& Field = AddField(EULMFieldType::Vector, Key);
+	Field.Numbers[0] = Value.X;
+	Field.Numbers[1] = Value.Y;
+	Field.Numbers[2] = Value.Z;
+}
+
+void FULMStructuredFields::AddRotator(FStringView Key, const FRotator& Value)
+{
+	FULMStructuredField& Field = AddField(EULMFieldType::Rotator, Key);
+	Field.Numbers[0] = Value.Pitch;
+	Field.Numbers[1] = Value.Yaw;
+	Field.Numbers[2] = Value.Roll;
+}
+
+void FULMStructuredFields::AppendText(FString& Out) const
+{
+	if (!Block)
+	{
+		return;
+	}
+
+	bool bFirst = true;
+	for (const FULMStructuredField& Field : Block->Fields)
+	{
+		if (!bFirst)
+		{
+			Out += TEXT(", ");
+		}
+		bFirst = false;
+
+		AppendView(Out, GetBlockText(*Block, Field.KeyOffset, Field.KeyLen));
+		Out.AppendChar(TEXT('='));
+
+		// Same text the old string fields produced, so Output Log lines read as before
+		switch (Field.Type)
+		{
+			case EULMFieldType::String:
+				AppendView(Out, GetBlockText(*Block, Field.TextOffset, Field.TextLen));
+				break;
+			case EULMFieldType::Int:
+				Out.Appendf(TEXT("%lld"), Field.IntValue);
+				break;
+			case EULMFieldType::Float:
+				Out += FString::SanitizeFloat(Field.Numbers[0]);
+				break;
+			case EULMFieldType::Bool:
+				Out += Field.bValue ? TEXT("true") : TEXT("false");
+				break;
+			case EULMFieldType::Vector:
+				Out += FVector(Field.Numbers[0], Field.Numbers[1], Field.Numbers[2]).ToString();
+				break;
+			case EULMFieldType::Rotator:
+				Out += FRotator(Field.Numbers[0], Field.Numbers[1], Field.Numbers[2]).ToString();
+				break;
+		}
+	}
+}
+
+void FULMStructuredFields::AppendJSON(FString& Out) const
+{
+	Out.AppendChar(TEXT('{'));
+	if (Block)
+	{
+		bool bFirst = true;
+		for (const FULMStructuredField& Field : Block->Fields)
+		{
+			if (!bFirst)
+			{
+				Out.AppendChar(TEXT(','));
+			}
+			bFirst = false;
+
+			Out.AppendChar(TEXT('"'));
+			AppendJSONEscaped(Out, GetBlockText(*Block, Field.KeyOffset, Field.KeyLen));
+			Out += TEXT("\":");
+
+			switch (Field.Type)
+			{
+				case EULMFieldType::String:
+					Out.AppendChar(TEXT('"'));
+					AppendJSONEscaped(Out, GetBlockText(*Block, Field.TextOffset, Field.TextLen));
+					Out.AppendChar(TEXT('"'));
+					break;
+				case EULMFieldType::Int:
+					Out.Appendf(TEXT("%lld"), Field.IntValue);
+					break;
+				case EULMFieldType::Float:
+					AppendJSONNumber(Out, Field.Numbers[0]);
+					break;
+				case EULMFieldType::Bool:
+					Out += Field.bValue ? TEXT("true") : TEXT("false");
+					break;
+				case EULMFieldType::Vector:
+				case EULMFieldType::Rotator:
+					// [X, Y, Z] or [Pitch, Yaw, Roll]
+					Out.AppendChar(TEXT('['));
+					AppendJSONNumber(Out, Field.Numbers[0]);
+					Out.AppendChar(TEXT(','));
+					AppendJSONNumber(Out, Field.Numbers[1]);
+					Out.AppendChar(TEXT(','));
+					AppendJSONNumber(Out, Field.Numbers[2]);
+					Out.AppendChar(TEXT(']'));
+					break;
+			}
+		}
+	}
+	Out.AppendChar(TEXT('}'));
+}
+
+uint64 FULMStructuredFields::GetHash() const
+{
+	if (!Block)
+	{
+		return 0;
+	}
+
+	uint64 Hash = CityHash64(reinterpret_cast<const char*>(Block->Text.GetData()), static_cast<uint32>(Block->Text.Num() * sizeof(TCHAR)));
+	for (const FULMStructuredField& Field : Block->Fields)
+	{
+		// Member by member - the field struct has padding
+		const uint64 Words[7] =
+		{
+			static_cast<uint64>(Field.Type) | (static_cast<uint64>(Field.bValue) << 8),
+			static_cast<uint64>(static_cast<uint32>(Field.KeyOffset)) | (static_cast<uint64>(static_cast<uint32>(Field.KeyLen)) << 32),
+			static_cast<uint64>(static_cast<uint32>(Field.TextOffset)) | (static_cast<uint64>(static_cast<uint32>(Field.TextLen)) << 32),
+			static_cast<uint64>(Field.IntValue),
+			DoubleBits(Field.Numbers[0]),
+			DoubleBits(Field.Numbers[1]),
+			DoubleBits(Field.Numbers[2])
+		};
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Words), sizeof(Words), Hash);
+	}
+	return Hash;
+}
+
+SIZE_T FULMStructuredFields::GetAllocatedBytes() const
+{
+	if (!Block)
+	{
+		return 0;
+	}
+	return sizeof(FULMStructuredFieldBlock) + Block->Fields.GetAllocatedSize() + Block->Text.GetAllocatedSize();
+}
@@ -0,0 +1,359 @@
+#include "MemoryManagement/ULMLogStore.h"
+#include "Core/ULMSubsystem.h"
+
+// First ring allocation for a channel that was never reserved
+static constexpr int32 MinRingCapacity = 16;
+
+static void AppendLogEntry(EULMChannelId ChannelId, const FULMLogRecord& Record, TArray<FULMLogEntry>& OutEntries)
+{
+	FULMLogEntry& Entry = OutEntries.Emplace_GetRef(FString(Record.TextLen, Record.Text), ChannelId, Record.Verbosity, Record.CaptureCycles, Record.ThreadId, Record.CallsiteId);
+	Entry.SampleWeight = Record.SampleWeight;
+	Entry.Sequence = Record.Sequence;
+}
+
+void FULMLogStoreView::CopyEntries(TArray<FULMLogEntry>& OutEntries, int32 MaxEntries) const
+{
+	const int32 Count = (MaxEntries > 0) ? FMath::Min(MaxEntries, Records.Num()) : Records.Num();
+	OutEntries.Reserve(OutEntries.Num() + Count);
+	for (int32 Index = Records.Num() - Count; Index < Records.Num(); ++Index)
+	{
+		AppendLogEntry(ChannelId, Records[Index], OutEntries);
+	}
+}
+
+FULMChannelLogStore::~FULMChannelLogStore()
+{
+	Empty();
+
+	if (SpareChunk)
+	{
+		FMemory::Free(SpareChunk);
+		SpareChunk = nullptr;
+	}
+}
+
+void FULMChannelLogStore::Add(const FULMLogEntry& Entry, int64 Sequence)
+{
+	if (RecordCount == Records.Num())
+	{
+		GrowRing(RecordCount + 1);
+	}
+
+	// Walk back past any newer records - usually none, so this is a single compare, and never more than MAX_LATE_SHIFT
+	const int32 Mask = Records.Num() - 1;
+	const int32 MinPosition = FMath::Max(0, RecordCount - MAX_LATE_SHIFT);
+	int32 Position = RecordCount;
+	while (Position > MinPosition && GetRecord(Position - 1).CaptureCycles > Entry.CaptureCycles)
+	{
+		--Position;
+	}
+
+	// Every record moved is now newer than this one in capture order but older in sequence
+	for (int32 Index = RecordCount; Index > Position; --Index)
+	{
+		FULMLogRecord& Moved = Records[(RecordHead + Index) & Mask];
+		Moved = Records[(RecordHead + Index - 1) & Mask];
+		Moved.SequenceHighWater = Sequence;
+	}
+	++RecordCount;
+	++NumAdded;
+
+	FULMLogRecord& Record = Records[(RecordHead + Position) & Mask];
+	Record.CaptureCycles = Entry.CaptureCycles;
+	Record.Sequence = Sequence;
+	Record.SequenceHighWater = Sequence;
+	Record.ThreadId = Entry.ThreadId;
+	Record.CallsiteId = Entry.CallsiteId;
+	Record.SampleWeight = Entry.SampleWeight;
+	Record.Verbosity = Entry.Verbosity;
+	Record.TextLen = Entry.Message.Len();
+	Record.Text = AllocateText(Record.TextLen, Record.ChunkSerial);
+
+	// Text went into the newest chunk - inherit the lower serial of the record we were slotted in front of
+	if (Position < RecordCount - 1)
+	{
+		Record.ChunkSerial = GetRecord(Position + 1).ChunkSerial;
+	}
+
+	if (Record.TextLen > 0)
+	{
+		FMemory::Memcpy(const_cast<TCHAR*>(Record.Text), *Entry.Message, Record.TextLen * sizeof(TCHAR));
+	}
+
+	LiveBytes += GetRecordSize(Record.TextLen);
+}
+
+SIZE_T FULMChannelLogStore::RemoveOldest(int32 Count)
+{
+	Count = FMath::Min(Count, Num());
+	if (Count <= 0)
+	{
+		return 0;
+	}
+
+	// Only the removed records are visited - the ring head moves past them and nothing else is touched
+	SIZE_T RemovedBytes = 0;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		RemovedBytes += GetRecordSize(GetRecord(Index).TextLen);
+	}
+	RecordHead = (RecordHead + Count) & (Records.Num() - 1);
+	RecordCount -= Count;
+	LiveBytes -= FMath::Min(LiveBytes, RemovedBytes);
+
+	if (RecordCount == 0)
+	{
+		// Everything is gone - keep the newest chunk and rewind it instead of freeing it, unless a view still reads it
+		RecordHead = 0;
+		if (Chunks.Num() > 0)
+		{
+			ReleaseChunksBefore(Chunks.Last()->Serial);
+			if (Chunks.Last()->GetRefCount() == 1)
+			{
+				Chunks.Last()->Used = 0;
+			}
+		}
+		return RemovedBytes;
+	}
+
+	ReleaseChunksBefore(GetRecord(0).ChunkSerial);
+	return RemovedBytes;
+}
+
+void FULMChannelLogStore::Empty()
+{
+	for (TRefCountPtr<FULMTextChunk>& Chunk : Chunks)
+	{
+		ReleaseChunk(Chunk);
+	}
+	Chunks.Empty();
+
+	// Records are trivially destructible - dropping them is a single free
+	Records.Empty();
+	RecordHead = 0;
+	RecordCount = 0;
+	LiveBytes = 0;
+}
+
+void FULMChannelLogStore::Reserve(int32 NumRecords)
+{
+	if (NumRecords > Records.Num())
+	{
+		GrowRing(NumRecords);
+	}
+}
+
+void FULMChannelLogStore::GrowRing(int32 MinCapacity)
+{
+	const int32 NewCapacity = static_cast<int32>(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max3(MinCapacity, MinRingCapacity, Records.Num() * 2))));
+
+	// Unwrap into the new ring so the oldest record starts at slot 0
+	TArray<FULMLogRecord> NewRecords;
+	NewRecords.SetNum(NewCapacity);
+	for (int32 Index = 0; Index < RecordCount; ++Index)
+	{
+		NewRecords[Index] = GetRecord(Index);
+	}
+
+	Records = MoveTemp(NewRecords);
+	RecordHead = 0;
+}
+
+SIZE_T FULMChannelLogStore::GetAllocatedBytes() const
+{
+	SIZE_T Bytes = SpareChunk ? CHUNK_CAPACITY * sizeof(TCHAR) : 0;
+	for (const TRefCountPtr<FULMTextChunk>& Chunk : Chunks)
+	{
+		Bytes += static_cast<SIZE_T>(Chunk->Capacity) * sizeof(TCHAR);
+	}
+	return Bytes;
+}
+
+void FULMChannelLogStore::CopyEntries(EULMChannelId ChannelId, TArray<FULMLogEntry>& OutEntries, int32 MaxEntries) const
+{
+	const int32 Count = (MaxEntries > 0) ? FMath::Min(MaxEntries, Num()) : Num();
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	OutEntries.Reserve(OutEntries.Num() + Count);
+
+	for (int32 Index = RecordCount - Count; Index < RecordCount; ++Index)
+	{
+		CopyEntry(ChannelId, Index, OutEntries);
+	}
+}
+
+void FULMChannelLogStore::FindNewerThan(int64 AfterSequence, TArray<int32>& OutIndices) const
+{
+	for (int32 Index = RecordCount - 1; Index >= 0; --Index)
+	{
+		const FULMLogRecord& Record = GetRecord(Index);
+		if (Record.SequenceHighWater <= AfterSequence)
+		{
+			// Nothing at or before this record is newer than the cursor
+			break;
+		}
+
+		if (Record.Sequence > AfterSequence)
+		{
+			OutIndices.Add(Index);
+		}
+	}
+}
+
+FULMLogStoreViewPtr FULMChannelLogStore::CreateView(EULMChannelId ChannelId, int32 MaxEntries) const
+{
+	TSharedRef<FULMLogStoreView, ESPMode::ThreadSafe> View = MakeShared<FULMLogStoreView, ESPMode::ThreadSafe>();
+	View->ChannelId = ChannelId;
+
+	const int32 Count = (MaxEntries > 0) ? FMath::Min(MaxEntries, Num()) : Num();
+	if (Count <= 0)
+	{
+		return View;
+	}
+
+	// The window is at most two contiguous runs of the ring
+	const int32 Start = (RecordHead + RecordCount - Count) & (Records.Num() - 1);
+	const int32 FirstRun = FMath::Min(Count, Records.Num() - Start);
+	View->Records.Reserve(Count);
+	View->Records.Append(Records.GetData() + Start, FirstRun);
+	View->Records.Append(Records.GetData(), Count - FirstRun);
+
+	// Every record in the window points into a chunk at or after the oldest record's serial
+	const uint32 OldestSerial = View->Records[0].ChunkSerial;
+	for (const TRefCountPtr<FULMTextChunk>& Chunk : Chunks)
+	{
+		if (Chunk->Serial >= OldestSerial)
+		{
+			View->Chunks.Add(Chunk);
+		}
+	}
+
+	return View;
+}
+
+void FULMChannelLogStore::CopyEntry(EULMChannelId ChannelId, int32 Index, TArray<FULMLogEntry>& OutEntries) const
+{
+	AppendLogEntry(ChannelId, GetRecord(Index), OutEntries);
+}
+
+void FULMChannelLogStore::CopyNewestMerged(TConstArrayView<const FULMChannelLogStore*> Stores, TArray<FULMLogEntry>& OutEntries, int32 MaxEntries)
+{
+	struct FCursor
+	{
+		uint64 CaptureCycles;
+		int32 Store;
+		int32 Index;
+	};
+
+	// Newest first; on equal cycles the higher channel comes first, so the reversed output matches a stable sort by channel
+	auto NewerFirst = [](const FCursor& A, const FCursor& B)
+	{
+		return A.CaptureCycles != B.CaptureCycles ? A.CaptureCycles > B.CaptureCycles : A.Store > B.Store;
+	};
+
+	TArray<FCursor, TInlineAllocator<ULM_CHANNEL_COUNT>> Heap;
+	int32 Total = 0;
+	for (int32 StoreIndex = 0; StoreIndex < Stores.Num(); ++StoreIndex)
+	{
+		const int32 NumRecords = Stores[StoreIndex]->Num();
+		if (NumRecords > 0)
+		{
+			Heap.Add({ Stores[StoreIndex]->GetRecord(NumRecords - 1).CaptureCycles, StoreIndex, NumRecords - 1 });
+			Total += NumRecords;
+		}
+	}
+
+	const int32 Count = (MaxEntries > 0) ? FMath::Min(MaxEntries, Total) : Total;
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	// Pick the newest Count records, then materialise them oldest first
+	TArray<FCursor> Picked;
+	Picked.Reserve(Count);
+	Heap.Heapify(NewerFirst);
+	while (Picked.Num() < Count)
+	{
+		FCursor Cursor;
+		Heap.HeapPop(Cursor, NewerFirst, EAllowShrinking::No);
+		Picked.Add(Cursor);
+
+		if (Cursor.Index > 0)
+		{
+			const int32 PrevIndex = Cursor.Index - 1;
+			Heap.HeapPush(FCursor{ Stores[Cursor.Store]->GetRecord(PrevIndex).CaptureCycles, Cursor.Store, PrevIndex }, NewerFirst);
+		}
+	}
+
+	OutEntries.Reserve(OutEntries.Num() + Count);
+	for (int32 PickIndex = Picked.Num() - 1; PickIndex >= 0; --PickIndex)
+	{
+		const FCursor& Cursor = Picked[PickIndex];
+		Stores[Cursor.Store]->CopyEntry(static_cast<EULMChannelId>(Cursor.Store), Cursor.Index, OutEntries);
+	}
+}
+
+TCHAR* FULMChannelLogStore::AllocateText(int32 NumChars, uint32& OutSerial)
+{
+	if (NumChars <= 0)
+	{
+		// Empty text needs no storage, but the serial must not go backwards
+		OutSerial = Chunks.Num() > 0 ? Chunks.Last()->Serial : NextChunkSerial;
+		return nullptr;
+	}
+
+	if (Chunks.Num() == 0 || Chunks.Last()->Capacity - Chunks.Last()->Used < NumChars)
+	{
+		FULMTextChunk* NewChunk = new FULMTextChunk();
+		NewChunk->Capacity = FMath::Max(NumChars, CHUNK_CAPACITY);
+		NewChunk->Serial = NextChunkSerial++;
+
+		if (NewChunk->Capacity == CHUNK_CAPACITY && SpareChunk)
+		{
+			NewChunk->Data = SpareChunk;
+			SpareChunk = nullptr;
+		}
+		else
+		{
+			NewChunk->Data = static_cast<TCHAR*>(FMemory::Malloc(static_cast<SIZE_T>(NewChunk->Capacity) * sizeof(TCHAR)));
+		}
+
+		Chunks.Emplace(NewChunk);
+	}
+
+	FULMTextChunk& Chunk = *Chunks.Last();
+	TCHAR* Result = Chunk.Data + Chunk.Used;
+	Chunk.Used += NumChars;
+	OutSerial = Chunk.Serial;
+	return Result;
+}
+
+void FULMChannelLogStore::ReleaseChunksBefore(uint32 Serial)
+{
+	int32 NumReleased = 0;
+	while (NumReleased < Chunks.Num() && Chunks[NumReleased]->Serial < Serial)
+	{
+		ReleaseChunk(Chunks[NumReleased]);
+		++NumReleased;
+	}
+
+	if (NumReleased > 0)
+	{
+		Chunks.RemoveAt(0, NumReleased, EAllowShrinking::No);
+	}
+}
+
+void FULMChannelLogStore::ReleaseChunk(TRefCountPtr<FULMTextChunk>& Chunk)
+{
+	// Recycle the memory only if no view still reads it - otherwise the last view to let go frees it
+	if (Chunk->GetRefCount() == 1 && Chunk->Capacity == CHUNK_CAPACITY && !SpareChunk)
+	{
+		SpareChunk = Chunk->Data;
+		Chunk->Data = nullptr;
+	}
+	Chunk.SafeRelease();
+}
@@ -0,0 +1,240 @@
+#include "MemoryManagement/ULMLogStore.h"
+#include "Core/ULMSubsystem.h"
+#include "Channels/ULMLogCategories.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Thread.h"
+#include <atomic>
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Ring wrap and eviction order check for FULMChannelLogStore
+ * Adds entries to a private store from a small reservation so the ring grows and then wraps many times, trimming
+ * to MaxEntries after each add as the subsystem does. Every LateInterval-th entry is stamped a few records in the
+ * past, like a priority-lane or reservoir arrival. A plain array kept in capture order is the reference: after
+ * every add the store must hold the same records in the same order, evict exactly the oldest ones, and report
+ * the same live bytes. Text chunks must be released as the ring cycles.
+ */
+
+static constexpr int32 RingCheckLateInterval = 97;
+static constexpr uint64 RingCheckCycleStep = 10;
+
+struct FULMRingCheckRecord
+{
+	uint64 CaptureCycles = 0;
+	int64 Sequence = 0;
+	FString Text;
+};
+
+static FString DescribeRingMismatch(const FULMChannelLogStore& Store, const TArray<FULMRingCheckRecord>& Model, SIZE_T ModelBytes)
+{
+	if (Store.Num() != Model.Num())
+	{
+		return FString::Printf(TEXT("store holds %d records, expected %d"), Store.Num(), Model.Num());
+	}
+
+	for (int32 Index = 0; Index < Model.Num(); ++Index)
+	{
+		const FULMLogRecord& Record = Store.GetRecord(Index);
+		const FULMRingCheckRecord& Expected = Model[Index];
+		if (Record.Sequence != Expected.Sequence || Record.CaptureCycles != Expected.CaptureCycles
+			|| !FStringView(Record.Text, Record.TextLen).Equals(Expected.Text, ESearchCase::CaseSensitive))
+		{
+			return FString::Printf(TEXT("record %d is sequence %lld, expected %lld"), Index, Record.Sequence, Expected.Sequence);
+		}
+	}
+
+	if (Store.GetLiveBytes() != ModelBytes)
+	{
+		return FString::Printf(TEXT("live bytes %llu, expected %llu"), static_cast<uint64>(Store.GetLiveBytes()), static_cast<uint64>(ModelBytes));
+	}
+
+	return FString();
+}
+
+static void RunRingCheck(const TArray<FString>& Args)
+{
+	const int32 NumEntries = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 100, 1000000) : 10000;
+	const int32 MaxEntries = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 4, 65536) : 256;
+
+	FULMChannelLogStore Store;
+	Store.Reserve(4);
+
+	TArray<FULMRingCheckRecord> Model;
+	SIZE_T ModelBytes = 0;
+	FString Mismatch;
+	int32 LateArrivals = 0;
+	SIZE_T PeakAllocated = 0;
+	SIZE_T PeakLiveChars = 0;
+
+	for (int64 Sequence = 1; Sequence <= NumEntries && Mismatch.IsEmpty(); ++Sequence)
+	{
+		// Lengths vary so chunk boundaries fall at different ring positions
+		FULMLogEntry Entry(FString::Printf(TEXT("Ring check entry %lld %s"), Sequence, *FString::ChrN(static_cast<int32>(Sequence % 200), TEXT('x'))), EULMChannelId::Debug, EULMVerbosity::Message);
+		const bool bLate = Sequence % RingCheckLateInterval == 0 && Model.Num() >= 3;
+		Entry.SetCaptureTime(bLate ? Model.Last(2).CaptureCycles - 1 : Sequence * RingCheckCycleStep);
+		LateArrivals += bLate ? 1 : 0;
+
+		Store.Add(Entry, Sequence);
+
+		// The store slots a late arrival in after every record captured at or before it, up to MAX_LATE_SHIFT back
+		const int32 MinPosition = FMath::Max(0, Model.Num() - FULMChannelLogStore::MAX_LATE_SHIFT);
+		int32 Position = Model.Num();
+		while (Position > MinPosition && Model[Position - 1].CaptureCycles > Entry.CaptureCycles)
+		{
+			--Position;
+		}
+		Model.Insert(FULMRingCheckRecord{ Entry.CaptureCycles, Sequence, Entry.Message }, Position);
+		ModelBytes += FULMChannelLogStore::GetRecordSize(Entry.Message.Len());
+
+		if (Store.Num() > MaxEntries)
+		{
+			const int32 ToRemove = Store.Num() - MaxEntries;
+			SIZE_T ExpectedRemoved = 0;
+			for (int32 Index = 0; Index < ToRemove; ++Index)
+			{
+				ExpectedRemoved += FULMChannelLogStore::GetRecordSize(Model[Index].Text.Len());
+			}
+			Model.RemoveAt(0, ToRemove);
+			ModelBytes -= ExpectedRemoved;
+
+			const SIZE_T Removed = Store.RemoveOldest(ToRemove);
+			if (Removed != ExpectedRemoved)
+			{
+				Mismatch = FString::Printf(TEXT("eviction released %llu bytes, expected %llu"), static_cast<uint64>(Removed), static_cast<uint64>(ExpectedRemoved));
+				break;
+			}
+		}
+
+		Mismatch = DescribeRingMismatch(Store, Model, ModelBytes);
+		PeakAllocated = FMath::Max(PeakAllocated, Store.GetAllocatedBytes());
+		PeakLiveChars = FMath::Max(PeakLiveChars, (ModelBytes - Model.Num() * sizeof(FULMLogRecord)) / sizeof(TCHAR));
+	}
+
+	// Live text plus partly used chunks at either end, one a late arrival may pin, and the spare
+	const SIZE_T AllocationBound = (PeakLiveChars / FULMChannelLogStore::CHUNK_CAPACITY + 4) * FULMChannelLogStore::CHUNK_CAPACITY * sizeof(TCHAR);
+	const bool bChunksReleased = PeakAllocated <= AllocationBound;
+
+	const bool bPassed = Mismatch.IsEmpty() && bChunksReleased;
+	UE_LOG(ULM, Display, TEXT("ULM ring check (%d entries, limit %d, %d late arrivals): peak %llu KB in text chunks (bound %llu KB)%s%s - %s"),
+		NumEntries, MaxEntries, LateArrivals, static_cast<uint64>(PeakAllocated / 1024), static_cast<uint64>(AllocationBound / 1024),
+		Mismatch.IsEmpty() ? TEXT("") : TEXT(", "), *Mismatch, bPassed ? TEXT("PASS") : TEXT("FAIL"));
+}
+
+static FAutoConsoleCommand GULMRingCheckCommand(
+	TEXT("ULM.RingCheck"),
+	TEXT("Wrap a private channel store many times with late arrivals and check record order, eviction order and chunk release. Usage: ULM.RingCheck [Entries=10000] [MaxEntries=256]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunRingCheck));
+
+/**
+ * Read view lifetime check
+ * A writer thread fills a private shard and trims it to MaxEntries, releasing and recycling text chunks as fast
+ * as it can. Meanwhile this thread takes views under the read lock and keeps the last ViewCheckHeldViews alive
+ * while the writer moves on. Each view's text is checked against its sequence only when the view is dropped, long
+ * after its chunks left the store, so a chunk recycled or freed under a live view shows up as wrong text.
+ */
+
+static constexpr int32 ViewCheckHeldViews = 8;
+
+static FString MakeViewCheckText(int64 Sequence)
+{
+	return FString::Printf(TEXT("View check entry %lld %s"), Sequence, *FString::ChrN(static_cast<int32>(Sequence % 200), TEXT('y')));
+}
+
+static void RunViewCheck(const TArray<FString>& Args)
+{
+	const double Seconds = Args.Num() > 0 ? FMath::Clamp(FCString::Atod(*Args[0]), 0.1, 60.0) : 2.0;
+	const int32 MaxEntries = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 4, 65536) : 256;
+
+	FULMStorageShard Shard;
+	std::atomic<bool> bStop{false};
+	std::atomic<int64> Written{0};
+
+	FThread Writer(TEXT("ULMViewCheckWriter"), [&]()
+	{
+		int64 Sequence = 0;
+		while (!bStop.load(std::memory_order_relaxed))
+		{
+			++Sequence;
+			const FULMLogEntry Entry(MakeViewCheckText(Sequence), EULMChannelId::Debug, EULMVerbosity::Message);
+
+			FWriteScopeLock Lock(Shard.Lock);
+			Shard.Store.Add(Entry, Sequence);
+			if (Shard.Store.Num() > MaxEntries)
+			{
+				Shard.Store.RemoveOldest(Shard.Store.Num() - MaxEntries);
+			}
+			Written.store(Sequence, std::memory_order_relaxed);
+		}
+	});
+
+	TArray<FULMLogStoreViewPtr> HeldViews;
+	int64 ViewsChecked = 0;
+	int64 RecordsChecked = 0;
+	int64 TextErrors = 0;
+	int64 OrderErrors = 0;
+	int64 MaxLag = 0;
+
+	const auto CheckView = [&](const FULMLogStoreView& View)
+	{
+		int64 PreviousSequence = 0;
+		for (int32 Index = 0; Index < View.Num(); ++Index)
+		{
+			const int64 Sequence = View[Index].Sequence;
+			OrderErrors += Sequence <= PreviousSequence ? 1 : 0;
+			TextErrors += View.GetMessage(Index).Equals(MakeViewCheckText(Sequence), ESearchCase::CaseSensitive) ? 0 : 1;
+			PreviousSequence = Sequence;
+		}
+
+		// How far the store had moved past the view - the view is only a real test once its entries are gone
+		if (View.Num() > 0)
+		{
+			MaxLag = FMath::Max(MaxLag, Written.load(std::memory_order_relaxed) - View[View.Num() - 1].Sequence);
+		}
+		RecordsChecked += View.Num();
+		++ViewsChecked;
+	};
+
+	const double EndTime = FPlatformTime::Seconds() + Seconds;
+	while (FPlatformTime::Seconds() < EndTime)
+	{
+		{
+			FReadScopeLock Lock(Shard.Lock);
+			HeldViews.Add(Shard.Store.CreateView(EULMChannelId::Debug));
+		}
+
+		if (HeldViews.Num() > ViewCheckHeldViews)
+		{
+			CheckView(*HeldViews[0]);
+			HeldViews.RemoveAt(0);
+		}
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	bStop.store(true, std::memory_order_relaxed);
+	Writer.Join();
+
+	for (const FULMLogStoreViewPtr& View : HeldViews)
+	{
+		CheckView(*View);
+	}
+
+	// Views dropped last, after the store released everything they point into
+	HeldViews.Reset();
+	const bool bEvictedUnderViews = MaxLag >= MaxEntries;
+	const bool bPassed = TextErrors == 0 && OrderErrors == 0 && ViewsChecked > 0;
+
+	UE_LOG(ULM, Display, TEXT("ULM view check (%.1f s, limit %d): %lld entries written, %lld views and %lld records checked, store up to %lld entries past a view%s"),
+		Seconds, MaxEntries, Written.load(), ViewsChecked, RecordsChecked, MaxLag,
+		bEvictedUnderViews ? TEXT("") : TEXT(" - views never outlived their entries, result inconclusive"));
+	UE_LOG(ULM, Display, TEXT("ULM view check: %lld text mismatches, %lld order errors - %s"),
+		TextErrors, OrderErrors, bPassed ? TEXT("PASS") : TEXT("FAIL"));
+}
+
+static FAutoConsoleCommand GULMViewCheckCommand(
+	TEXT("ULM.ViewCheck"),
+	TEXT("Hold read views over a private store while a writer evicts and recycles its chunks, then check every view's text. Usage: ULM.ViewCheck [Seconds=2] [MaxEntries=256]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunViewCheck));
+
+#endif
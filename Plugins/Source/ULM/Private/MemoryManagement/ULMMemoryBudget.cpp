@@ -1,76 +1,66 @@
 #include "MemoryManagement/ULMMemoryBudget.h"
 #include "Core/ULMSubsystem.h"
 #include "Logging/ULMLogging.h"
+#include "MemoryManagement/ULMLogStore.h"
 
 SIZE_T FULMMemoryTracker::CalculateLogEntrySize(const FULMLogEntry& Entry) const
 {
-	SIZE_T Size = 0;
-	
-	Size += sizeof(FULMLogEntry);
-	
-	Size += Entry.Message.Len() * sizeof(TCHAR);
-	Size += Entry.Channel.Len() * sizeof(TCHAR);
-	
-	Size += sizeof(FString) * 2;
-	
-	return Size;
+	// Matches what FULMChannelLogStore keeps - a record plus the message text in a chunk
+	return FULMChannelLogStore::GetRecordSize(Entry.Message.Len());
 }
 
-void FULMMemoryTracker::AddMemoryUsage(const FString& ChannelName, SIZE_T MemorySize)
+void FULMMemoryTracker::AddMemoryUsage(EULMChannelId ChannelId, SIZE_T MemorySize)
 {
+	if (!ULMIsValidChannelId(ChannelId))
+	{
+		return;
+	}
+	
 	TotalMemoryUsedCounter.Add(MemorySize);
 	TotalEntriesCounter.Increment();
 	
 	{
 		FScopeLock Lock(&ChannelMemoryLock);
 		
-		SIZE_T* ExistingUsage = ChannelMemoryUsage.Find(ChannelName);
-		if (ExistingUsage)
-		{
-			*ExistingUsage += MemorySize;
-		}
-		else
-		{
-			ChannelMemoryUsage.Add(ChannelName, MemorySize);
-		}
+		ChannelMemoryUsage[static_cast<int32>(ChannelId)] += MemorySize;
 		
 		UpdateLargestChannel();
 	}
 }
 
-void FULMMemoryTracker::RemoveMemoryUsage(const FString& ChannelName, SIZE_T MemorySize)
+void FULMMemoryTracker::RemoveMemoryUsage(EULMChannelId ChannelId, SIZE_T MemorySize, int32 EntryCount)
 {
+	if (!ULMIsValidChannelId(ChannelId))
+	{
+		return;
+	}
+	
 	TotalMemoryUsedCounter.Subtract(MemorySize);
-	TotalEntriesCounter.Decrement();
+	TotalEntriesCounter.Subtract(EntryCount);
 	
 	{
 		FScopeLock Lock(&ChannelMemoryLock);
 		
-		SIZE_T* ExistingUsage = ChannelMemoryUsage.Find(ChannelName);
-		if (ExistingUsage)
-		{
-			*ExistingUsage = (*ExistingUsage > MemorySize) ? (*ExistingUsage - MemorySize) : 0;
-			
-			if (*ExistingUsage == 0)
-			{
-				ChannelMemoryUsage.Remove(ChannelName);
-			}
-		}
+		SIZE_T& ExistingUsage = ChannelMemoryUsage[static_cast<int32>(ChannelId)];
+		ExistingUsage = (ExistingUsage > MemorySize) ? (ExistingUsage - MemorySize) : 0;
 		
 		UpdateLargestChannel();
 	}
 	
 	ULM_LOG(CHANNEL_PERFORMANCE, EULMVerbosity::Message, 
 		TEXT("Memory removed - Channel: %s, Size: %lld bytes, Total: %lld bytes"), 
-		*ChannelName, MemorySize, GetTotalMemoryUsage());
+		ULMChannelNameFromId(ChannelId), MemorySize, GetTotalMemoryUsage());
 }
 
-SIZE_T FULMMemoryTracker::GetChannelMemoryUsage(const FString& ChannelName) const
+SIZE_T FULMMemoryTracker::GetChannelMemoryUsage(EULMChannelId ChannelId) const
 {
-	FScopeLock Lock(&ChannelMemoryLock);
+	if (!ULMIsValidChannelId(ChannelId))
+	{
+		return 0;
+	}
 	
-	const SIZE_T* Usage = ChannelMemoryUsage.Find(ChannelName);
-	return Usage ? *Usage : 0;
+	FScopeLock Lock(&ChannelMemoryLock);
+	return ChannelMemoryUsage[static_cast<int32>(ChannelId)];
 }
 
 bool FULMMemoryTracker::WouldExceedBudget(SIZE_T AdditionalMemory) const
@@ -96,7 +86,7 @@ FULMMemoryDiagnostics FULMMemoryTracker::ToBlueprint() const
 	
 	{
 		FScopeLock Lock(&ChannelMemoryLock);
-		Result.LargestChannelName = LargestChannelName;
+		Result.LargestChannelName = ULMIsValidChannelId(LargestChannelId) ? ULMChannelNameFromId(LargestChannelId) : TEXT("None");
 		Result.LargestChannelUsage = LargestChannelUsage;
 	}
 	
@@ -111,8 +101,11 @@ void FULMMemoryTracker::Reset()
 	
 	{
 		FScopeLock Lock(&ChannelMemoryLock);
-		ChannelMemoryUsage.Empty();
-		LargestChannelName = TEXT("None");
+		for (SIZE_T& Usage : ChannelMemoryUsage)
+		{
+			Usage = 0;
+		}
+		LargestChannelId = EULMChannelId::Invalid;
 		LargestChannelUsage = 0;
 	}
 	
@@ -123,19 +116,19 @@ void FULMMemoryTracker::UpdateLargestChannel()
 {
 	// Must be called within ChannelMemoryLock
 	
-	FString NewLargestName = TEXT("None");
+	EULMChannelId NewLargestId = EULMChannelId::Invalid;
 	SIZE_T NewLargestUsage = 0;
 	
-	for (const auto& ChannelPair : ChannelMemoryUsage)
+	for (int32 Index = 0; Index < ULM_CHANNEL_COUNT; ++Index)
 	{
-		if (ChannelPair.Value > NewLargestUsage)
+		if (ChannelMemoryUsage[Index] > NewLargestUsage)
 		{
-			NewLargestUsage = ChannelPair.Value;
-			NewLargestName = ChannelPair.Key;
+			NewLargestUsage = ChannelMemoryUsage[Index];
+			NewLargestId = static_cast<EULMChannelId>(Index);
 		}
 	}
 	
-	LargestChannelName = NewLargestName;
+	LargestChannelId = NewLargestId;
 	LargestChannelUsage = NewLargestUsage;
 }
 
@@ -0,0 +1,134 @@
+#include "MemoryManagement/ULMLogStore.h"
+#include "Core/ULMSubsystem.h"
+#include "Channels/ULMLogCategories.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Thread.h"
+#include <atomic>
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Reader/writer contention benchmark for the sharded log storage
+ * One writer stands in for the log processor, inserting round-robin across channels and trimming at a fixed
+ * entry limit; readers each poll one channel for its newest entries, as a Blueprint panel would. The same load
+ * runs against per-channel shard locks and against a single lock over every store (the old layout), on private
+ * stores so the live subsystem is untouched.
+ */
+
+static constexpr int32 BenchmarkMaxEntries = 1000;
+static constexpr int32 BenchmarkReadEntries = 100;
+
+struct FULMStorageBenchmarkResult
+{
+	int64 Writes = 0;
+	int64 Reads = 0;
+	double Seconds = 0.0;
+
+	// Longest time the writer waited for a lock - what a slow reader costs the log processor
+	double MaxWriteWaitMs = 0.0;
+};
+
+static FULMStorageBenchmarkResult RunStorageBenchmark(bool bSharded, double Seconds, int32 NumReaders)
+{
+	TStaticArray<FULMStorageShard, ULM_CHANNEL_COUNT> Shards;
+	FCriticalSection GlobalLock;
+	std::atomic<bool> bStop{false};
+	std::atomic<int64> Reads{0};
+
+	TArray<FULMLogEntry> Templates;
+	for (int32 Index = 0; Index < ULM_CHANNEL_COUNT; ++Index)
+	{
+		Templates.Emplace(FString::Printf(TEXT("Benchmark entry for channel %d with some representative payload text"), Index), static_cast<EULMChannelId>(Index), EULMVerbosity::Message);
+	}
+
+	FULMStorageBenchmarkResult Result;
+
+	TArray<TUniquePtr<FThread>> Readers;
+	for (int32 ReaderIndex = 0; ReaderIndex < NumReaders; ++ReaderIndex)
+	{
+		Readers.Add(MakeUnique<FThread>(TEXT("ULMStorageBenchmarkReader"), [&, ReaderIndex]()
+		{
+			const int32 Channel = ReaderIndex % ULM_CHANNEL_COUNT;
+			TArray<FULMLogEntry> Out;
+			while (!bStop.load(std::memory_order_relaxed))
+			{
+				Out.Reset();
+				if (bSharded)
+				{
+					FReadScopeLock Lock(Shards[Channel].Lock);
+					Shards[Channel].Store.CopyEntries(static_cast<EULMChannelId>(Channel), Out, BenchmarkReadEntries);
+				}
+				else
+				{
+					FScopeLock Lock(&GlobalLock);
+					Shards[Channel].Store.CopyEntries(static_cast<EULMChannelId>(Channel), Out, BenchmarkReadEntries);
+				}
+				Reads.fetch_add(1, std::memory_order_relaxed);
+			}
+		}));
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	int64 Sequence = 0;
+	while (FPlatformTime::Seconds() - StartTime < Seconds)
+	{
+		const int32 Channel = static_cast<int32>(Sequence % ULM_CHANNEL_COUNT);
+		FULMLogEntry& Entry = Templates[Channel];
+		Entry.CaptureCycles = FPlatformTime::Cycles64();
+
+		const uint64 WaitStart = FPlatformTime::Cycles64();
+		if (bSharded)
+		{
+			FWriteScopeLock Lock(Shards[Channel].Lock);
+			Result.MaxWriteWaitMs = FMath::Max(Result.MaxWriteWaitMs, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - WaitStart));
+			Shards[Channel].Store.Add(Entry, ++Sequence);
+			if (Shards[Channel].Store.Num() > BenchmarkMaxEntries)
+			{
+				Shards[Channel].Store.RemoveOldest(Shards[Channel].Store.Num() - BenchmarkMaxEntries);
+			}
+		}
+		else
+		{
+			FScopeLock Lock(&GlobalLock);
+			Result.MaxWriteWaitMs = FMath::Max(Result.MaxWriteWaitMs, FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - WaitStart));
+			Shards[Channel].Store.Add(Entry, ++Sequence);
+			if (Shards[Channel].Store.Num() > BenchmarkMaxEntries)
+			{
+				Shards[Channel].Store.RemoveOldest(Shards[Channel].Store.Num() - BenchmarkMaxEntries);
+			}
+		}
+	}
+	Result.Seconds = FPlatformTime::Seconds() - StartTime;
+	Result.Writes = Sequence;
+
+	bStop.store(true, std::memory_order_relaxed);
+	for (TUniquePtr<FThread>& Reader : Readers)
+	{
+		Reader->Join();
+	}
+	Result.Reads = Reads.load();
+
+	return Result;
+}
+
+static void RunStorageContentionBenchmark(const TArray<FString>& Args)
+{
+	const double Seconds = Args.Num() > 0 ? FMath::Clamp(FCString::Atod(*Args[0]), 0.1, 60.0) : 2.0;
+	const int32 NumReaders = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 64) : 4;
+
+	for (const bool bSharded : { false, true })
+	{
+		const FULMStorageBenchmarkResult Result = RunStorageBenchmark(bSharded, Seconds, NumReaders);
+		UE_LOG(ULM, Display, TEXT("ULM storage contention (%s, %d readers): %.0f writes/s, %.0f reads/s, worst writer lock wait %.3f ms"),
+			bSharded ? TEXT("per-channel shards") : TEXT("single lock"), NumReaders,
+			Result.Writes / Result.Seconds, Result.Reads / Result.Seconds, Result.MaxWriteWaitMs);
+	}
+}
+
+static FAutoConsoleCommand GULMStorageContentionCommand(
+	TEXT("ULM.StorageContention"),
+	TEXT("Benchmark log storage under reader/writer contention, single lock vs per-channel shards. Usage: ULM.StorageContention [Seconds=2] [Readers=4]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunStorageContentionBenchmark));
+
+#endif
@@ -3,6 +3,7 @@
 #include "Channels/ULMLogCategories.h"
 #include "CoreMinimal.h"
 #include "HAL/CriticalSection.h"
+#include <atomic>
 #include "ULMChannel.generated.h"
 
 UENUM(BlueprintType)
@@ -14,6 +15,43 @@ enum class EULMVerbosity : uint8
 	Critical	UMETA(DisplayName = "Critical")
 };
 
+/**
+ * How a channel's entries are mirrored to the UE Output Log - applied by the log processor, never on the logging thread
+ */
+UENUM(BlueprintType)
+enum class EULMOutputLogMirror : uint8
+{
+	Off					UMETA(DisplayName = "Off"),
+	WarningsAndAbove	UMETA(DisplayName = "Warnings And Above"),
+	Sampled				UMETA(DisplayName = "Sampled"),	// Every Nth entry, plus all errors and criticals
+	Full				UMETA(DisplayName = "Full")
+};
+
+/**
+ * What a producer does when the log queue is over its entry or byte limit
+ */
+UENUM(BlueprintType)
+enum class EULMOverflowPolicy : uint8
+{
+	DropNewest			UMETA(DisplayName = "Drop Newest"),
+	DropOldest			UMETA(DisplayName = "Drop Oldest"),				// Evict the channel's oldest queued entry instead
+	BlockWithTimeout	UMETA(DisplayName = "Block With Timeout"),		// Wait for space - tooling threads only, the game and processor threads drop
+	SampleUnderPressure	UMETA(DisplayName = "Sample Under Pressure")	// Past the soft limit keep every Nth entry, plus all errors and criticals
+};
+
+static constexpr int32 ULM_OVERFLOW_POLICY_COUNT = 4;
+
+/**
+ * How ULM_LOG_SAMPLED picks which calls on a channel are kept - kept entries carry the number of calls they stand for
+ */
+UENUM(BlueprintType)
+enum class EULMSamplingMode : uint8
+{
+	EveryN		UMETA(DisplayName = "Every N"),		// Keep every SampleRate-th call
+	Budget		UMETA(DisplayName = "Budget"),		// Retune N every window to hold the channel near its budget
+	Reservoir	UMETA(DisplayName = "Reservoir")	// Keep a uniform random budget-sized sample of each window, emitted when the window closes
+};
+
 // Master definition of all ULM channels - SINGLE SOURCE OF TRUTH
 // Add new channels here and they will be available everywhere
 #define ULM_CHANNEL_LIST(X) \
@@ -49,6 +87,82 @@ enum class EULMChannel : uint8
 	Custom		UMETA(DisplayName = "Custom (String)")
 };
 
+// Compile-time channel IDs generated from the master list
+// Used to index flat per-channel state so the hot path never hashes channel names
+#define ULM_CHANNEL_ID_ENTRY(EnumName, ChannelStr, DisplayStr) EnumName,
+enum class EULMChannelId : uint8
+{
+	ULM_CHANNEL_LIST(ULM_CHANNEL_ID_ENTRY)
+	Count,
+	Invalid = 0xFF
+};
+#undef ULM_CHANNEL_ID_ENTRY
+
+static constexpr int32 ULM_CHANNEL_COUNT = static_cast<int32>(EULMChannelId::Count);
+
+FORCEINLINE constexpr bool ULMIsValidChannelId(EULMChannelId ChannelId)
+{
+	return ChannelId < EULMChannelId::Count;
+}
+
+/**
+ * Get the canonical channel name for a channel ID (empty string for invalid IDs)
+ */
+inline const TCHAR* ULMChannelNameFromId(EULMChannelId ChannelId)
+{
+	switch (ChannelId)
+	{
+#define ULM_CHANNEL_ID_TO_NAME(EnumName, ChannelStr, DisplayStr) \
+		case EULMChannelId::EnumName: return TEXT(ChannelStr);
+
+		ULM_CHANNEL_LIST(ULM_CHANNEL_ID_TO_NAME)
+#undef ULM_CHANNEL_ID_TO_NAME
+
+		default: return TEXT("");
+	}
+}
+
+/**
+ * Resolve a master list channel name to its ID (Invalid if not in the master list)
+ * Only used at registration and at the Blueprint/string API boundary
+ */
+ULM_API EULMChannelId ULMChannelIdFromName(const TCHAR* ChannelName);
+
+inline EULMChannelId ULMChannelIdFromName(const FString& ChannelName)
+{
+	return ULMChannelIdFromName(*ChannelName);
+}
+
+/**
+ * Packed admission word for a channel, padded to its own cache line
+ * Holds the minimum verbosity when the channel is enabled, or CLOSED when disabled,
+ * so the macro gate is a single relaxed load and compare
+ */
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FULMChannelGate
+{
+	static constexpr uint32 CLOSED = 0xFF;
+
+	std::atomic<uint32> Threshold{CLOSED};
+
+	FORCEINLINE bool IsOpen(EULMVerbosity Verbosity) const
+	{
+		return static_cast<uint32>(Verbosity) >= Threshold.load(std::memory_order_relaxed);
+	}
+
+	void Publish(bool bEnabled, EULMVerbosity MinVerbosity)
+	{
+		Threshold.store(bEnabled ? static_cast<uint32>(MinVerbosity) : CLOSED, std::memory_order_relaxed);
+	}
+
+	void Close()
+	{
+		Threshold.store(CLOSED, std::memory_order_relaxed);
+	}
+};
+
+// Flat gate array indexed by EULMChannelId, written by the channel registry
+extern ULM_API FULMChannelGate GULMChannelGates[ULM_CHANNEL_COUNT];
+
 // Log categories are now declared in ULMLogCategories.h to prevent duplicate definitions
 
 /**
@@ -98,11 +212,74 @@ struct ULM_API FULMChannelConfig
 	UPROPERTY(BlueprintReadWrite, Category = "Channel")
 	bool bInheritFromParent = true;
 
+	// Output Log mirroring is per channel and not inherited
+	UPROPERTY(BlueprintReadWrite, Category = "Channel")
+	EULMOutputLogMirror OutputLogMirror = EULMOutputLogMirror::Full;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Channel", meta = (ClampMin = "1", ClampMax = "10000"))
+	int32 OutputLogSampleRate = 10;
+
+	// Queue backpressure is per channel and not inherited
+	UPROPERTY(BlueprintReadWrite, Category = "Channel")
+	EULMOverflowPolicy OverflowPolicy = EULMOverflowPolicy::DropNewest;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Channel", meta = (ClampMin = "0", ClampMax = "1000"))
+	int32 OverflowBlockTimeoutMs = 5;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Channel", meta = (ClampMin = "1", ClampMax = "10000"))
+	int32 PressureSampleRate = 10;
+
+	// ULM_LOG_SAMPLED sampling is per channel and not inherited
+	UPROPERTY(BlueprintReadWrite, Category = "Channel")
+	EULMSamplingMode SamplingMode = EULMSamplingMode::EveryN;
+
+	// Keep one call in SampleRate - Every N mode only
+	UPROPERTY(BlueprintReadWrite, Category = "Channel", meta = (ClampMin = "1", ClampMax = "100000"))
+	int32 SampleRate = 100;
+
+	// Sampled entries per second the Budget and Reservoir modes aim for
+	UPROPERTY(BlueprintReadWrite, Category = "Channel", meta = (ClampMin = "0.1", ClampMax = "10000.0"))
+	float SamplingBudgetPerSecond = 50.0f;
+
+	// How often Budget retunes N and Reservoir emits its sample
+	UPROPERTY(BlueprintReadWrite, Category = "Channel", meta = (ClampMin = "0.1", ClampMax = "60.0"))
+	float SamplingWindowSeconds = 1.0f;
+
 	FULMChannelConfig() = default;
 };
 
+/**
+ * Lock-free token bucket for per-channel rate limiting
+ * Tokens (16.16 fixed point) and the last refill tick (milliseconds, wrapping) are packed into one 64-bit word
+ * updated with CAS, so producers never serialize on a lock. Lives on its own cache line so the fast reject
+ * on the channel's config fields never shares a line with this hot, written word.
+ */
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FULMTokenBucket
+{
+	static constexpr uint32 FRACTION_BITS = 16;
+	static constexpr uint64 ONE_TOKEN = 1ull << FRACTION_BITS;
+	static constexpr uint64 TOKEN_MASK = 0x7FFFFFFFull;	// 31 bits of tokens above the tick
+	static constexpr uint64 PRIMED_BIT = 1ull << 63;		// Clear until the first admission fills the bucket
+	static constexpr uint32 MAX_ELAPSED_MS = 1u << 24;		// Longer than any bucket takes to fill - bounds the refill product
+	static constexpr int32 MAX_CLOCK_SKEW_MS = 1000;		// Older readings than this are a wrapped tick, not a racing producer
+
+	/** Publish new rate settings - the current token count is kept */
+	void Configure(const FULMRateLimit& RateLimit);
+
+	/** Refill for elapsed time and take one token - returns false if the bucket is empty */
+	bool TryConsume(double CurrentTime);
+
+private:
+	std::atomic<uint64> State{0};
+
+	// Capacity in 16.16 tokens, refill rate in 1/2^32 tokens per millisecond
+	std::atomic<uint64> CapacityFixed{20 * ONE_TOKEN};
+	std::atomic<uint64> RefillPerMsFixed{static_cast<uint64>(20.0 / 1000.0 * 4294967296.0)};
+};
+
 /**
  * Runtime channel state for efficient logging operations
+ * Effective settings are only touched by registry writers; loggers read them through FULMChannelSnapshot
  */
 struct FULMChannelState
 {
@@ -112,25 +289,106 @@ struct FULMChannelState
 	FLinearColor EffectiveColor = FLinearColor::White;
 	FULMRateLimit EffectiveRateLimit;
 	int32 EffectiveMaxEntries = 1000;
+	EULMOutputLogMirror EffectiveOutputLogMirror = EULMOutputLogMirror::Full;
+	int32 EffectiveOutputLogSampleRate = 10;
+	EULMOverflowPolicy EffectiveOverflowPolicy = EULMOverflowPolicy::DropNewest;
+	int32 EffectiveOverflowBlockTimeoutMs = 5;
+	int32 EffectivePressureSampleRate = 10;
+	EULMSamplingMode EffectiveSamplingMode = EULMSamplingMode::EveryN;
+	int32 EffectiveSampleRate = 100;
+	float EffectiveSamplingBudget = 50.0f;
+	float EffectiveSamplingWindow = 1.0f;
 
 	// Rate limiting state
-	float CurrentTokens = 20.0f;
-	double LastRefillTime = 0.0;
+	FULMTokenBucket RateLimiter;
 
 	// Channel hierarchy
 	FString ParentChannel;
 	TArray<FString> ChildChannels;
 
-	// Thread synchronization
-	mutable FCriticalSection StateLock;
-
 	FULMChannelState() = default;
 
-	bool CanLog(EULMVerbosity Verbosity, double CurrentTime);
-	void RefillTokens(double CurrentTime);
 	void UpdateEffectiveSettings(const FULMChannelConfig& Config, const FULMChannelState* ParentState);
 };
 
+/**
+ * Immutable effective settings of one channel inside a snapshot
+ */
+struct FULMChannelView
+{
+	bool bEnabled = false;
+	EULMVerbosity MinVerbosity = EULMVerbosity::Message;
+	int32 MaxEntries = 1000;
+	EULMOutputLogMirror OutputLogMirror = EULMOutputLogMirror::Full;
+	int32 OutputLogSampleRate = 10;
+	EULMOverflowPolicy OverflowPolicy = EULMOverflowPolicy::DropNewest;
+	int32 OverflowBlockTimeoutMs = 5;
+	int32 PressureSampleRate = 10;
+
+	// Runtime token bucket owned by the channel's FULMChannelState - null if the channel is not registered
+	FULMTokenBucket* RateLimiter = nullptr;
+
+	bool IsRegistered() const { return RateLimiter != nullptr; }
+
+	bool CanLog(EULMVerbosity Verbosity, double CurrentTime) const
+	{
+		// Reject on immutable snapshot data before touching the bucket's cache line
+		if (!RateLimiter || !bEnabled || Verbosity < MinVerbosity)
+		{
+			return false;
+		}
+		return RateLimiter->TryConsume(CurrentTime);
+	}
+};
+
+/**
+ * Immutable, versioned view of every registered channel
+ * Published through a single atomic pointer; a new snapshot replaces the old one on every configuration change.
+ * Readers never lock - they pin the current snapshot with FULMChannelSnapshotPin, and a replaced snapshot is only
+ * freed once every reader that could still be holding it has unpinned.
+ */
+struct FULMChannelSnapshot
+{
+	uint64 Version = 0;
+	FULMChannelView ById[ULM_CHANNEL_COUNT];
+	TMap<FString, FULMChannelView> ByName;
+	TMap<FString, FULMChannelConfig> Configs;
+
+	const FULMChannelView* Find(const FString& ChannelName) const
+	{
+		return ByName.Find(ChannelName);
+	}
+
+	const FULMChannelView* Find(EULMChannelId ChannelId) const
+	{
+		return ULMIsValidChannelId(ChannelId) ? &ById[static_cast<int32>(ChannelId)] : nullptr;
+	}
+};
+
+/**
+ * Outcome of the single admission decision made for one log call
+ * Produced once by FULMChannelRegistry::Admit (enabled, verbosity, rate limit) and handed down the logging
+ * pipeline, so later stages never re-check the channel or consume a second token
+ */
+struct FULMAdmissionTicket
+{
+	EULMChannelId ChannelId = EULMChannelId::Invalid;
+	EULMVerbosity Verbosity = EULMVerbosity::Message;
+	bool bAdmitted = false;
+
+	explicit operator bool() const { return bAdmitted; }
+
+	/** Ticket for paths that deliberately skip channel checks (critical system logging) */
+	static FULMAdmissionTicket Bypass(EULMChannelId InChannelId, EULMVerbosity InVerbosity)
+	{
+		FULMAdmissionTicket Ticket;
+		Ticket.ChannelId = InChannelId;
+		Ticket.Verbosity = InVerbosity;
+		Ticket.bAdmitted = ULMIsValidChannelId(InChannelId);
+		return Ticket;
+	}
+};
+
 /**
  * Hierarchical channel management system
  * Provides efficient lookup and inheritance of channel settings
@@ -138,7 +396,8 @@ struct FULMChannelState
 class ULM_API FULMChannelRegistry
 {
 public:
-	FULMChannelRegistry();
+	// Only the subsystem's registry publishes the macro gates and sampler settings - private instances (benchmarks) leave them alone
+	explicit FULMChannelRegistry(bool bInPublishGlobals = true);
 	~FULMChannelRegistry();
 
 	// Channel registration and management
@@ -146,9 +405,13 @@ public:
 	void UnregisterChannel(const FString& ChannelName);
 	bool IsChannelRegistered(const FString& ChannelName) const;
 
-	// Channel lookup and state access
-	const FULMChannelState* GetChannelState(const FString& ChannelName) const;
+	// Lock-free channel lookup goes through FULMChannelSnapshotPin
+	uint64 GetConfigVersion() const { return ConfigVersion.load(std::memory_order_acquire); }
 	bool CanChannelLog(const FString& ChannelName, EULMVerbosity Verbosity) const;
+	bool CanChannelLog(EULMChannelId ChannelId, EULMVerbosity Verbosity) const;
+
+	// Make the one admission decision for a log call - consumes at most one rate limit token
+	FULMAdmissionTicket Admit(EULMChannelId ChannelId, EULMVerbosity Verbosity) const;
 
 	// Configuration management
 	void UpdateChannelConfig(const FString& ChannelName, const FULMChannelConfig& Config);
@@ -164,18 +427,102 @@ public:
 	void SetChannelVerbosity(const FString& ChannelName, EULMVerbosity MinVerbosity, bool bRecursive = false);
 
 private:
+	friend class FULMChannelSnapshotPin;
+
+	// Read side of the snapshot reclamation - pins the current snapshot, counting the reader until EndRead
+	const FULMChannelSnapshot* BeginRead(std::atomic<int32>*& OutReaderCount) const;
+	static void EndRead(std::atomic<int32>* ReaderCount);
+
+	// Mutators that expect RegistryLock to be held for writing - public entry points lock once and publish once
+	void RegisterChannelLocked(const FString& ChannelName, const FULMChannelConfig& Config);
+	void SetChannelEnabledLocked(const FString& ChannelName, bool bEnabled, bool bRecursive);
+	void SetChannelVerbosityLocked(const FString& ChannelName, EULMVerbosity MinVerbosity, bool bRecursive);
+
 	void ParseChannelHierarchy(const FString& ChannelName, FString& OutParent, FString& OutName) const;
 	void UpdateChildChannels(const FString& ParentChannel);
 	void RebuildEffectiveSettings(const FString& ChannelName);
 
-	// Channel storage
+	// Build and publish a new snapshot (and the macro gates) from the writer-side maps, then reclaim drained retirees
+	void PublishSnapshot();
+	void ReclaimRetired(bool bForce);
+
+	// Channel storage (writer side, guarded by RegistryLock)
 	TMap<FString, FULMChannelConfig> ChannelConfigs;
 	TMap<FString, TUniquePtr<FULMChannelState>> ChannelStates;
 
-	// Thread synchronization
+	// Reader side - current snapshot and its version
+	std::atomic<const FULMChannelSnapshot*> Snapshot{nullptr};
+	std::atomic<uint64> ConfigVersion{0};
+
+	// Readers count themselves in their thread's stripe, under the parity of ReaderEpoch, before loading Snapshot.
+	// Every publish flips the parity, so the old one drains even while new readers keep arriving.
+	static constexpr int32 NUM_READER_STRIPES = 32;
+
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FReaderStripe
+	{
+		std::atomic<int32> Count[2]{{0}, {0}};
+	};
+
+	mutable FReaderStripe ReaderStripes[NUM_READER_STRIPES];
+	std::atomic<uint32> ReaderEpoch{0};
+
+	// Replaced snapshot or unregistered state - freed once both parities have been seen with no readers after it retired
+	struct FRetired
+	{
+		TUniquePtr<const FULMChannelSnapshot> Snapshot;
+		TUniquePtr<FULMChannelState> State;
+		uint8 DrainedParities = 0;
+	};
+
+	TArray<FRetired> Retired;
+
+	// Thread synchronization for writers and the hierarchy queries
 	mutable FRWLock RegistryLock;
 
 	// Default configuration
 	FULMChannelConfig DefaultConfig;
+
+	const bool bPublishGlobals;
+};
+
+/**
+ * Scoped read access to the registry's current channel snapshot
+ * The snapshot, and the token buckets its views point at, stay alive until the pin is destroyed. Keep pins short -
+ * copy what is needed out of the view before sleeping or blocking, since a held pin delays reclamation.
+ */
+class FULMChannelSnapshotPin
+{
+public:
+	explicit FULMChannelSnapshotPin(const FULMChannelRegistry* Registry)
+	{
+		if (Registry)
+		{
+			Snapshot = Registry->BeginRead(ReaderCount);
+		}
+	}
+
+	~FULMChannelSnapshotPin()
+	{
+		if (ReaderCount)
+		{
+			FULMChannelRegistry::EndRead(ReaderCount);
+		}
+	}
+
+	FULMChannelSnapshotPin(const FULMChannelSnapshotPin&) = delete;
+	FULMChannelSnapshotPin& operator=(const FULMChannelSnapshotPin&) = delete;
+
+	const FULMChannelSnapshot* Get() const { return Snapshot; }
+	explicit operator bool() const { return Snapshot != nullptr; }
+
+	template <typename KeyType>
+	const FULMChannelView* Find(const KeyType& Key) const
+	{
+		return Snapshot ? Snapshot->Find(Key) : nullptr;
+	}
+
+private:
+	const FULMChannelSnapshot* Snapshot = nullptr;
+	std::atomic<int32>* ReaderCount = nullptr;
 };
 
@@ -5,6 +5,7 @@
 #include "Channels/ULMChannel.h"
 #include "FileIO/ULMJSONFormat.h"
 #include "MemoryManagement/ULMLogRotation.h"
+#include "Core/ULMThreadParker.h"
 #include "ULMSettings.generated.h"
 
 /**
@@ -56,9 +57,14 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "Queue", meta = (DisplayName = "Max Queue Size", ClampMin = "1000", ClampMax = "100000"))
 	int32 MaxQueueSize;
 
+	/** Byte bound on queued messages, so a burst of long messages can't exhaust memory before the entry limit is hit */
+	UPROPERTY(config, EditAnywhere, Category = "Queue", meta = (DisplayName = "Max Queue Memory (MB)", ClampMin = "1", ClampMax = "512"))
+	int32 MaxQueueMemoryMB;
+
 	UPROPERTY(config, EditAnywhere, Category = "Queue", meta = (DisplayName = "Queue Health Threshold", ClampMin = "0.1", ClampMax = "1.0"))
 	float QueueHealthThreshold;
 
+	/** Largest batch the processor takes per cycle - batches grow toward it under backlog and shrink when a batch runs long */
 	UPROPERTY(config, EditAnywhere, Category = "Queue", meta = (DisplayName = "Batch Processing Size", ClampMin = "1", ClampMax = "1000"))
 	int32 BatchProcessingSize;
 
@@ -88,12 +94,26 @@ public:
 	bool bAutoRegisterChannels;
 
 	// === Advanced Performance ===
+	/** Longest time between file flushes - used at high write rates, while a trickle of writes is flushed sooner */
 	UPROPERTY(config, EditAnywhere, Category = "Advanced", meta = (DisplayName = "File Writer Flush Interval (seconds)", ClampMin = "0.1", ClampMax = "60.0"))
 	float FileWriterFlushInterval;
 
+	/** Longest idle wait for the processor and file writer threads - the wait follows the arrival rate below it */
 	UPROPERTY(config, EditAnywhere, Category = "Advanced", meta = (DisplayName = "Thread Sleep Time (ms)", ClampMin = "1", ClampMax = "1000"))
 	int32 ThreadSleepTimeMs;
 
+	/** How the log processor waits for work - Hybrid spins and yields briefly before parking */
+	UPROPERTY(config, EditAnywhere, Category = "Advanced", meta = (DisplayName = "Processor Wait Strategy"))
+	EULMWaitStrategy ProcessorWaitStrategy;
+
+	/** How the file writer waits for work - disk writes aren't latency critical, so Blocking is the default */
+	UPROPERTY(config, EditAnywhere, Category = "Advanced", meta = (DisplayName = "File Writer Wait Strategy"))
+	EULMWaitStrategy FileWriterWaitStrategy;
+
+	/** Identical consecutive entries on a channel within this window are stored once plus a repeat summary - 0 disables */
+	UPROPERTY(config, EditAnywhere, Category = "Advanced", meta = (DisplayName = "Repeat Collapse Window (seconds)", ClampMin = "0.0", ClampMax = "60.0"))
+	float RepeatCollapseWindowSeconds;
+
 	UPROPERTY(config, EditAnywhere, Category = "Advanced", meta = (DisplayName = "Enable System Health Monitoring"))
 	bool bEnableSystemHealthMonitoring;
 
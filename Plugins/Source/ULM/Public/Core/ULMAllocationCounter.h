@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Heap allocation counter for the ULM benchmark commands
+ * While a counter is alive a forwarding FMalloc sits in front of GMalloc and counts allocations made by threads
+ * that opted in with TrackCurrentThread, so engine threads allocating in the background don't skew the result.
+ * Only one counter may be alive at a time - console commands run on the game thread, so they never overlap.
+ */
+class ULM_API FULMAllocationCounter
+{
+public:
+	FULMAllocationCounter();
+	~FULMAllocationCounter();
+
+	FULMAllocationCounter(const FULMAllocationCounter&) = delete;
+	FULMAllocationCounter& operator=(const FULMAllocationCounter&) = delete;
+
+	/** Start or stop counting allocations made on the calling thread */
+	static void TrackCurrentThread(bool bTrack);
+
+	/** Malloc and growing Realloc calls from tracked threads since construction or the last Reset */
+	int64 GetAllocations() const;
+
+	void Reset();
+};
+
+#endif
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Published state of an adaptive batch controller
+ */
+struct FULMBatchControllerStats
+{
+	int32 BatchSize = 0;
+	int32 WaitMs = 0;
+
+	// Smoothed entries per second arriving at and leaving the queue
+	float ArrivalRate = 0.0f;
+	float DrainRate = 0.0f;
+
+	// Smoothed time spent processing one batch
+	float AverageBatchMs = 0.0f;
+
+	int64 Batches = 0;
+	int64 IdleWakeups = 0;
+	int64 Grows = 0;
+	int64 Shrinks = 0;
+};
+
+/**
+ * Feedback controller for a consumer thread's batch size and idle wait
+ * Batches double while a backlog remains after a full batch and shrink by a quarter when a batch overruns the
+ * latency target. The idle wait tracks the observed arrival gap, so a quiet queue sleeps up to the configured
+ * maximum instead of polling. Bounds may be changed from any thread; updates run on the owning consumer thread.
+ */
+class ULM_API FULMBatchController
+{
+public:
+	FULMBatchController(int32 InMinBatchSize, int32 InMaxBatchSize, int32 InMinWaitMs, int32 InMaxWaitMs, float InTargetBatchMs);
+
+	/** Change the bounds - the working batch size and wait are clamped into them on the next update */
+	void SetBatchBounds(int32 InMinBatchSize, int32 InMaxBatchSize);
+	void SetWaitBounds(int32 InMinWaitMs, int32 InMaxWaitMs);
+
+	int32 GetBatchSize() const { return BatchSize; }
+	int32 GetWaitMs() const { return WaitMs; }
+
+	/** Feed back one consumer cycle - Processed entries in BatchSeconds, with RemainingDepth entries still queued */
+	void RecordBatch(int32 Processed, int32 RemainingDepth, double BatchSeconds);
+
+	FULMBatchControllerStats GetStats() const;
+
+private:
+	void Publish();
+
+	// Bounds, written by configuration from any thread
+	std::atomic<int32> MinBatchSize;
+	std::atomic<int32> MaxBatchSize;
+	std::atomic<int32> MinWaitMs;
+	std::atomic<int32> MaxWaitMs;
+	float TargetBatchMs;
+
+	// Working state, consumer thread only
+	int32 BatchSize;
+	int32 WaitMs;
+	int32 LastDepth = 0;
+	double LastUpdateTime = 0.0;
+	double ArrivalRate = 0.0;
+	double DrainRate = 0.0;
+	double AverageBatchMs = 0.0;
+
+	// Published copies for diagnostics readers
+	std::atomic<int32> PublishedBatchSize{0};
+	std::atomic<int32> PublishedWaitMs{0};
+	std::atomic<float> PublishedArrivalRate{0.0f};
+	std::atomic<float> PublishedDrainRate{0.0f};
+	std::atomic<float> PublishedAverageBatchMs{0.0f};
+	std::atomic<int64> Batches{0};
+	std::atomic<int64> IdleWakeups{0};
+	std::atomic<int64> Grows{0};
+	std::atomic<int64> Shrinks{0};
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * Capture-time clock for log entries
+ * Producers only read the cycle counter; cycles are converted to local wall-clock time when an entry is
+ * formatted or handed out, against a calibrated (wall time, cycles) base pair refreshed every RECALIBRATION_SECONDS.
+ */
+struct ULM_API FULMClock
+{
+	// Bounds drift between the cycle counter and the system clock (NTP slews, DST changes)
+	static constexpr double RECALIBRATION_SECONDS = 60.0;
+
+	// How far a converted timestamp may stray from FDateTime::Now() - system clock resolution plus a
+	// recalibration period's worth of counter drift
+	static constexpr double CONVERSION_TOLERANCE_SECONDS = 0.02;
+
+	/** Raw capture timestamp - a single counter read, safe from any thread */
+	FORCEINLINE static uint64 Capture()
+	{
+		return FPlatformTime::Cycles64();
+	}
+
+	/** Convert a captured cycle count to local wall-clock time */
+	static FDateTime ToDateTime(uint64 CaptureCycles);
+
+	/** Current local time through the same calibration, so captured and "now" timestamps agree */
+	static FDateTime Now()
+	{
+		return ToDateTime(Capture());
+	}
+
+	/** Take a fresh wall time / cycles base pair */
+	static void Recalibrate();
+};
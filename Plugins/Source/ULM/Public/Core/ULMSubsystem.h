@@ -5,10 +5,22 @@
 #include "Channels/ULMChannel.h"
 #include "FileIO/ULMFileTypes.h"
 #include "MemoryManagement/ULMMemoryBudget.h"
+#include "MemoryManagement/ULMLogStore.h"
 #include "FileIO/ULMJSONFormat.h"
 #include "MemoryManagement/ULMLogRotation.h"
+#include "Logging/ULMLogQueue.h"
+#include "Logging/ULMDeferredFormat.h"
+#include "Logging/ULMStructuredFields.h"
+#include "Logging/ULMCallsite.h"
+#include "Logging/ULMLogging.h"
+#include "Logging/ULMMessageBuffer.h"
+#include "Logging/ULMProducerRegistry.h"
+#include "Core/ULMClock.h"
+#include "Core/ULMBatchController.h"
+#include "Core/ULMThreadParker.h"
 #include "HAL/ThreadSafeCounter.h"
 #include "Containers/Queue.h"
+#include "Containers/StaticArray.h"
 #include "HAL/Runnable.h"
 #include "HAL/RunnableThread.h"
 #include "ULMSubsystem.generated.h"
@@ -21,23 +33,102 @@ class FULMLogRotator;
 class FULMRetentionManager;
 
 // Queue operation for the log processor
+// Fixed size and move-only - short messages are stored inline, so enqueueing one never touches the heap
 struct FULMLogQueueEntry
 {
-	FString Message;
-	FString Channel;
+	FULMMessageBuffer Message;
+	
+	// Set instead of Message when formatting is deferred to the processor thread
+	FULMDeferredMessage Deferred;
+	
+	// Typed fields of a structured log - Message then holds only the lead text (the function name)
+	FULMStructuredFields Fields;
+	
+	// Static callsite descriptor - file, line and function are resolved from the table, never copied per entry
+	uint32 CallsiteId = 0;
+	
+	EULMChannelId ChannelId;
 	EULMVerbosity Verbosity;
-	FDateTime Timestamp;
+	
+	// Raw cycle counter at capture - converted to wall-clock time off the producer thread (see FULMClock)
+	uint64 CaptureCycles;
 	int32 ThreadId;
 	
+	// Bytes charged against the queue's byte limit when this entry was admitted
+	uint32 QueuedBytes = 0;
+	
+	// Travelled through the reserved error/critical lane - never charged to or evicted from the normal lane
+	bool bPriorityLane = false;
+	
+	// Already written to the Output Log by the caller (critical system logging) - stored, but not mirrored again
+	bool bSkipOutputLog = false;
+	
+	// FULMProducerRegistry slot of the thread that logged it
+	uint8 ProducerSlot = 0;
+	
+	// Calls this entry stands for when it was kept by a sampler
+	float SampleWeight = 1.0f;
+	
 	FULMLogQueueEntry() = default;
 	
-	FULMLogQueueEntry(const FString& InMessage, const FString& InChannel, EULMVerbosity InVerbosity)
-		: Message(InMessage)
-		, Channel(InChannel)
+	FULMLogQueueEntry(const FString& InMessage, EULMChannelId InChannelId, EULMVerbosity InVerbosity, uint32 InCallsiteId = 0)
+		: CallsiteId(InCallsiteId)
+		, ChannelId(InChannelId)
+		, Verbosity(InVerbosity)
+		, CaptureCycles(FULMClock::Capture())
+		, ThreadId(FPlatformTLS::GetCurrentThreadId())
+	{
+		Message.Assign(InMessage);
+	}
+	
+	FULMLogQueueEntry(FULMDeferredMessage&& InDeferred, EULMChannelId InChannelId, EULMVerbosity InVerbosity, uint32 InCallsiteId)
+		: Deferred(MoveTemp(InDeferred))
+		, CallsiteId(InCallsiteId)
+		, ChannelId(InChannelId)
 		, Verbosity(InVerbosity)
-		, Timestamp(FDateTime::Now())
+		, CaptureCycles(FULMClock::Capture())
 		, ThreadId(FPlatformTLS::GetCurrentThreadId())
 	{}
+	
+	FULMLogQueueEntry(const FString& InLead, FULMStructuredFields&& InFields, EULMChannelId InChannelId, EULMVerbosity InVerbosity, uint32 InCallsiteId)
+		: FULMLogQueueEntry(InLead, InChannelId, InVerbosity, InCallsiteId)
+	{
+		Fields = MoveTemp(InFields);
+	}
+	
+	/** Final message text - deferred formatting and field rendering run here, on the processor thread */
+	FString BuildMessage() const
+	{
+		if (Deferred.IsSet())
+		{
+			return Deferred.Format();
+		}
+		
+		FString Result = Message.ToString();
+		if (Fields.IsSet())
+		{
+			if (!Result.IsEmpty())
+			{
+				Result += TEXT(": ");
+			}
+			Fields.AppendText(Result);
+		}
+		return Result;
+	}
+	
+	/** Content identity for repeat collapsing - hashes the captured text, arguments and fields without formatting them */
+	uint64 GetContentHash() const
+	{
+		const uint64 Hash = Deferred.IsSet() ? Deferred.GetHash() : Message.GetHash();
+		return Fields.IsSet() ? Hash ^ (Fields.GetHash() * 0x9E3779B97F4A7C15ull) : Hash;
+	}
+	
+	/** Memory this entry holds while queued - the slot itself plus any spilled text, argument or field storage */
+	uint32 CalculateQueuedBytes() const
+	{
+		const SIZE_T HeapBytes = (Message.IsInline() ? 0 : Message.Len()) + Deferred.GetHeapBytes() + Fields.GetAllocatedBytes();
+		return static_cast<uint32>(sizeof(FULMLogQueueEntry) + HeapBytes);
+	}
 };
 
 // Performance diagnostics for queue operations
@@ -50,6 +141,31 @@ struct FULMQueueDiagnostics
 	FThreadSafeCounter64 TotalEnqueueTime;
 	FThreadSafeCounter64 TotalDequeueTime;
 	
+	// Enqueued messages whose text did not fit inline and needed an overflow block
+	FThreadSafeCounter OverflowMessageCount;
+	
+	// Errors and criticals that went through the priority lane, and those that found it full and fell back to the normal lane
+	FThreadSafeCounter PriorityEnqueueCount;
+	FThreadSafeCounter PriorityLaneFullCount;
+	
+	// Entries folded into a "previous message repeated" summary by the log processor
+	FThreadSafeCounter CollapsedCount;
+	
+	// Backpressure drops, attributed to the overflow policy that made them and to the channel that lost the entry
+	// Every drop is also counted in DroppedCount
+	FThreadSafeCounter PolicyDropCounts[ULM_OVERFLOW_POLICY_COUNT];
+	FThreadSafeCounter ChannelDropCounts[ULM_CHANNEL_COUNT];
+	
+	int32 GetDropCount(EULMOverflowPolicy Policy) const
+	{
+		return PolicyDropCounts[static_cast<int32>(Policy)].GetValue();
+	}
+	
+	int32 GetDropCount(EULMChannelId ChannelId) const
+	{
+		return ULMIsValidChannelId(ChannelId) ? ChannelDropCounts[static_cast<int32>(ChannelId)].GetValue() : 0;
+	}
+	
 	void Reset()
 	{
 		EnqueueCount.Reset();
@@ -58,6 +174,18 @@ struct FULMQueueDiagnostics
 		ProcessedCount.Reset();
 		TotalEnqueueTime.Reset();
 		TotalDequeueTime.Reset();
+		OverflowMessageCount.Reset();
+		PriorityEnqueueCount.Reset();
+		PriorityLaneFullCount.Reset();
+		CollapsedCount.Reset();
+		for (FThreadSafeCounter& Counter : PolicyDropCounts)
+		{
+			Counter.Reset();
+		}
+		for (FThreadSafeCounter& Counter : ChannelDropCounts)
+		{
+			Counter.Reset();
+		}
 	}
 };
 
@@ -85,19 +213,130 @@ struct ULM_API FULMLogEntry
 	UPROPERTY(BlueprintReadOnly, Category = "Log")
 	int32 ThreadId;
 
+	// Master list channel ID (Invalid for channels outside the master list)
+	EULMChannelId ChannelId;
+
+	// Callsite descriptor ID (0 when logged outside the ULM macros)
+	uint32 CallsiteId = 0;
+
+	// Cycle counter at capture - Timestamp is derived from it, and it orders entries exactly across channels
+	uint64 CaptureCycles = 0;
+
+	// Typed fields of a structured log, written to JSON as a nested object
+	// Borrowed from the queue entry - only set while the log processor handles the entry, never on stored copies
+	const FULMStructuredFields* Fields = nullptr;
+
+	// Calls this entry stands for - above 1 for sampled entries, so summing weights rebuilds the original counts
+	UPROPERTY(BlueprintReadOnly, Category = "Log")
+	float SampleWeight = 1.0f;
+
+	// Global storage sequence - increases by one for every stored entry, zero until the entry is stored
+	UPROPERTY(BlueprintReadOnly, Category = "Log")
+	int64 Sequence = 0;
+
 	FULMLogEntry()
 		: Verbosity(EULMVerbosity::Message)
-		, Timestamp(FDateTime::Now())
 		, ThreadId(FPlatformTLS::GetCurrentThreadId())
-	{}
+		, ChannelId(EULMChannelId::Invalid)
+	{
+		SetCaptureTime(FULMClock::Capture());
+	}
 
 	FULMLogEntry(const FString& InMessage, const FString& InChannel, EULMVerbosity InVerbosity)
 		: Message(InMessage)
 		, Channel(InChannel)
 		, Verbosity(InVerbosity)
-		, Timestamp(FDateTime::Now())
 		, ThreadId(FPlatformTLS::GetCurrentThreadId())
-	{}
+		, ChannelId(ULMChannelIdFromName(InChannel))
+	{
+		SetCaptureTime(FULMClock::Capture());
+	}
+
+	FULMLogEntry(const FString& InMessage, EULMChannelId InChannelId, EULMVerbosity InVerbosity)
+		: Message(InMessage)
+		, Channel(ULMChannelNameFromId(InChannelId))
+		, Verbosity(InVerbosity)
+		, ThreadId(FPlatformTLS::GetCurrentThreadId())
+		, ChannelId(InChannelId)
+	{
+		SetCaptureTime(FULMClock::Capture());
+	}
+
+	// Rebuild an entry captured earlier (queue entries, stored records) - the only wall-clock conversion it gets
+	FULMLogEntry(FString&& InMessage, EULMChannelId InChannelId, EULMVerbosity InVerbosity, uint64 InCaptureCycles, int32 InThreadId, uint32 InCallsiteId)
+		: Message(MoveTemp(InMessage))
+		, Channel(ULMChannelNameFromId(InChannelId))
+		, Verbosity(InVerbosity)
+		, ThreadId(InThreadId)
+		, ChannelId(InChannelId)
+		, CallsiteId(InCallsiteId)
+	{
+		SetCaptureTime(InCaptureCycles);
+	}
+
+	void SetCaptureTime(uint64 InCaptureCycles)
+	{
+		CaptureCycles = InCaptureCycles;
+		Timestamp = FULMClock::ToDateTime(InCaptureCycles);
+	}
+
+	/** Resolve file, line and function for this entry - null if it has no callsite */
+	const FULMCallsite* GetCallsite() const
+	{
+		return FULMCallsiteRegistry::Find(CallsiteId);
+	}
+};
+
+/**
+ * Position of an incremental log query - pass the NextCursor of one GetLogEntriesSince call to the next
+ * A cursor follows one filter; reusing it with a different filter may misreport the evicted count.
+ */
+USTRUCT(BlueprintType)
+struct ULM_API FULMLogCursor
+{
+	GENERATED_BODY()
+
+	// Sequence of the last entry consumed - zero starts from the oldest stored entry
+	UPROPERTY(BlueprintReadOnly, Category = "Log")
+	int64 Sequence = 0;
+
+	// Entries each channel had stored by the time Sequence was consumed - lets the next query count evictions
+	int64 ChannelStored[ULM_CHANNEL_COUNT] = {};
+};
+
+/**
+ * Which stored entries an incremental log query returns
+ */
+USTRUCT(BlueprintType)
+struct ULM_API FULMLogQueryFilter
+{
+	GENERATED_BODY()
+
+	// Exact channel name - empty matches every channel
+	UPROPERTY(BlueprintReadWrite, Category = "Log")
+	FString Channel;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Log")
+	EULMVerbosity MinVerbosity = EULMVerbosity::Message;
+};
+
+/**
+ * Entries stored since a cursor, oldest first
+ */
+USTRUCT(BlueprintType)
+struct ULM_API FULMLogQueryResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Log")
+	TArray<FULMLogEntry> Entries;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Log")
+	FULMLogCursor NextCursor;
+
+	// Matching-channel entries stored after the cursor but evicted or cleared before this query could return them
+	UPROPERTY(BlueprintReadOnly, Category = "Log")
+	int64 EvictedCount = 0;
 };
 
 /**
@@ -150,6 +389,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ULM", BlueprintPure)
 	TArray<FULMLogEntry> GetLogEntries(const FString& Channel = TEXT(""), int32 MaxEntries = 100) const;
 
+	// Zero-copy read access (C++ only) - an immutable view of the channel's newest MaxEntries entries (all if <= 0)
+	// Iterate it from any thread without holding a lock; message text is shared with the store, never copied
+	FULMLogStoreViewPtr GetLogView(EULMChannelId ChannelId, int32 MaxEntries = 0) const;
+	FULMLogStoreViewPtr GetLogView(const FString& Channel, int32 MaxEntries = 0) const;
+
+	// Incremental query - only entries stored after the cursor, so polling cost follows new data, not store size
+	FULMLogQueryResult GetLogEntriesSince(const FULMLogCursor& Cursor, const FULMLogQueryFilter& Filter, int32 MaxEntries = 100) const;
+
+	// Blueprint polling wrapper - returns the new entries and advances Cursor in place
+	UFUNCTION(BlueprintCallable, Category = "ULM")
+	TArray<FULMLogEntry> PollLogEntries(UPARAM(ref) FULMLogCursor& Cursor, const FULMLogQueryFilter& Filter, int64& EvictedCount, int32 MaxEntries = 100) const;
+
 	// Hierarchical channel management (C++ only)
 	void RegisterChannel(const FString& ChannelName, const FULMChannelConfig& Config = FULMChannelConfig());
 
@@ -185,16 +436,48 @@ public:
 	void RegisterAllChannelsFromMasterList();
 
 	// Internal function to store log entries without triggering Output Log (prevents circular calls)
-	// Made public for ULMLogging.cpp access
+	// Made public for ULMLogging.cpp access - the channel/verbosity overloads admit the entry themselves,
+	// the ticket overloads trust a decision already made by the caller
+	void StoreLogEntryInternal(const FString& Message, EULMChannelId ChannelId, EULMVerbosity Verbosity, uint32 CallsiteId = 0);
 	void StoreLogEntryInternal(const FString& Message, const FString& ChannelName, EULMVerbosity Verbosity);
+	void StoreLogEntryInternal(const FString& Message, const FULMAdmissionTicket& Ticket, uint32 CallsiteId = 0);
+	
+	// Store a message the caller has already written to the Output Log - the processor stores it without mirroring it
+	void StoreMirroredLogEntry(const FString& Message, EULMChannelId ChannelId, EULMVerbosity Verbosity, uint32 CallsiteId = 0);
+	
+	// Queue a message whose formatting (and Output Log forwarding) runs on the log processor thread
+	void StoreDeferredLogEntry(FULMDeferredMessage&& Message, const FULMAdmissionTicket& Ticket, uint32 CallsiteId);
+	void StoreStructuredLogEntry(const FString& Lead, FULMStructuredFields&& Fields, const FULMAdmissionTicket& Ticket, uint32 CallsiteId);
+	
+	// Queue an entry kept by a sampler - built by the caller so reservoir samples keep their original capture time
+	void StoreSampledLogEntry(FULMLogQueueEntry&& Entry, const FULMAdmissionTicket& Ticket);
 	
 	// Log processor access - needed by FULMLogProcessor
 	void ProcessLogEntry(const FULMLogQueueEntry& Entry);
+	
+	// Release a dequeued entry folded into a repeat run - its queue space is freed but it is never stored
+	void CollapseLogEntry(const FULMLogQueueEntry& Entry);
+	
+	// Store an entry the processor made itself (repeat summaries) - never charged to the queue
+	void ProcessGeneratedLogEntry(const FULMLogQueueEntry& Entry);
+	
+	// Mirror the Output Log lines collected since the last flush - called once per processor cycle
+	void FlushOutputLog();
 	void UpdateProcessingDiagnostics(int64 DequeueTimeMicros);
 
 	// Performance diagnostics access
 	FULMQueueDiagnostics GetQueueDiagnostics() const { return QueueDiagnostics; }
-	void ResetQueueDiagnostics() { QueueDiagnostics.Reset(); }
+	void ResetQueueDiagnostics();
+	
+	// Per-thread fairness - name and weight the calling thread's share of the queue under pressure
+	void RegisterProducerThread(const FString& Name, float Weight = FULMProducerRegistry::DEFAULT_WEIGHT, int32 BurstEntries = FULMProducerRegistry::DEFAULT_BURST_ENTRIES);
+	TArray<FULMProducerStats> GetProducerDiagnostics() const;
+	
+	// Adaptive batching state of the consumer threads
+	FULMBatchControllerStats GetProcessorBatchStats() const;
+	FULMBatchControllerStats GetFileWriterBatchStats() const;
+	FULMThreadParkerStats GetProcessorWaitStats() const;
+	FULMThreadParkerStats GetFileWriterWaitStats() const;
 	
 	// File I/O diagnostics access
 	FULMFileIODiagnostics GetFileIODiagnostics() const;
@@ -215,8 +498,23 @@ public:
 	
 	// Queue health check
 	int32 GetQueueSize() const;
+	int64 GetQueuedBytes() const { return QueuedBytes.load(std::memory_order_relaxed); }
+	int32 GetMaxQueueEntries() const { return MaxQueueEntries.load(std::memory_order_relaxed); }
+	int64 GetMaxQueueBytes() const { return MaxQueueBytes.load(std::memory_order_relaxed); }
 	bool IsQueueHealthy() const;
 	
+	// Queue bounds - the entry limit can't grow past the ring allocated at startup
+	void SetQueueLimits(int32 MaxEntries, int64 MaxBytes);
+	
+	// Upper bounds for the processor and file writer batch controllers - batches, waits and flushes adapt below them
+	void SetBatchingLimits(int32 MaxBatchSize, int32 MaxWaitMs, float MaxFlushIntervalSeconds);
+	
+	// How the processor and file writer threads wait for work
+	void SetWaitStrategies(EULMWaitStrategy ProcessorStrategy, EULMWaitStrategy FileWriterStrategy);
+	
+	// How long identical consecutive entries on a channel are folded into one summary - 0 disables collapsing
+	void SetRepeatCollapseWindow(float WindowSeconds);
+	
 	// Memory budget management
 	UFUNCTION(BlueprintCallable, Category = "ULM Memory")
 	void SetMemoryBudget(int64 BudgetBytes);
@@ -310,8 +608,11 @@ private:
 	// Channel registry for hierarchical management
 	TUniquePtr<FULMChannelRegistry> ChannelRegistry;
 
-	// Lock-free message queue for high-performance logging
-	TQueue<FULMLogQueueEntry, EQueueMode::Spsc> LogMessageQueue;
+	// Bounded lock-free MPSC ring - any thread may produce, the log processor is the only consumer
+	TULMMpscQueue<FULMLogQueueEntry> LogMessageQueue;
+	
+	// Small reserved lane for errors and criticals - drained ahead of LogMessageQueue and exempt from its limits
+	TULMMpscQueue<FULMLogQueueEntry> PriorityMessageQueue;
 	
 	// Consumer thread for processing queued log entries
 	FULMLogProcessor* LogProcessor;
@@ -319,13 +620,24 @@ private:
 	
 	// File I/O system for persistent logging
 	TQueue<FULMFileWriteEntry, EQueueMode::Spsc> FileWriteQueue;
+	
+	// Error and critical lines - written ahead of FileWriteQueue and flushed immediately
+	TQueue<FULMFileWriteEntry, EQueueMode::Spsc> PriorityFileWriteQueue;
 	FULMFileWriter* FileWriter;
 	FRunnableThread* FileWriterThread;
 	bool bFileLoggingEnabled;
 	
-	// Data structures for processed log storage (still needs protection for read access)
-	mutable FCriticalSection StorageCriticalSection;
-	TMap<FString, TArray<FULMLogEntry>> LogEntries;
+	// Processed log storage, one locked shard per channel indexed by EULMChannelId - only master list channels are
+	// stored, message text is chunk-allocated per channel
+	TStaticArray<FULMStorageShard, ULM_CHANNEL_COUNT> StorageShards;
+	
+	// Sequence of the newest stored entry - stamped under the owning shard's write lock
+	std::atomic<int64> LastStoredSequence{0};
+	
+	// Output Log lines waiting for the end of the processor cycle, and per-channel counters for sampled mirroring
+	// Only touched by the log processor thread (and Deinitialize once it has stopped)
+	TArray<FULMOutputLogLine> PendingOutputLog;
+	TStaticArray<uint32, ULM_CHANNEL_COUNT> OutputLogSampleCounters;
 	
 	// Performance diagnostics
 	FULMQueueDiagnostics QueueDiagnostics;
@@ -343,15 +655,63 @@ private:
 	TUniquePtr<FULMLogRotator> LogRotator;
 	TUniquePtr<FULMRetentionManager> RetentionManager;
 	
-	// Maximum queue size to prevent memory issues
-	static constexpr int32 MAX_QUEUE_SIZE = 10000;
+	// Logical queue bounds from settings; overflow policies decide what happens past them
+	std::atomic<int32> MaxQueueEntries{DEFAULT_MAX_QUEUE_SIZE};
+	std::atomic<int64> MaxQueueBytes{DEFAULT_MAX_QUEUE_BYTES};
+	std::atomic<int64> QueuedBytes{0};
+	
+	// Per-channel queued entry counts, evictions requested by drop-oldest producers, and pressure sampling counters
+	std::atomic<int32> QueuedPerChannel[ULM_CHANNEL_COUNT];
+	std::atomic<int32> PendingEvictions[ULM_CHANNEL_COUNT];
+	std::atomic<uint32> PressureSampleCounters[ULM_CHANNEL_COUNT];
+	
+	// Per-thread queue accounting and fairness quotas
+	TUniquePtr<FULMProducerRegistry> ProducerRegistry;
+	
+	// Defaults when settings are unavailable
+	static constexpr int32 DEFAULT_MAX_QUEUE_SIZE = 10000;
+	static constexpr int64 DEFAULT_MAX_QUEUE_BYTES = 8 * 1024 * 1024;
+	
+	// Reserved priority lane capacity
+	static constexpr int32 PRIORITY_QUEUE_SIZE = 1024;
+	
+	// Per-thread quotas engage once the normal lane is this full; below it any thread may burst freely
+	static constexpr float QUEUE_FAIRNESS_RATIO = 0.5f;
+	
+	// The game thread gets a larger share so gameplay logs keep flowing during a worker spam storm
+	static constexpr float GAME_THREAD_PRODUCER_WEIGHT = 4.0f;
+	
+	// File writer batch bound as a multiple of BatchProcessingSize
+	static constexpr int32 FILE_WRITER_BATCH_MULTIPLIER = 4;
+	
+	// Sampling starts past the soft limit; drop-oldest may overshoot up to the hard limit until its evictions are processed
+	static constexpr float QUEUE_SOFT_LIMIT_RATIO = 0.75f;
+	static constexpr float QUEUE_HARD_LIMIT_RATIO = 1.25f;
+	
+	// Blocked producers re-check for space at this interval
+	static constexpr float QUEUE_BLOCK_POLL_SECONDS = 0.0002f;
+	
+	// Output Log lines held before a mid-cycle flush
+	static constexpr int32 MAX_PENDING_OUTPUT_LOG_LINES = 256;
 	
 	// Internal helpers
+	void EnqueueLogEntry(FULMLogQueueEntry&& QueueEntry);
+	void StoreQueueEntry(const FULMLogQueueEntry& QueueEntry);
+	bool EnqueuePriorityEntry(FULMLogQueueEntry& QueueEntry);
+	bool AdmitToQueue(const FULMLogQueueEntry& QueueEntry, bool& bOutChargedEviction);
+	bool TryReserveQueueSpace(uint32 Bytes, float LimitRatio, int32 ProducerSlot);
+	bool IsQueueUnderPressure(float LimitRatio) const;
+	void ReleaseQueueSpace(const FULMLogQueueEntry& QueueEntry);
+	bool TryEvictQueuedEntry(EULMChannelId ChannelId, int32 ProducerSlot);
+	void RecordQueueDrop(EULMChannelId ChannelId, EULMOverflowPolicy Policy, int32 ProducerSlot);
 	void StoreProcessedLogEntry(const FULMLogEntry& Entry);
+	bool ShouldMirrorToOutputLog(EULMChannelId ChannelId, EULMVerbosity Verbosity);
+	void QueueOutputLogLine(FString&& Message, EULMChannelId ChannelId, EULMVerbosity Verbosity, uint32 CallsiteId);
 	
-	// Memory management helpers
+	// Memory management helpers - the per-channel ones expect the channel's shard to be write-locked
 	void TrimMemoryBudget();
-	void TrimChannelForMemory(const FString& ChannelName, int32 EntriesToRemove);
+	void TrimChannelForMemory(EULMChannelId ChannelId, int32 EntriesToRemove);
+	void ClearChannelStorage(EULMChannelId ChannelId);
 	
 	// File I/O helpers
 	FString FormatLogEntryForFile(const FULMLogEntry& Entry) const;
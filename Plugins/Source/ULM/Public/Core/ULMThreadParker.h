@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Event.h"
+#include <atomic>
+#include "ULMThreadParker.generated.h"
+
+/**
+ * How a ULM worker thread waits for work
+ */
+UENUM(BlueprintType)
+enum class EULMWaitStrategy : uint8
+{
+	Blocking	UMETA(DisplayName = "Blocking"),		// Park on the event straight away - lowest idle CPU
+	Hybrid		UMETA(DisplayName = "Hybrid"),			// Brief spin, then yield, then park
+	LowLatency	UMETA(DisplayName = "Low Latency")		// Long spin and yield phases - burns a core while busy to skip most park/wake round trips
+};
+
+/**
+ * Wakeup counters for one worker thread
+ */
+struct FULMThreadParkerStats
+{
+	EULMWaitStrategy Strategy = EULMWaitStrategy::Hybrid;
+
+	// Waits that found work while spinning, while yielding, or that parked on the event
+	int64 SpinWakeups = 0;
+	int64 YieldWakeups = 0;
+	int64 Parks = 0;
+
+	// Parks that ended on the timeout rather than a signal
+	int64 ParkTimeouts = 0;
+
+	// Producer notifications that had to trigger the event - the rest cost a single atomic load
+	int64 Signals = 0;
+
+	// Smoothed time from a signal to the parked thread running again
+	float AverageWakeupMicros = 0.0f;
+};
+
+/**
+ * Spin / yield / park wait for a single consumer thread
+ * The consumer spins and yields for a bounded time before parking on an event. Producers only trigger the
+ * event when the consumer has announced it is parked, so a busy consumer costs producers one atomic load
+ * instead of an event trigger per message.
+ */
+class ULM_API FULMThreadParker
+{
+public:
+	explicit FULMThreadParker(EULMWaitStrategy InStrategy = EULMWaitStrategy::Hybrid);
+	~FULMThreadParker();
+
+	FULMThreadParker(const FULMThreadParker&) = delete;
+	FULMThreadParker& operator=(const FULMThreadParker&) = delete;
+
+	void SetStrategy(EULMWaitStrategy NewStrategy) { Strategy.store(NewStrategy, std::memory_order_relaxed); }
+	EULMWaitStrategy GetStrategy() const { return Strategy.load(std::memory_order_relaxed); }
+
+	/**
+	 * Consumer side - returns once HasWork() is true, the parker is signalled, or TimeoutMs passes while parked
+	 * HasWork must observe the producers' enqueues; it is rechecked after the parked flag is published
+	 */
+	void Wait(TFunctionRef<bool()> HasWork, int32 TimeoutMs);
+
+	/** Producer side - call after publishing work; only wakes the consumer if it is parked */
+	void Notify();
+
+	/** Wake the consumer unconditionally - for stop requests */
+	void WakeUp();
+
+	FULMThreadParkerStats GetStats() const;
+
+private:
+	// Spin and yield budgets in microseconds per strategy
+	static constexpr double HYBRID_SPIN_MICROS = 20.0;
+	static constexpr double HYBRID_YIELD_MICROS = 200.0;
+	static constexpr double LOW_LATENCY_SPIN_MICROS = 200.0;
+	static constexpr double LOW_LATENCY_YIELD_MICROS = 2000.0;
+
+	// Pause cycles between HasWork checks while spinning
+	static constexpr uint64 SPIN_PAUSE_CYCLES = 64;
+
+	FEvent* Event;
+	std::atomic<EULMWaitStrategy> Strategy;
+	std::atomic<bool> bParked{false};
+
+	// Cycle stamp of the signal that woke the current park, for the wakeup latency average
+	std::atomic<uint64> SignalCycles{0};
+
+	std::atomic<int64> SpinWakeups{0};
+	std::atomic<int64> YieldWakeups{0};
+	std::atomic<int64> Parks{0};
+	std::atomic<int64> ParkTimeouts{0};
+	std::atomic<int64> Signals{0};
+	std::atomic<float> AverageWakeupMicros{0.0f};
+};
@@ -27,6 +27,9 @@ struct ULM_API FULMFileIODiagnostics
 	FThreadSafeCounter FailedWrites;
 	FThreadSafeCounter TotalBytesWritten;
 	FThreadSafeCounter TotalWriteTime;  // In microseconds
+	FThreadSafeCounter PriorityFlushCount;  // Immediate flushes for error/critical lines
+	FThreadSafeCounter PriorityLineCount;  // Error/critical lines written and flushed
+	FThreadSafeCounter FlushCount;  // Interval flushes that had unflushed data
 	
 	void Reset()
 	{
@@ -35,5 +38,8 @@ struct ULM_API FULMFileIODiagnostics
 		FailedWrites.Reset();
 		TotalBytesWritten.Reset();
 		TotalWriteTime.Reset();
+		PriorityFlushCount.Reset();
+		PriorityLineCount.Reset();
+		FlushCount.Reset();
 	}
 };
\ No newline at end of file
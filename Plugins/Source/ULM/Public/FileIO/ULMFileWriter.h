@@ -7,6 +7,8 @@
 #include "Containers/Queue.h"
 #include "Channels/ULMChannel.h"
 #include "FileIO/ULMFileTypes.h"
+#include "Core/ULMBatchController.h"
+#include "Core/ULMThreadParker.h"
 
 // Forward declaration
 struct FULMLogEntry;
@@ -15,12 +17,14 @@ class UULMSubsystem;
 
 /**
  * Asynchronous file writer with batch processing
- * Handles persistent log file writing with high performance
+ * Handles persistent log file writing with high performance - error and critical lines arrive on a separate
+ * queue that is drained first and flushed as soon as it is written. Batch size, idle wait and flush interval
+ * adapt to the write rate within the configured bounds.
  */
 class ULM_API FULMFileWriter : public FRunnable
 {
 public:
-	FULMFileWriter(UULMSubsystem* InOwner, TQueue<FULMFileWriteEntry, EQueueMode::Spsc>& InWriteQueue);
+	FULMFileWriter(UULMSubsystem* InOwner, TQueue<FULMFileWriteEntry, EQueueMode::Spsc>& InWriteQueue, TQueue<FULMFileWriteEntry, EQueueMode::Spsc>& InPriorityWriteQueue);
 	virtual ~FULMFileWriter();
 
 	// FRunnable interface
@@ -30,36 +34,58 @@ public:
 
 	// Control methods
 	void RequestStop();
-	void WakeUp();
 	
-	// Configuration
+	// Producer signals - only reach the event if the thread is parked
+	void WakeUp() { Parker.Notify(); }
+	
+	// Called by the producer after each enqueue - tracks queue depth for the batch controller and wakes the thread
+	void NotifyQueued();
+	
+	// Configuration - batch size, flush interval and wait are upper bounds for the adaptive controller
 	void SetBatchSize(int32 NewBatchSize);
 	void SetFlushInterval(float NewFlushIntervalSeconds);
+	void SetMaxWaitMs(int32 NewMaxWaitMs);
 	void SetBaseLogPath(const FString& NewBasePath);
+	void SetWaitStrategy(EULMWaitStrategy NewStrategy) { Parker.SetStrategy(NewStrategy); }
 	
 	// Diagnostics
 	FULMFileIODiagnostics GetDiagnostics() const { return Diagnostics; }
 	void ResetDiagnostics() { Diagnostics.Reset(); }
+	FULMBatchControllerStats GetBatchStats() const { return BatchController.GetStats(); }
+	FULMThreadParkerStats GetWaitStats() const { return Parker.GetStats(); }
+	float GetCurrentFlushInterval() const { return CurrentFlushIntervalSeconds.load(std::memory_order_relaxed); }
 
 private:
 	// Thread management
 	TAtomic<bool> bStopRequested;
-	FEvent* WakeUpEvent;
+	FULMThreadParker Parker;
 	
 	// Owner reference
 	UULMSubsystem* Owner;
 	
 	// File write queue
 	TQueue<FULMFileWriteEntry, EQueueMode::Spsc>& WriteQueue;
+	TQueue<FULMFileWriteEntry, EQueueMode::Spsc>& PriorityWriteQueue;
+	
+	// Entries in WriteQueue - TQueue has no size, so the producer and this thread keep count
+	std::atomic<int32> PendingWrites{0};
 	
 	// Batch processing
-	static constexpr int32 DEFAULT_BATCH_SIZE = 64;
+	static constexpr int32 MIN_BATCH_SIZE = 16;
 	static constexpr int32 MAX_BATCH_SIZE = 512;
-	int32 BatchSize;
+	static constexpr int32 MIN_WAIT_MS = 5;
+	static constexpr int32 DEFAULT_MAX_WAIT_MS = 100;
+	static constexpr float TARGET_BATCH_MS = 8.0f;
+	FULMBatchController BatchController;
 	
-	// Timing configuration
-	float FlushIntervalSeconds;
+	// Flushes come at MIN_FLUSH_INTERVAL while writes trickle in and stretch to the configured interval as the
+	// write rate approaches HIGH_WRITE_RATE, where per-flush cost matters more than a few seconds of tail
+	static constexpr float MIN_FLUSH_INTERVAL = 0.25f;
+	static constexpr double HIGH_WRITE_RATE = 1024.0 * 1024.0;
+	std::atomic<float> FlushIntervalSeconds;
+	std::atomic<float> CurrentFlushIntervalSeconds;
 	double LastFlushTime;
+	int64 BytesSinceFlush;
 	
 	// File management
 	FString BaseLogPath;
@@ -70,9 +96,10 @@ private:
 	FULMFileIODiagnostics Diagnostics;
 	
 	// Core processing methods
-	void ProcessWriteQueue();
-	void ProcessBatch(TArray<FULMFileWriteEntry>& Batch);
-	void WriteToFile(const FString& FilePath, const FString& Content);
+	int32 ProcessWriteQueue(int32 MaxEntries);
+	void ProcessPriorityQueue();
+	void ProcessBatch(TArray<FULMFileWriteEntry>& Batch, bool bFlushAfterWrite = false);
+	bool WriteToFile(const FString& FilePath, const FString& Content, bool bFlush = false);
 	void FlushAllFiles();
 	void CloseAllFiles();
 	
@@ -82,4 +109,5 @@ private:
 	// Utility methods
 	void UpdateWriteTimeDiagnostics(double StartTime, double EndTime);
 	bool ShouldFlush() const;
+	void UpdateFlushInterval(double ElapsedSeconds);
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Channels/ULMChannel.h"
+
+/**
+ * Static description of a single log macro expansion
+ * Built once on first use - source strings are parsed at registration, never per call
+ */
+struct ULM_API FULMCallsite
+{
+	/** Callsite ID carried by queue and log entries (0 = no callsite) */
+	uint32 Id = 0;
+
+	/** Channel the callsite was first registered with */
+	EULMChannelId ChannelId = EULMChannelId::Invalid;
+
+	int32 Line = 0;
+
+	/** Raw __FILE__ for FMsg::Logf so the Output Log stays clickable */
+	const char* SourceFile = nullptr;
+
+	/** Format literal, null for structured logs */
+	const TCHAR* Format = nullptr;
+
+	/** Source path trimmed via ToMinimalRiderPath */
+	FString File;
+
+	FString Function;
+	FString Class;
+};
+
+/**
+ * Append-only table of callsite descriptors
+ * Registration takes a lock once per callsite; lookups by ID are lock-free and safe from any thread
+ */
+class ULM_API FULMCallsiteRegistry
+{
+public:
+	/**
+	 * Register a callsite - never returns null, falls back to an anonymous descriptor (Id 0) if the table is full
+	 */
+	static const FULMCallsite* Register(const char* SourceFile, int32 Line, const char* Function, EULMChannelId ChannelId, const TCHAR* Format);
+
+	/**
+	 * Resolve a callsite ID - returns null for 0 or unknown IDs
+	 */
+	static const FULMCallsite* Find(uint32 CallsiteId);
+
+	/**
+	 * Number of registered callsites
+	 */
+	static int32 Num();
+};
+
+/**
+ * Callsite descriptor for the current macro expansion
+ * The lambda type is unique per expansion, so its function-local static registers exactly once per callsite.
+ * __FUNCTION__ is passed in because inside the lambda it would name the lambda's call operator. The channel is
+ * captured and only resolved by that first registration, never on later calls.
+ */
+#define ULM_CALLSITE(Channel, Format) \
+	[&](const char* InFunction, const TCHAR* InFormat) \
+	{ \
+		static const FULMCallsite* const Callsite = FULMCallsiteRegistry::Register(__FILE__, __LINE__, InFunction, ULMInternal::ResolveChannelId(Channel), InFormat); \
+		return Callsite; \
+	}(__FUNCTION__, Format)
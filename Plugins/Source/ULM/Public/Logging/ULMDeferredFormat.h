@@ -0,0 +1,270 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Tuple.h"
+#include <type_traits>
+
+/**
+ * Deferred formatting switch for ULM_LOG
+ * When enabled, ULM_LOG captures the format literal and a binary argument blob on the calling thread
+ * and FString::Printf-style formatting runs later on the log processor thread
+ */
+#ifndef ULM_DEFERRED_FORMATTING
+#define ULM_DEFERRED_FORMATTING 1
+#endif
+
+/**
+ * Type tag written in front of every captured argument
+ */
+enum class EULMDeferredArgType : uint8
+{
+	Signed,
+	Unsigned,
+	Floating,
+	Pointer,
+	WideString,
+	AnsiString
+};
+
+/**
+ * Formats a captured printf argument list - implemented with C varargs so a runtime format pointer can be used
+ */
+ULM_API void ULMFormatDeferredVarArgs(FString& OutMessage, const TCHAR* Format, ...);
+
+namespace ULMDeferredInternal
+{
+	// Writer/reader over the packed argument blob - numeric values are copied unaligned, strings are aligned to their char type
+	struct FArgWriter
+	{
+		TArray<uint64, TInlineAllocator<8>>& Words;
+		int32 NumBytes = 0;
+
+		explicit FArgWriter(TArray<uint64, TInlineAllocator<8>>& InWords)
+			: Words(InWords)
+		{}
+
+		uint8* Claim(int32 Bytes, int32 Alignment = 1)
+		{
+			const int32 Offset = Align(NumBytes, Alignment);
+			NumBytes = Offset + Bytes;
+
+			const int32 RequiredWords = (NumBytes + 7) / 8;
+			if (RequiredWords > Words.Num())
+			{
+				// Zeroed so alignment gaps and tail bytes never differ between equal argument lists
+				Words.SetNumZeroed(RequiredWords, EAllowShrinking::No);
+			}
+			return reinterpret_cast<uint8*>(Words.GetData()) + Offset;
+		}
+
+		template <typename T>
+		void WriteRaw(const T& Value)
+		{
+			FMemory::Memcpy(Claim(sizeof(T)), &Value, sizeof(T));
+		}
+	};
+
+	struct FArgReader
+	{
+		const uint8* Data;
+		int32 Offset = 0;
+
+		explicit FArgReader(const uint8* InData)
+			: Data(InData)
+		{}
+
+		const uint8* Consume(int32 Bytes, int32 Alignment = 1)
+		{
+			Offset = Align(Offset, Alignment);
+			const uint8* Result = Data + Offset;
+			Offset += Bytes;
+			return Result;
+		}
+
+		template <typename T>
+		T ReadRaw()
+		{
+			T Value;
+			FMemory::Memcpy(&Value, Consume(sizeof(T)), sizeof(T));
+			return Value;
+		}
+
+		void ExpectTag(EULMDeferredArgType Expected)
+		{
+			[[maybe_unused]] const EULMDeferredArgType Tag = ReadRaw<EULMDeferredArgType>();
+			checkSlow(Tag == Expected);
+		}
+	};
+
+	// Argument traits - anything not specialised here cannot be captured
+	template <typename T, typename = void>
+	struct TArg
+	{
+		static constexpr bool bSupported = false;
+	};
+
+	// Integers, floating point and enums are stored raw (enums as their underlying type)
+	template <typename T>
+	struct TArg<T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>>
+	{
+		static constexpr bool bSupported = true;
+
+		using StoredType = typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::common_type<T>>::type;
+		using DecodedType = StoredType;
+
+		static constexpr EULMDeferredArgType Tag =
+			std::is_floating_point_v<StoredType> ? EULMDeferredArgType::Floating :
+			std::is_signed_v<StoredType> ? EULMDeferredArgType::Signed : EULMDeferredArgType::Unsigned;
+
+		static void Write(FArgWriter& Writer, T Value)
+		{
+			Writer.WriteRaw(Tag);
+			Writer.WriteRaw(static_cast<StoredType>(Value));
+		}
+
+		static DecodedType Read(FArgReader& Reader)
+		{
+			Reader.ExpectTag(Tag);
+			return Reader.ReadRaw<StoredType>();
+		}
+	};
+
+	// String arguments are copied into the blob - the caller's buffer may be gone by the time we format
+	template <typename CharType, EULMDeferredArgType StringTag>
+	struct TStringArg
+	{
+		static constexpr bool bSupported = true;
+
+		using DecodedType = const CharType*;
+
+		static void Write(FArgWriter& Writer, const CharType* Value)
+		{
+			Writer.WriteRaw(StringTag);
+
+			// -1 marks a null pointer so the formatter still prints "(null)"
+			const int32 Len = Value ? TCString<CharType>::Strlen(Value) : -1;
+			Writer.WriteRaw(Len);
+			if (Value)
+			{
+				FMemory::Memcpy(Writer.Claim((Len + 1) * sizeof(CharType), alignof(CharType)), Value, (Len + 1) * sizeof(CharType));
+			}
+		}
+
+		static DecodedType Read(FArgReader& Reader)
+		{
+			Reader.ExpectTag(StringTag);
+			const int32 Len = Reader.ReadRaw<int32>();
+			if (Len < 0)
+			{
+				return nullptr;
+			}
+			return reinterpret_cast<const CharType*>(Reader.Consume((Len + 1) * sizeof(CharType), alignof(CharType)));
+		}
+	};
+
+	template <> struct TArg<const TCHAR*> : TStringArg<TCHAR, EULMDeferredArgType::WideString> {};
+	template <> struct TArg<TCHAR*> : TStringArg<TCHAR, EULMDeferredArgType::WideString> {};
+	template <> struct TArg<const ANSICHAR*> : TStringArg<ANSICHAR, EULMDeferredArgType::AnsiString> {};
+	template <> struct TArg<ANSICHAR*> : TStringArg<ANSICHAR, EULMDeferredArgType::AnsiString> {};
+
+	// Any other pointer is only ever printed with %p - store the address
+	template <typename T>
+	struct TArg<T*, std::enable_if_t<!std::is_same_v<std::remove_cv_t<T>, TCHAR> && !std::is_same_v<std::remove_cv_t<T>, ANSICHAR>>>
+	{
+		static constexpr bool bSupported = true;
+
+		using DecodedType = const void*;
+
+		static void Write(FArgWriter& Writer, T* Value)
+		{
+			Writer.WriteRaw(EULMDeferredArgType::Pointer);
+			Writer.WriteRaw(static_cast<const void*>(Value));
+		}
+
+		static DecodedType Read(FArgReader& Reader)
+		{
+			Reader.ExpectTag(EULMDeferredArgType::Pointer);
+			return Reader.ReadRaw<const void*>();
+		}
+	};
+
+	template <typename T>
+	using TArgFor = TArg<std::decay_t<T>>;
+}
+
+/**
+ * A log message whose formatting has been deferred
+ * Holds the static format literal, a compact type-tagged argument blob and the formatter instantiated for the
+ * argument types at the call site. Typical numeric log lines fit in the inline storage and never touch the heap.
+ */
+struct ULM_API FULMDeferredMessage
+{
+	using FFormatterFn = void (*)(const TCHAR* Format, const uint8* Data, FString& OutMessage);
+
+	static constexpr int32 INLINE_ARG_WORDS = 8;
+
+	FULMDeferredMessage() = default;
+
+	/**
+	 * Capture a format literal and its arguments - the format must be a string literal so the pointer outlives the queue
+	 */
+	template <int32 N, typename... ArgTypes>
+	static FULMDeferredMessage Capture(const TCHAR (&InFormat)[N], ArgTypes&&... Args)
+	{
+		static_assert((ULMDeferredInternal::TArgFor<ArgTypes>::bSupported && ...), "Unsupported argument passed to a deferred ULM log - use *FString for strings");
+
+		FULMDeferredMessage Result;
+		Result.FormatString = InFormat;
+		Result.Formatter = &FormatCaptured<std::decay_t<ArgTypes>...>;
+
+		ULMDeferredInternal::FArgWriter Writer(Result.ArgWords);
+		(ULMDeferredInternal::TArgFor<ArgTypes>::Write(Writer, Args), ...);
+		return Result;
+	}
+
+	/** True if this holds a captured message that still needs formatting */
+	bool IsSet() const
+	{
+		return FormatString != nullptr;
+	}
+
+	/** Run the deferred Printf - called on the log processor thread */
+	FString Format() const
+	{
+		FString Result;
+		if (IsSet())
+		{
+			Formatter(FormatString, reinterpret_cast<const uint8*>(ArgWords.GetData()), Result);
+		}
+		return Result;
+	}
+
+	/** Identity of the format and captured arguments - equal messages hash equal without being formatted */
+	uint64 GetHash() const;
+
+	/** Heap bytes held by the argument blob - zero while it fits the inline words */
+	SIZE_T GetHeapBytes() const
+	{
+		return ArgWords.Num() > INLINE_ARG_WORDS ? static_cast<SIZE_T>(ArgWords.Max()) * sizeof(uint64) : 0;
+	}
+
+private:
+	template <typename... ArgTypes>
+	static void FormatCaptured(const TCHAR* InFormat, const uint8* Data, FString& OutMessage)
+	{
+		ULMDeferredInternal::FArgReader Reader(Data);
+
+		// Braced initialisation guarantees the arguments are read back in order
+		TTuple<typename ULMDeferredInternal::TArg<ArgTypes>::DecodedType...> Decoded{ ULMDeferredInternal::TArg<ArgTypes>::Read(Reader)... };
+		Decoded.ApplyAfter([&OutMessage, InFormat](auto... Values)
+		{
+			ULMFormatDeferredVarArgs(OutMessage, InFormat, Values...);
+		});
+	}
+
+	const TCHAR* FormatString = nullptr;
+	FFormatterFn Formatter = nullptr;
+
+	// Word storage keeps string payloads aligned wherever the entry is moved to
+	TArray<uint64, TInlineAllocator<INLINE_ARG_WORDS>> ArgWords;
+};
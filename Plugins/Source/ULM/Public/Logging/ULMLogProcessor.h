@@ -2,8 +2,11 @@
 
 #include "CoreMinimal.h"
 #include "HAL/Runnable.h"
-#include "HAL/Event.h"
-#include "Containers/Queue.h"
+#include "Channels/ULMChannel.h"
+#include "Logging/ULMLogQueue.h"
+#include "Core/ULMBatchController.h"
+#include "Core/ULMThreadParker.h"
+#include <atomic>
 
 // Forward declarations
 class UULMSubsystem;
@@ -11,12 +14,14 @@ struct FULMLogQueueEntry;
 
 /**
  * Background thread processor for ULM log entries
- * Consumes entries from the lock-free queue and processes them
+ * Consumes entries from the lock-free queues and processes them - the priority lane (errors and criticals)
+ * is always checked before the normal lane. Consecutive identical entries on a channel are folded into a
+ * "previous message repeated" summary, compared by content hash so no copy is ever formatted.
  */
 class FULMLogProcessor : public FRunnable
 {
 public:
-	FULMLogProcessor(UULMSubsystem* InSubsystem, TQueue<FULMLogQueueEntry, EQueueMode::Spsc>& InQueue);
+	FULMLogProcessor(UULMSubsystem* InSubsystem, TULMMpscQueue<FULMLogQueueEntry>& InQueue, TULMMpscQueue<FULMLogQueueEntry>& InPriorityQueue);
 	virtual ~FULMLogProcessor();
 
 	// FRunnable interface
@@ -26,19 +31,62 @@ public:
 
 	// Control methods
 	void RequestStop();
-	void WakeUp();
+	
+	// Called by producers after each enqueue - only signals the thread if it is parked
+	void WakeUp() { Parker.Notify(); }
+	
+	void SetWaitStrategy(EULMWaitStrategy NewStrategy) { Parker.SetStrategy(NewStrategy); }
+	FULMThreadParkerStats GetWaitStats() const { return Parker.GetStats(); }
+	
+	// Upper bounds for the adaptive batch size and idle wait (UULMSettings::BatchProcessingSize / ThreadSleepTimeMs)
+	void SetBatchingLimits(int32 MaxBatchSize, int32 MaxWaitMs);
+	FULMBatchControllerStats GetBatchStats() const { return BatchController.GetStats(); }
+	
+	// Identical entries within this many seconds of a run's first occurrence are collapsed - 0 disables
+	void SetRepeatCollapseWindow(float WindowSeconds);
 
 private:
 	UULMSubsystem* Subsystem;
-	TQueue<FULMLogQueueEntry, EQueueMode::Spsc>& MessageQueue;
-	FEvent* WakeUpEvent;
+	TULMMpscQueue<FULMLogQueueEntry>& MessageQueue;
+	TULMMpscQueue<FULMLogQueueEntry>& PriorityQueue;
+	FULMThreadParker Parker;
 	bool bStopRequested;
 	
-	// Processing batch size for efficiency
-	static constexpr int32 BATCH_SIZE = 64;
+	// Batch size and idle wait adapt to queue depth and arrival rate within these defaults until settings are applied
+	static constexpr int32 MIN_BATCH_SIZE = 8;
+	static constexpr int32 DEFAULT_MAX_BATCH_SIZE = 64;
+	static constexpr int32 MIN_WAIT_MS = 1;
+	static constexpr int32 DEFAULT_MAX_WAIT_MS = 100;
+	
+	// A batch taking longer than this delays the Output Log flush and priority checks - shrink it
+	static constexpr float TARGET_BATCH_MS = 2.0f;
+	
+	FULMBatchController BatchController;
+	
+	// Current run of identical entries on one channel - only touched by the processor thread
+	struct FRepeatRun
+	{
+		uint64 ContentHash = 0;
+		uint32 CallsiteId = 0;
+		EULMVerbosity Verbosity = EULMVerbosity::Message;
+		int32 LastThreadId = 0;
+		uint64 FirstCycles = 0;
+		uint64 LastCycles = 0;
+		
+		// Copies folded after the first occurrence
+		int32 Repeats = 0;
+		bool bActive = false;
+	};
+	
+	FRepeatRun RepeatRuns[ULM_CHANNEL_COUNT];
+	std::atomic<uint64> RepeatWindowCycles{0};
+	
+	int32 ProcessBatch(int32 MaxEntries);
 	
-	// Sleep time when queue is empty (milliseconds)
-	static constexpr int32 SLEEP_TIME_MS = 1;
+	// True if the entry repeats its channel's current run and was folded into it
+	bool TryCollapseRepeat(const FULMLogQueueEntry& Entry);
 	
-	void ProcessBatch();
+	// Store the run's summary if it folded anything - runs past their window, or all of them when bForce
+	void FlushRepeatRuns(bool bForce);
+	void EmitRepeatSummary(EULMChannelId ChannelId, FRepeatRun& Run);
 };
\ No newline at end of file
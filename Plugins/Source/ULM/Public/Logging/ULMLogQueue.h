@@ -0,0 +1,164 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+/**
+ * Bounded multi-producer single-consumer ring queue
+ *
+ * Producers on any thread claim a slot with a CAS on the enqueue cursor and publish it through a
+ * per-slot sequence number; the single consumer (FULMLogProcessor) reads slots in order without CAS.
+ * Slots are preallocated once in Initialize, so steady-state enqueue/dequeue never allocates nodes.
+ */
+template <typename ElementType>
+class TULMMpscQueue
+{
+public:
+	TULMMpscQueue()
+		: Capacity(0)
+		, IndexMask(0)
+		, EnqueueCursor(0)
+		, DequeueCursor(0)
+		, Occupancy(0)
+	{}
+
+	TULMMpscQueue(const TULMMpscQueue&) = delete;
+	TULMMpscQueue& operator=(const TULMMpscQueue&) = delete;
+
+	/**
+	 * Allocate the slot ring - capacity is rounded up to a power of two
+	 * Must be called before any producer or consumer touches the queue
+	 */
+	void Initialize(int32 InCapacity)
+	{
+		Capacity = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(InCapacity, 2)));
+		IndexMask = Capacity - 1;
+
+		Slots = MakeUnique<FSlot[]>(Capacity);
+		for (uint32 Index = 0; Index < Capacity; ++Index)
+		{
+			Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+		}
+
+		EnqueueCursor.store(0, std::memory_order_relaxed);
+		DequeueCursor.store(0, std::memory_order_relaxed);
+		Occupancy.store(0, std::memory_order_release);
+	}
+
+	/**
+	 * Enqueue from any thread - returns false if the ring is full or not initialized
+	 */
+	bool Enqueue(ElementType&& Item)
+	{
+		if (!Slots)
+		{
+			return false;
+		}
+
+		FSlot* Slot = nullptr;
+		uint64 Position = EnqueueCursor.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			Slot = &Slots[Position & IndexMask];
+			const uint64 Sequence = Slot->Sequence.load(std::memory_order_acquire);
+			const int64 Difference = static_cast<int64>(Sequence) - static_cast<int64>(Position);
+
+			if (Difference == 0)
+			{
+				// Slot is free for this lap - try to claim it
+				if (EnqueueCursor.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (Difference < 0)
+			{
+				// Consumer has not released this slot yet - ring is full
+				return false;
+			}
+			else
+			{
+				Position = EnqueueCursor.load(std::memory_order_relaxed);
+			}
+		}
+
+		Slot->Value = MoveTemp(Item);
+		Slot->Sequence.store(Position + 1, std::memory_order_release);
+		Occupancy.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool Enqueue(const ElementType& Item)
+	{
+		ElementType Copy(Item);
+		return Enqueue(MoveTemp(Copy));
+	}
+
+	/**
+	 * Dequeue on the single consumer thread - returns false if no published entry is available
+	 */
+	bool Dequeue(ElementType& OutItem)
+	{
+		if (!Slots)
+		{
+			return false;
+		}
+
+		const uint64 Position = DequeueCursor.load(std::memory_order_relaxed);
+		FSlot& Slot = Slots[Position & IndexMask];
+		const uint64 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+
+		if (static_cast<int64>(Sequence) - static_cast<int64>(Position + 1) < 0)
+		{
+			return false;
+		}
+
+		OutItem = MoveTemp(Slot.Value);
+
+		// Release the slot for the producers' next lap around the ring
+		Slot.Sequence.store(Position + Capacity, std::memory_order_release);
+		DequeueCursor.store(Position + 1, std::memory_order_relaxed);
+		Occupancy.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool IsEmpty() const
+	{
+		return Num() == 0;
+	}
+
+	/**
+	 * Exact number of published, not yet consumed entries
+	 */
+	int32 Num() const
+	{
+		return FMath::Max(0, Occupancy.load(std::memory_order_relaxed));
+	}
+
+	int32 GetCapacity() const
+	{
+		return static_cast<int32>(Capacity);
+	}
+
+private:
+	struct FSlot
+	{
+		std::atomic<uint64> Sequence{0};
+		ElementType Value;
+	};
+
+	TUniquePtr<FSlot[]> Slots;
+	uint32 Capacity;
+	uint64 IndexMask;
+
+	// Producer and consumer cursors are padded onto separate cache lines to avoid false sharing
+	// (padding rather than alignas so the queue can live inside UObjects)
+	uint8 PadBeforeEnqueue[PLATFORM_CACHE_LINE_SIZE];
+	std::atomic<uint64> EnqueueCursor;
+	uint8 PadBeforeDequeue[PLATFORM_CACHE_LINE_SIZE - sizeof(std::atomic<uint64>)];
+	std::atomic<uint64> DequeueCursor;
+	uint8 PadBeforeOccupancy[PLATFORM_CACHE_LINE_SIZE - sizeof(std::atomic<uint64>)];
+	std::atomic<int32> Occupancy;
+	uint8 PadAfterOccupancy[PLATFORM_CACHE_LINE_SIZE - sizeof(std::atomic<int32>)];
+};
@@ -8,7 +8,13 @@
 #include "UObject/Object.h"
 #include "Misc/Paths.h"
 #include "FileIO/ULMInternalPath.h"
+#include "Logging/ULMDeferredFormat.h"
+#include "Logging/ULMStructuredFields.h"
+#include "Logging/ULMCallsite.h"
+#include "Logging/ULMThrottle.h"
+#include "Logging/ULMSampler.h"
 #include <atomic>
+#include <type_traits>
 
 // Forward declarations for performance
 class UULMSubsystem;
@@ -24,64 +30,41 @@ extern ULM_API std::atomic<UULMSubsystem*> GULMSubsystem;
  */
 
 /**
- * Fast channel state lookup with caching
+ * Fast channel gate lookup by compile-time channel ID
  */
 namespace ULMInternal
 {
-	// Thread-safe channel state cache using values instead of pointers
-	struct FCachedChannelState
+	// Channel resolution - IDs pass straight through, names are resolved against the master list
+	FORCEINLINE constexpr EULMChannelId ResolveChannelId(EULMChannelId ChannelId)
 	{
-		bool bEnabled;
-		EULMVerbosity MinVerbosity;
-		int32 MaxLogEntries;
-		bool bIsValid;
-		
-		FCachedChannelState() : bEnabled(false), MinVerbosity(EULMVerbosity::Message), MaxLogEntries(1000), bIsValid(false) {}
-		FCachedChannelState(const FULMChannelState& State) 
-			: bEnabled(State.bEffectiveEnabled), MinVerbosity(State.EffectiveMinVerbosity), MaxLogEntries(State.EffectiveMaxEntries), bIsValid(true) {}
-	};
-	
-	thread_local static TMap<FString, FCachedChannelState> ChannelStateCache;
-	thread_local static double LastCacheFlush = 0.0;
-	thread_local static FULMChannelRegistry* LastRegistryPtr = nullptr;
+		return ChannelId;
+	}
 	
-	inline bool GetCachedChannelState(const FString& ChannelName, FCachedChannelState& OutState)
+	inline EULMChannelId ResolveChannelId(const TCHAR* ChannelName)
 	{
-		const double CurrentTime = FPlatformTime::Seconds();
-		FULMChannelRegistry* Registry = GULMChannelRegistry.load(std::memory_order_acquire);
-		
-		// Invalidate cache if registry changed or time expired
-		if (Registry != LastRegistryPtr || CurrentTime - LastCacheFlush > 5.0)
-		{
-			ChannelStateCache.Empty();
-			LastCacheFlush = CurrentTime;
-			LastRegistryPtr = Registry;
-		}
-		
-		if (!Registry)
+		// "Default" is the legacy fallback channel name and maps onto the ULM master channel
+		if (ChannelName && FCString::Stricmp(ChannelName, TEXT("Default")) == 0)
 		{
-			return false;
+			return EULMChannelId::ULM;
 		}
-		
-		if (FCachedChannelState* CachedState = ChannelStateCache.Find(ChannelName))
-		{
-			OutState = *CachedState;
-			return CachedState->bIsValid;
-		}
-		
-		// Get fresh state and cache the VALUES, not the pointer
-		const FULMChannelState* State = Registry->GetChannelState(ChannelName);
-		if (State)
-		{
-			FCachedChannelState NewCachedState(*State);
-			ChannelStateCache.Emplace(ChannelName, NewCachedState);
-			OutState = NewCachedState;
-			return true;
-		}
-		
-		// Cache invalid state to avoid repeated lookups
-		ChannelStateCache.Emplace(ChannelName, FCachedChannelState());
-		return false;
+		return ULMChannelIdFromName(ChannelName);
+	}
+	
+	inline EULMChannelId ResolveChannelId(const FString& ChannelName)
+	{
+		return ResolveChannelId(*ChannelName);
+	}
+	
+	// String literal channel names can be resolved once per callsite instead of on every call
+	template <typename T> struct TIsChannelNameLiteral : std::false_type {};
+	template <SIZE_T N> struct TIsChannelNameLiteral<TCHAR[N]> : std::true_type {};
+	
+	// Single relaxed load of the channel's packed enabled/verbosity word
+	template <typename ChannelType>
+	FORCEINLINE bool IsChannelOpen(const ChannelType& Channel, EULMVerbosity Verbosity)
+	{
+		const EULMChannelId ChannelId = ResolveChannelId(Channel);
+		return ULMIsValidChannelId(ChannelId) && GULMChannelGates[static_cast<int32>(ChannelId)].IsOpen(Verbosity);
 	}
 	
 	// Parameter validation helpers
@@ -90,6 +73,11 @@ namespace ULMInternal
 		return !ChannelName.IsEmpty() && ChannelName.Len() <= 64; // Reasonable channel name limit
 	}
 	
+	FORCEINLINE constexpr bool IsValidChannel(EULMChannelId ChannelId)
+	{
+		return ULMIsValidChannelId(ChannelId);
+	}
+	
 	inline bool IsValidVerbosity(EULMVerbosity Verbosity)
 	{
 		return Verbosity >= EULMVerbosity::Message && Verbosity <= EULMVerbosity::Critical;
@@ -166,144 +154,268 @@ namespace ULMInternal
 		}
 		return TEXT("Unknown");
 	}
-	
-	// Sampling state for rate-limited logging
-	struct FSamplingState
-	{
-		double LastLogTime = 0.0;
-		uint32 MessageCount = 0;
-		uint32 SampleRate = 100; // Log every 100th message by default
-	};
-	
-	thread_local static TMap<FString, FSamplingState> SamplingStates;
-	
-	inline bool ShouldSample(const FString& ChannelName, uint32 CustomSampleRate = 0)
-	{
-		FSamplingState& State = SamplingStates.FindOrAdd(ChannelName);
-		
-		if (CustomSampleRate > 0)
-		{
-			State.SampleRate = CustomSampleRate;
-		}
-		
-		State.MessageCount++;
-		
-		if (State.MessageCount >= State.SampleRate)
-		{
-			State.MessageCount = 0;
-			State.LastLogTime = FPlatformTime::Seconds();
-			return true;
-		}
-		
-		return false;
-	}
 }
 
 /**
  * Core logging function - optimized for performance
+ * The channel ID overloads are the fast path; name overloads resolve against the master list first
+ * CallsiteId links the entry to its static FULMCallsite descriptor (0 when logged outside the macros)
+ */
+ULM_API void ULMLogMessage(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext = nullptr, const char* FileName = nullptr, int32 LineNumber = 0, uint32 CallsiteId = 0);
+ULM_API void ULMLogMessage(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext = nullptr, const char* FileName = nullptr, int32 LineNumber = 0, uint32 CallsiteId = 0);
+
+/**
+ * Deferred logging - the message is formatted and forwarded to the Output Log on the log processor thread
  */
-ULM_API void ULMLogMessage(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext = nullptr, const char* FileName = nullptr, int32 LineNumber = 0);
+ULM_API void ULMLogMessageDeferred(EULMChannelId ChannelId, EULMVerbosity Verbosity, FULMDeferredMessage&& Message, uint32 CallsiteId = 0);
+
+/**
+ * Split admission for callers that must know the outcome before committing their own state (the throttle macros)
+ * ULMAdmit makes the one admission decision; the ULMLogAdmitted overloads submit under that ticket without
+ * re-checking. Before initialization the ticket is a bypass and submission falls back to the Output Log.
+ */
+ULM_API FULMAdmissionTicket ULMAdmit(EULMChannelId ChannelId, EULMVerbosity Verbosity);
+ULM_API void ULMLogAdmitted(const FULMAdmissionTicket& Ticket, const FString& Message, uint32 CallsiteId = 0);
+ULM_API void ULMLogAdmitted(const FULMAdmissionTicket& Ticket, FULMDeferredMessage&& Message, uint32 CallsiteId = 0);
+
+/**
+ * Structured logging - typed fields travel through the queue in binary; Lead (usually the function name) prefixes
+ * the rendered "key=value" text and the fields are written to JSON as a nested object
+ */
+ULM_API void ULMLogMessageStructured(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Lead, FULMStructuredFields&& Fields, uint32 CallsiteId = 0);
+
+/**
+ * An Output Log line collected by the log processor - file and line come from the callsite descriptor
+ */
+struct FULMOutputLogLine
+{
+	FString Message;
+	EULMChannelId ChannelId = EULMChannelId::Invalid;
+	EULMVerbosity Verbosity = EULMVerbosity::Message;
+	uint32 CallsiteId = 0;
+};
+
+/**
+ * Batched Output Log forwarding used by the log processor - each line is formatted once into a shared buffer
+ * that serves both the channel category and the ULM master duplicate. Consumes the lines.
+ */
+ULM_API void ULMForwardToOutputLogBatch(TArray<FULMOutputLogLine>& Lines);
 
 /**
  * Critical system logging function - bypasses initialization checks for early system logs
  */
-ULM_API void ULMLogCriticalSystem(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const char* FileName = nullptr, int32 LineNumber = 0);
+ULM_API void ULMLogCriticalSystem(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Message, const char* FileName = nullptr, int32 LineNumber = 0, uint32 CallsiteId = 0);
+ULM_API void ULMLogCriticalSystem(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const char* FileName = nullptr, int32 LineNumber = 0, uint32 CallsiteId = 0);
 
 /**
  * Network-aware logging functions
  */
-ULM_API void ULMLogMessageServer(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName = nullptr, int32 LineNumber = 0);
-ULM_API void ULMLogMessageClient(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName = nullptr, int32 LineNumber = 0);
+ULM_API void ULMLogMessageServer(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName = nullptr, int32 LineNumber = 0, uint32 CallsiteId = 0);
+ULM_API void ULMLogMessageServer(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName = nullptr, int32 LineNumber = 0, uint32 CallsiteId = 0);
+ULM_API void ULMLogMessageClient(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName = nullptr, int32 LineNumber = 0, uint32 CallsiteId = 0);
+ULM_API void ULMLogMessageClient(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, const UObject* WorldContext, const char* FileName = nullptr, int32 LineNumber = 0, uint32 CallsiteId = 0);
 
 /**
  * Sampled logging for high-frequency messages
+ * The decision comes from ULMSampling - kept entries are written with its weight, reservoir samples are held
+ * until their window closes. The name overload samples with the channel's settings, or every SampleRate-th call.
  */
-ULM_API void ULMLogMessageSampled(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, uint32 SampleRate = 100, const UObject* WorldContext = nullptr, const char* FileName = nullptr, int32 LineNumber = 0);
+ULM_API void ULMLogMessageSampled(EULMChannelId ChannelId, EULMVerbosity Verbosity, const FString& Message, const FULMSampleDecision& Decision, uint32 CallsiteId = 0);
+ULM_API void ULMLogMessageSampled(const FString& ChannelName, EULMVerbosity Verbosity, const FString& Message, uint32 SampleRate = 0, const UObject* WorldContext = nullptr, const char* FileName = nullptr, int32 LineNumber = 0, uint32 CallsiteId = 0);
+
 
+/**
+ * Channel ID for one macro expansion - evaluated once per call into a local
+ * IDs pass straight through; a string literal is resolved on the first call and cached in a function-local
+ * static (the lambda type is unique per expansion); any other name is resolved on every call.
+ */
+#define ULM_RESOLVE_CHANNEL(Channel) \
+	[](const auto& InChannel) -> EULMChannelId \
+	{ \
+		if constexpr (ULMInternal::TIsChannelNameLiteral<std::remove_cv_t<std::remove_reference_t<decltype(InChannel)>>>::value) \
+		{ \
+			static const EULMChannelId CachedChannelId = ULMInternal::ResolveChannelId(InChannel); \
+			return CachedChannelId; \
+		} \
+		else \
+		{ \
+			return ULMInternal::ResolveChannelId(InChannel); \
+		} \
+	}(Channel)
 
 // Core logging macros with compile-time optimizations
 // Critical system logging - bypasses channel state checks for early initialization logging
 #define ULM_LOG_CRITICAL_SYSTEM(Channel, Verbosity, Format, ...) \
 	do { \
+		const FULMCallsite* ULMCallsite = ULM_CALLSITE(Channel, Format); \
 		const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
-		ULMLogCriticalSystem(Channel, Verbosity, Msg, __FILE__, __LINE__); \
+		ULMLogCriticalSystem(Channel, Verbosity, Msg, __FILE__, __LINE__, ULMCallsite->Id); \
 	} while(0)
 
-#define ULM_LOG(Channel, Verbosity, Format, ...) \
+#define ULM_LOG_IMMEDIATE(Channel, Verbosity, Format, ...) \
 	do { \
-		if (ULMInternal::IsValidChannel(Channel) && ULMInternal::IsValidVerbosity(Verbosity) && ULMInternal::IsValidFormat(Format)) \
+		/* Gate first - a closed channel costs one relaxed load, validation only runs for open channels */ \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity) && ULMInternal::IsValidVerbosity(Verbosity) && ULMInternal::IsValidFormat(Format)) \
 		{ \
-			ULMInternal::FCachedChannelState CachedState; \
-			if (ULMInternal::GetCachedChannelState(Channel, CachedState) && CachedState.bEnabled && Verbosity >= CachedState.MinVerbosity) \
-			{ \
-				const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
-				ULMLogMessage(Channel, Verbosity, Msg, nullptr, __FILE__, __LINE__); \
-			} \
+			const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
+			const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
+			ULMLogMessage(ULMChannelId, Verbosity, Msg, nullptr, __FILE__, __LINE__, ULMCallsite->Id); \
 		} \
 	} while(0)
 
+// Deferred logging - copies the format literal and a binary argument blob, Printf runs on the processor thread
+#define ULM_LOG_DEFERRED(Channel, Verbosity, Format, ...) \
+	do { \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity) && ULMInternal::IsValidVerbosity(Verbosity) && ULMInternal::IsValidFormat(Format)) \
+		{ \
+			const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
+			ULMLogMessageDeferred(ULMChannelId, Verbosity, FULMDeferredMessage::Capture(Format, ##__VA_ARGS__), ULMCallsite->Id); \
+		} \
+	} while(0)
+
+#if ULM_DEFERRED_FORMATTING
+#define ULM_LOG(Channel, Verbosity, Format, ...) ULM_LOG_DEFERRED(Channel, Verbosity, Format, ##__VA_ARGS__)
+#define ULM_SUBMIT_ADMITTED(Ticket, CallsiteId, Format, ...) ULMLogAdmitted(Ticket, FULMDeferredMessage::Capture(Format, ##__VA_ARGS__), CallsiteId)
+#else
+#define ULM_LOG(Channel, Verbosity, Format, ...) ULM_LOG_IMMEDIATE(Channel, Verbosity, Format, ##__VA_ARGS__)
+#define ULM_SUBMIT_ADMITTED(Ticket, CallsiteId, Format, ...) ULMLogAdmitted(Ticket, FString::Printf(Format, ##__VA_ARGS__), CallsiteId)
+#endif
+
 #define ULM_LOG_SERVER(Channel, Verbosity, Format, ...) \
 	do { \
-		if (ULMInternal::IsValidChannel(Channel) && ULMInternal::IsValidVerbosity(Verbosity) && ULMInternal::IsValidFormat(Format)) \
+		/* Gate first - a closed channel costs one relaxed load, validation only runs for open channels */ \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity) && ULMInternal::IsValidVerbosity(Verbosity) && ULMInternal::IsValidFormat(Format)) \
 		{ \
-			ULMInternal::FCachedChannelState CachedState; \
-			if (ULMInternal::GetCachedChannelState(Channel, CachedState) && CachedState.bEnabled && Verbosity >= CachedState.MinVerbosity) \
-			{ \
-				const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
-				ULMLogMessageServer(Channel, Verbosity, Msg, Cast<UObject>(this), __FILE__, __LINE__); \
-			} \
+			const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
+			const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
+			ULMLogMessageServer(ULMChannelId, Verbosity, Msg, Cast<UObject>(this), __FILE__, __LINE__, ULMCallsite->Id); \
 		} \
 	} while(0)
 
 #define ULM_LOG_CLIENT(Channel, Verbosity, Format, ...) \
 	do { \
-		ULMInternal::FCachedChannelState CachedState; \
-		if (ULMInternal::GetCachedChannelState(Channel, CachedState) && CachedState.bEnabled && Verbosity >= CachedState.MinVerbosity) \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity)) \
 		{ \
+			const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
 			const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
-			ULMLogMessageClient(Channel, Verbosity, Msg, Cast<UObject>(this), __FILE__, __LINE__); \
+			ULMLogMessageClient(ULMChannelId, Verbosity, Msg, Cast<UObject>(this), __FILE__, __LINE__, ULMCallsite->Id); \
 		} \
 	} while(0)
 
+// Sampled with the channel's sampling mode - dropped calls are never formatted
 #define ULM_LOG_SAMPLED(Channel, Verbosity, Format, ...) \
 	do { \
-		ULMInternal::FCachedChannelState CachedState; \
-		if (ULMInternal::GetCachedChannelState(Channel, CachedState) && CachedState.bEnabled && Verbosity >= CachedState.MinVerbosity && ULMInternal::ShouldSample(Channel)) \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity)) \
 		{ \
-			const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
-			ULMLogMessage(Channel, Verbosity, Msg, nullptr, __FILE__, __LINE__); \
+			const FULMSampleDecision ULMSample = ULMSampling::Sample(ULMChannelId); \
+			if (ULMSample) \
+			{ \
+				const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
+				ULMLogMessageSampled(ULMChannelId, Verbosity, FString::Printf(Format, ##__VA_ARGS__), ULMSample, ULMCallsite->Id); \
+			} \
 		} \
 	} while(0)
 
+// Every Rate-th call of this line, whatever the channel's mode
 #define ULM_LOG_SAMPLED_RATE(Channel, Verbosity, Rate, Format, ...) \
 	do { \
-		ULMInternal::FCachedChannelState CachedState; \
-		if (ULMInternal::GetCachedChannelState(Channel, CachedState) && CachedState.bEnabled && Verbosity >= CachedState.MinVerbosity && ULMInternal::ShouldSample(Channel, Rate)) \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		static ULMThrottle::FEveryN ULMThrottleState; \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity) && ULMThrottleState.TryPass(Rate)) \
 		{ \
-			const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
-			ULMLogMessage(Channel, Verbosity, Msg, nullptr, __FILE__, __LINE__); \
+			const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
+			ULMLogMessageSampled(ULMChannelId, Verbosity, FString::Printf(Format, ##__VA_ARGS__), FULMSampleDecision::Keep(static_cast<float>(Rate)), ULMCallsite->Id); \
 		} \
 	} while(0)
 
+// Consistent sampling on Key (anything with GetTypeHash) - all calls for one actor or connection are kept or dropped together
+#define ULM_LOG_SAMPLED_KEY(Channel, Verbosity, Key, Format, ...) \
+	do { \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity)) \
+		{ \
+			const FULMSampleDecision ULMSample = ULMSampling::SampleKey(ULMChannelId, GetTypeHash(Key)); \
+			if (ULMSample) \
+			{ \
+				const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
+				ULMLogMessageSampled(ULMChannelId, Verbosity, FString::Printf(Format, ##__VA_ARGS__), ULMSample, ULMCallsite->Id); \
+			} \
+		} \
+	} while(0)
+
+// Per-callsite throttles - each expansion owns its state, so one spammy line can't use up the channel's rate
+// limit, and a throttled-out call is a single relaxed atomic with no formatting. The gate runs once; a call that
+// passes the throttle but is refused admission refunds its pass, so a rejection never eats the ONCE line.
+// Verbosity and format are only validated after a pass - throttled-out calls never scan the format string.
+#define ULM_LOG_THROTTLED(Channel, Verbosity, TryPass, Refund, Format, ...) \
+	do { \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity) && (TryPass)) \
+		{ \
+			const FULMAdmissionTicket ULMTicket = ULMInternal::IsValidVerbosity(Verbosity) && ULMInternal::IsValidFormat(Format) \
+				? ULMAdmit(ULMChannelId, Verbosity) : FULMAdmissionTicket(); \
+			if (ULMTicket) \
+			{ \
+				const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
+				ULM_SUBMIT_ADMITTED(ULMTicket, ULMCallsite->Id, Format, ##__VA_ARGS__); \
+			} \
+			else \
+			{ \
+				Refund; \
+			} \
+		} \
+	} while(0)
+
+#define ULM_LOG_ONCE(Channel, Verbosity, Format, ...) \
+	do { \
+		static ULMThrottle::FOnce ULMThrottleState; \
+		ULM_LOG_THROTTLED(Channel, Verbosity, ULMThrottleState.TryPass(), ULMThrottleState.Refund(), Format, ##__VA_ARGS__); \
+	} while(0)
+
+#define ULM_LOG_EVERY_N(Channel, Verbosity, N, Format, ...) \
+	do { \
+		static ULMThrottle::FEveryN ULMThrottleState; \
+		ULM_LOG_THROTTLED(Channel, Verbosity, ULMThrottleState.TryPass(N), ULMThrottleState.Refund(), Format, ##__VA_ARGS__); \
+	} while(0)
+
+#define ULM_LOG_EVERY_SECONDS(Channel, Verbosity, Seconds, Format, ...) \
+	do { \
+		static ULMThrottle::FEverySeconds ULMThrottleState; \
+		ULM_LOG_THROTTLED(Channel, Verbosity, ULMThrottleState.TryPass(Seconds), ULMThrottleState.Refund(), Format, ##__VA_ARGS__); \
+	} while(0)
+
+#define ULM_LOG_RATE_LIMITED(Channel, Verbosity, RatePerSecond, Burst, Format, ...) \
+	do { \
+		static ULMThrottle::FTokenBucket ULMThrottleState; \
+		ULM_LOG_THROTTLED(Channel, Verbosity, ULMThrottleState.TryPass(RatePerSecond, Burst), ULMThrottleState.Refund(RatePerSecond), Format, ##__VA_ARGS__); \
+	} while(0)
+
 // Context-aware macros that automatically provide world context
 #define ULM_LOG_OBJECT(Object, Channel, Verbosity, Format, ...) \
 	do { \
-		ULMInternal::FCachedChannelState CachedState; \
-		if (ULMInternal::GetCachedChannelState(Channel, CachedState) && CachedState.bEnabled && Verbosity >= CachedState.MinVerbosity) \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity)) \
 		{ \
+			const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
 			const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
-			ULMLogMessage(Channel, Verbosity, Msg, Object, __FILE__, __LINE__); \
+			ULMLogMessage(ULMChannelId, Verbosity, Msg, Object, __FILE__, __LINE__, ULMCallsite->Id); \
 		} \
 	} while(0)
 
 // Conditional logging macros for common scenarios
 #define ULM_LOG_IF(Condition, Channel, Verbosity, Format, ...) \
 	do { \
-		ULMInternal::FCachedChannelState CachedState; \
-		if ((Condition) && ULMInternal::GetCachedChannelState(Channel, CachedState) && CachedState.bEnabled && Verbosity >= CachedState.MinVerbosity) \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if ((Condition) && ULMInternal::IsChannelOpen(ULMChannelId, Verbosity)) \
 		{ \
+			const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
 			const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
-			ULMLogMessage(Channel, Verbosity, Msg, nullptr, __FILE__, __LINE__); \
+			ULMLogMessage(ULMChannelId, Verbosity, Msg, nullptr, __FILE__, __LINE__, ULMCallsite->Id); \
 		} \
 	} while(0)
 
@@ -313,62 +425,61 @@ ULM_API void ULMLogMessageSampled(const FString& ChannelName, EULMVerbosity Verb
 #define ULM_ERROR(Channel, Format, ...) ULM_LOG(Channel, EULMVerbosity::Error, Format, ##__VA_ARGS__)
 #define ULM_CRITICAL(Channel, Format, ...) ULM_LOG(Channel, EULMVerbosity::Critical, Format, ##__VA_ARGS__)
 
-// Enhanced logging macros with improved Rider formatting and class name extraction
+// Enhanced logging macros with improved Rider formatting - class and function names come from the callsite descriptor, parsed once
 // Compact macro with Rider-compatible format: includes function name in the message
 #define ULM_LOG_COMPACT(Channel, Verbosity, Format, ...) \
 	do { \
-		ULMInternal::FCachedChannelState CachedState; \
-		if (ULMInternal::GetCachedChannelState(Channel, CachedState) && CachedState.bEnabled && Verbosity >= CachedState.MinVerbosity) \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity)) \
 		{ \
-			const FString FunctionName = ULMInternal::ExtractFunctionName(__FUNCTION__); \
+			const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
 			const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
-			const FString LogMsg = FString::Printf(TEXT("%s: %s"), *FunctionName, *Msg); \
-			ULMLogMessage(Channel, Verbosity, LogMsg, nullptr, __FILE__, __LINE__); \
+			const FString LogMsg = FString::Printf(TEXT("%s: %s"), *ULMCallsite->Function, *Msg); \
+			ULMLogMessage(ULMChannelId, Verbosity, LogMsg, nullptr, __FILE__, __LINE__, ULMCallsite->Id); \
 		} \
 	} while(0)
 
 // Enhanced macro with class/function context (Rider will make file paths clickable via __FILE__/__LINE__ params)
 #define ULM_LOG_ENHANCED(Channel, Verbosity, Format, ...) \
 	do { \
-		ULMInternal::FCachedChannelState CachedState; \
-		if (ULMInternal::GetCachedChannelState(Channel, CachedState) && CachedState.bEnabled && Verbosity >= CachedState.MinVerbosity) \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity)) \
 		{ \
+			const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
 			const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
-			const FString ClassName = ULMInternal::ExtractClassName(__FUNCTION__); \
-			const FString FunctionName = ULMInternal::ExtractFunctionName(__FUNCTION__); \
 			const FString LogMsg = FString::Printf(TEXT("[%s::%s] %s"), \
-				*ClassName, *FunctionName, *Msg); \
-			ULMLogMessage(Channel, Verbosity, LogMsg, nullptr, __FILE__, __LINE__); \
+				*ULMCallsite->Class, *ULMCallsite->Function, *Msg); \
+			ULMLogMessage(ULMChannelId, Verbosity, LogMsg, nullptr, __FILE__, __LINE__, ULMCallsite->Id); \
 		} \
 	} while(0)
 
 // Class-aware macro for use within UObject-derived classes
 #define ULM_LOG_CLASS(Channel, Verbosity, Format, ...) \
 	do { \
-		ULMInternal::FCachedChannelState CachedState; \
-		if (ULMInternal::GetCachedChannelState(Channel, CachedState) && CachedState.bEnabled && Verbosity >= CachedState.MinVerbosity) \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity)) \
 		{ \
+			const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
 			const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
 			const FString ClassName = ULMInternal::GetObjectClassName(this); \
-			const FString FunctionName = ULMInternal::ExtractFunctionName(__FUNCTION__); \
 			const FString LogMsg = FString::Printf(TEXT("[%s::%s] %s"), \
-				*ClassName, *FunctionName, *Msg); \
-			ULMLogMessage(Channel, Verbosity, LogMsg, Cast<UObject>(this), __FILE__, __LINE__); \
+				*ClassName, *ULMCallsite->Function, *Msg); \
+			ULMLogMessage(ULMChannelId, Verbosity, LogMsg, Cast<UObject>(this), __FILE__, __LINE__, ULMCallsite->Id); \
 		} \
 	} while(0)
 
 // Object-enhanced macro with explicit object parameter
 #define ULM_LOG_OBJECT_ENHANCED(Object, Channel, Verbosity, Format, ...) \
 	do { \
-		ULMInternal::FCachedChannelState CachedState; \
-		if (ULMInternal::GetCachedChannelState(Channel, CachedState) && CachedState.bEnabled && Verbosity >= CachedState.MinVerbosity) \
+		const EULMChannelId ULMChannelId = ULM_RESOLVE_CHANNEL(Channel); \
+		if (ULMInternal::IsChannelOpen(ULMChannelId, Verbosity)) \
 		{ \
+			const FULMCallsite* ULMCallsite = ULM_CALLSITE(ULMChannelId, Format); \
 			const FString Msg = FString::Printf(Format, ##__VA_ARGS__); \
 			const FString ClassName = ULMInternal::GetObjectClassName(Object); \
-			const FString FunctionName = ULMInternal::ExtractFunctionName(__FUNCTION__); \
 			const FString LogMsg = FString::Printf(TEXT("[%s::%s] %s"), \
-				*ClassName, *FunctionName, *Msg); \
-			ULMLogMessage(Channel, Verbosity, LogMsg, Object, __FILE__, __LINE__); \
+				*ClassName, *ULMCallsite->Function, *Msg); \
+			ULMLogMessage(ULMChannelId, Verbosity, LogMsg, Object, __FILE__, __LINE__, ULMCallsite->Id); \
 		} \
 	} while(0)
 
@@ -392,59 +503,58 @@ ULM_API void ULMLogMessageSampled(const FString& ChannelName, EULMVerbosity Verb
 
 /**
  * Structured logging support for complex data
+ * Fields are captured typed into a pooled FULMStructuredFields block - nothing is converted to text on the calling
+ * thread, and a closed channel skips the capture entirely
  */
 class ULM_API FULMStructuredLog
 {
 public:
+	// File and line are not carried for these - only callsite-built logs resolve a source location
+	FULMStructuredLog(EULMChannelId InChannelId, EULMVerbosity InVerbosity, const FString& InFileName = TEXT(""), int32 InLineNumber = 0, const FString& InFunctionName = TEXT(""));
 	FULMStructuredLog(const FString& InChannelName, EULMVerbosity InVerbosity, const FString& InFileName = TEXT(""), int32 InLineNumber = 0, const FString& InFunctionName = TEXT(""));
+	
+	// Callsite constructors used by ULM_LOG_STRUCTURED - file, line and function come from the static descriptor
+	FULMStructuredLog(EULMChannelId InChannelId, EULMVerbosity InVerbosity, const FULMCallsite* InCallsite);
+	FULMStructuredLog(const FString& InChannelName, EULMVerbosity InVerbosity, const FULMCallsite* InCallsite);
 	~FULMStructuredLog();
 
-	// Fluent interface for building structured logs
-	FULMStructuredLog& Add(const FString& Key, const FString& Value);
-	FULMStructuredLog& Add(const FString& Key, int32 Value);
-	FULMStructuredLog& Add(const FString& Key, float Value);
-	FULMStructuredLog& Add(const FString& Key, bool Value);
-	FULMStructuredLog& Add(const FString& Key, const FVector& Value);
-	FULMStructuredLog& Add(const FString& Key, const FRotator& Value);
+	// Fluent interface for building structured logs - TEXT() keys and values are copied without building an FString
+	FULMStructuredLog& Add(FStringView Key, FStringView Value);
+	FULMStructuredLog& Add(FStringView Key, const TCHAR* Value);
+	FULMStructuredLog& Add(FStringView Key, int32 Value);
+	FULMStructuredLog& Add(FStringView Key, int64 Value);
+	FULMStructuredLog& Add(FStringView Key, float Value);
+	FULMStructuredLog& Add(FStringView Key, double Value);
+	FULMStructuredLog& Add(FStringView Key, bool Value);
+	FULMStructuredLog& Add(FStringView Key, const FVector& Value);
+	FULMStructuredLog& Add(FStringView Key, const FRotator& Value);
 
 	// Commit the structured log
 	void Commit();
 
 private:
-	FString ChannelName;
+	EULMChannelId ChannelId;
 	EULMVerbosity Verbosity;
-	FString FileName;
-	int32 LineNumber;
 	FString FunctionName;
-	TMap<FString, FString> Fields;
+	const FULMCallsite* Callsite = nullptr;
+	FULMStructuredFields Fields;
+	bool bEnabled = false;
 	bool bCommitted = false;
 };
 
 // Structured logging macro
 #define ULM_LOG_STRUCTURED(Channel, Verbosity) \
-	FULMStructuredLog(Channel, Verbosity, *FPaths::GetCleanFilename(__FILE__), __LINE__, *ULMInternal::ExtractFunctionName(__FUNCTION__))
-
-// Channel name constants - inline to avoid linker issues
-static const FString ULMChannelGameplay(TEXT("Gameplay"));
-static const FString ULMChannelNetwork(TEXT("Network"));
-static const FString ULMChannelPerformance(TEXT("Performance"));
-static const FString ULMChannelDebug(TEXT("Debug"));
-static const FString ULMChannelAI(TEXT("AI"));
-static const FString ULMChannelPhysics(TEXT("Physics"));
-static const FString ULMChannelAudio(TEXT("Audio"));
-static const FString ULMChannelAnimation(TEXT("Animation"));
-static const FString ULMChannelUI(TEXT("UI"));
-static const FString ULMChannelSubsystem(TEXT("Subsystem"));
-
-// Channel name convenience macros
-#define CHANNEL_GAMEPLAY ULMChannelGameplay
-#define CHANNEL_NETWORK ULMChannelNetwork
-#define CHANNEL_PERFORMANCE ULMChannelPerformance
-#define CHANNEL_DEBUG ULMChannelDebug
-#define CHANNEL_AI ULMChannelAI
-#define CHANNEL_PHYSICS ULMChannelPhysics
-#define CHANNEL_AUDIO ULMChannelAudio
-#define CHANNEL_ANIMATION ULMChannelAnimation
-#define CHANNEL_UI ULMChannelUI
-#define CHANNEL_SUBSYSTEM ULMChannelSubsystem
+	FULMStructuredLog(ULM_RESOLVE_CHANNEL(Channel), Verbosity, ULM_CALLSITE(Channel, nullptr))
+
+// Channel convenience macros - expand to compile-time channel IDs so the macro gate never touches strings
+#define CHANNEL_GAMEPLAY EULMChannelId::Gameplay
+#define CHANNEL_NETWORK EULMChannelId::Network
+#define CHANNEL_PERFORMANCE EULMChannelId::Performance
+#define CHANNEL_DEBUG EULMChannelId::Debug
+#define CHANNEL_AI EULMChannelId::AI
+#define CHANNEL_PHYSICS EULMChannelId::Physics
+#define CHANNEL_AUDIO EULMChannelId::Audio
+#define CHANNEL_ANIMATION EULMChannelId::Animation
+#define CHANNEL_UI EULMChannelId::UI
+#define CHANNEL_SUBSYSTEM EULMChannelId::Subsystem
 
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FULMMessageOverflowBlock;
+
+/**
+ * Allocation counters for queued message text
+ * Only the overflow path is counted - short messages never allocate, and counting them would put a shared atomic
+ * on every Assign. OverflowBlockAllocations only grows while the overflow pool is warming up, so a flat value
+ * under load means zero steady-state mallocs.
+ */
+struct FULMMessageBufferStats
+{
+	int64 OverflowMessages = 0;
+	int64 OverflowBlockAllocations = 0;
+	int32 PooledOverflowBlocks = 0;
+};
+
+/**
+ * Fixed-size UTF-8 message storage for queue entries
+ * Messages up to INLINE_CAPACITY bytes live inside the entry itself; longer ones spill into a pooled
+ * overflow block that keeps its capacity when recycled. Move-only - the overflow block has a single owner.
+ */
+class ULM_API FULMMessageBuffer
+{
+public:
+	static constexpr int32 INLINE_CAPACITY = 200;
+
+	FULMMessageBuffer() = default;
+	~FULMMessageBuffer();
+
+	FULMMessageBuffer(FULMMessageBuffer&& Other);
+	FULMMessageBuffer& operator=(FULMMessageBuffer&& Other);
+
+	FULMMessageBuffer(const FULMMessageBuffer&) = delete;
+	FULMMessageBuffer& operator=(const FULMMessageBuffer&) = delete;
+
+	/** Store a message, converting to UTF-8 - reuses any overflow block already held */
+	void Assign(const TCHAR* Text, int32 TextLen);
+
+	void Assign(const FString& Text)
+	{
+		Assign(*Text, Text.Len());
+	}
+
+	/** Drop the message and return any overflow block to the pool */
+	void Reset();
+
+	/** Decode back to TCHAR - called on the log processor thread */
+	FString ToString() const;
+
+	bool IsEmpty() const { return Length == 0; }
+	bool IsInline() const { return Overflow == nullptr; }
+
+	/** Encoded length in bytes */
+	int32 Len() const { return Length; }
+
+	/** Hash of the encoded text */
+	uint64 GetHash() const;
+
+	/** Snapshot of the process-wide allocation counters */
+	static FULMMessageBufferStats GetStats();
+
+private:
+	const UTF8CHAR* GetData() const;
+	void MoveFrom(FULMMessageBuffer& Other);
+
+	FULMMessageOverflowBlock* Overflow = nullptr;
+	int32 Length = 0;
+	UTF8CHAR InlineData[INLINE_CAPACITY];
+};
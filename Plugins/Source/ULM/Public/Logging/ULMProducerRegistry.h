@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Snapshot of one producer thread's queue usage
+ */
+struct FULMProducerStats
+{
+	FString Name;
+	uint32 ThreadId = 0;
+	float Weight = 1.0f;
+
+	// Entries currently queued, total enqueued and total dropped since the last reset
+	int32 Queued = 0;
+	int64 Enqueued = 0;
+	int64 Dropped = 0;
+
+	// Shared slot only - times a thread found the table full and fell back to it
+	int64 SharedClaims = 0;
+};
+
+/**
+ * Per-thread accounting for the log queue front end
+ * Every producer thread gets a slot on first use (or through RegisterCurrentThread); once the queue is under
+ * pressure a thread may only hold its weighted share of the entry limit, plus a small burst allowance, so one
+ * runaway thread can't starve the others. Slot lookup is a thread_local cache hit after the first log call.
+ * A thread gives its slot back when it exits; the slot is handed to a new thread once its queued entries drain.
+ */
+class ULM_API FULMProducerRegistry
+{
+public:
+	static constexpr int32 MAX_PRODUCERS = 64;
+
+	// Threads arriving while every slot is taken share this slot, and move off it once one is released
+	static constexpr int32 SHARED_SLOT = 0;
+
+	static constexpr float DEFAULT_WEIGHT = 1.0f;
+	static constexpr int32 DEFAULT_BURST_ENTRIES = 32;
+
+	FULMProducerRegistry();
+	~FULMProducerRegistry();
+
+	/** Drop every slot - cached slot indices from an earlier session are invalidated */
+	void Reset();
+
+	/** Name and weight the calling thread - returns its slot */
+	int32 RegisterCurrentThread(const FString& Name, float Weight = DEFAULT_WEIGHT, int32 BurstEntries = DEFAULT_BURST_ENTRIES);
+
+	/** Slot of the calling thread, claimed with default weight on first use */
+	int32 GetCurrentSlot();
+
+	/** True if the slot holds less than its weighted share of EntryLimit among producers with queued entries */
+	bool IsWithinQuota(int32 Slot, int32 EntryLimit) const;
+
+	void OnEnqueued(int32 Slot);
+	void OnDequeued(int32 Slot);
+	void OnDropped(int32 Slot);
+
+	/** Zero the throughput, drop and shared slot counters - queued counts are live state and are kept */
+	void ResetCounters();
+
+	/** Stats for every claimed slot, including released slots not yet handed to a new thread */
+	TArray<FULMProducerStats> GetStats() const;
+
+private:
+	friend struct FULMProducerSlotCache;
+
+	// Weights are stored in 8.8 fixed point so the quota scan only does integer loads
+	static constexpr int32 WEIGHT_ONE = 256;
+
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FSlot
+	{
+		std::atomic<uint32> ThreadId{0};
+		std::atomic<int32> WeightFixed{WEIGHT_ONE};
+		std::atomic<int32> BurstEntries{DEFAULT_BURST_ENTRIES};
+		std::atomic<int32> Queued{0};
+		std::atomic<int64> Enqueued{0};
+		std::atomic<int64> Dropped{0};
+
+		// Owner thread exited - reusable once Queued drains to zero, since nothing enqueues on it any more
+		std::atomic<bool> bReleased{false};
+	};
+
+	int32 ClaimSlot(uint32 ThreadId);
+	int32 ClaimReleasedSlot();
+	void ReleaseSlot(int32 Slot);
+	void ConfigureSlot(int32 Slot, const FString& Name, float Weight, int32 BurstEntries);
+
+	FSlot Slots[MAX_PRODUCERS];
+	std::atomic<int32> NumSlots{1};
+
+	// Released slots not yet reclaimed - shared-slot threads only rescan while this is non-zero
+	std::atomic<int32> NumReleased{0};
+	std::atomic<int64> SharedClaims{0};
+
+	// Bumped on Reset so thread_local slot caches from a previous session miss
+	std::atomic<uint32> Generation{0};
+
+	// Names are only written at registration and read for stats
+	mutable FCriticalSection NamesLock;
+	FString Names[MAX_PRODUCERS];
+};
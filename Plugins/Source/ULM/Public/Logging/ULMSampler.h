@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Channels/ULMChannel.h"
+
+struct FULMLogQueueEntry;
+
+/**
+ * Outcome of one sampling decision
+ */
+struct FULMSampleDecision
+{
+	// Calls the kept entry stands for - zero when the call is dropped
+	float Weight = 0.0f;
+
+	// Reservoir slot and window this call was offered - the entry is held until the window closes
+	int32 ReservoirSlot = INDEX_NONE;
+	uint32 ReservoirWindow = 0;
+
+	explicit operator bool() const { return Weight > 0.0f; }
+	bool IsReservoir() const { return ReservoirSlot != INDEX_NONE; }
+
+	static FULMSampleDecision Keep(float InWeight)
+	{
+		FULMSampleDecision Decision;
+		Decision.Weight = FMath::Max(1.0f, InWeight);
+		return Decision;
+	}
+};
+
+/**
+ * Sampling counters for one channel
+ */
+struct FULMSamplerStats
+{
+	EULMSamplingMode Mode = EULMSamplingMode::EveryN;
+
+	// Calls offered to the sampler and entries kept since the last reset
+	int64 Seen = 0;
+	int64 Kept = 0;
+
+	// Current keep-one-in-N - fixed in Every N mode, retuned each window in Budget mode
+	uint32 CurrentRate = 1;
+};
+
+/**
+ * Per-channel sampling behind ULM_LOG_SAMPLED and ULM_LOG_SAMPLED_KEY
+ * State is process-wide and indexed by channel ID, shared by every thread. Every N and Budget decisions are
+ * lock-free; Reservoir channels take a per-channel lock, and only format the calls that win a slot.
+ */
+namespace ULMSampling
+{
+	/** Publish a channel's sampling settings - called by the channel registry with every snapshot */
+	ULM_API void Configure(EULMChannelId ChannelId, EULMSamplingMode Mode, int32 SampleRate, float BudgetPerSecond, float WindowSeconds);
+
+	/** Decide whether to keep one call - a non-zero RateOverride keeps every RateOverride-th call regardless of mode */
+	ULM_API FULMSampleDecision Sample(EULMChannelId ChannelId, uint32 RateOverride = 0);
+
+	/**
+	 * Key-consistent decision - every call with the same key hash is kept or dropped together
+	 * A key kept at rate N is also kept at every rate below N, so Budget retuning only adds or removes whole keys.
+	 * Reservoir channels sample keyed calls at their budget rate.
+	 */
+	ULM_API FULMSampleDecision SampleKey(EULMChannelId ChannelId, uint32 KeyHash);
+
+	/** Hand a reservoir decision its entry - dropped if the window closed in between */
+	ULM_API void FillReservoir(EULMChannelId ChannelId, const FULMSampleDecision& Decision, FULMLogQueueEntry&& Entry);
+
+	/**
+	 * Emit every reservoir whose window has closed, or all of them when bForce - called from the log processor
+	 * Producers that find a window over only start the next one and leave the closed slots here to be emitted
+	 */
+	ULM_API void FlushReservoirs(bool bForce = false);
+
+	ULM_API FULMSamplerStats GetStats(EULMChannelId ChannelId);
+	ULM_API void ResetStats();
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FULMStructuredFieldBlock;
+
+/**
+ * Value type of a structured log field
+ */
+enum class EULMFieldType : uint8
+{
+	String,
+	Int,
+	Float,
+	Bool,
+	Vector,
+	Rotator
+};
+
+/**
+ * One typed field - keys and string values live in the owning block's text buffer
+ */
+struct FULMStructuredField
+{
+	EULMFieldType Type = EULMFieldType::Int;
+	bool bValue = false;
+	int32 KeyOffset = 0;
+	int32 KeyLen = 0;
+	int32 TextOffset = 0;
+	int32 TextLen = 0;
+	int64 IntValue = 0;
+
+	// Float uses [0]; vectors store X, Y, Z and rotators Pitch, Yaw, Roll
+	double Numbers[3] = { 0.0, 0.0, 0.0 };
+};
+
+/**
+ * Typed field buffer carried through the log queue in binary
+ * Fields and their text live in a pooled block with inline room for INLINE_FIELDS fields, so a structured log
+ * costs no allocations once the pool is warm. Rendered as "key=value" text for the Output Log and in-memory
+ * storage, and as a nested JSON object with native numbers and arrays for the JSON files. Move-only.
+ */
+class ULM_API FULMStructuredFields
+{
+public:
+	static constexpr int32 INLINE_FIELDS = 16;
+	static constexpr int32 INLINE_TEXT_CHARS = 512;
+
+	FULMStructuredFields() = default;
+	~FULMStructuredFields();
+
+	FULMStructuredFields(FULMStructuredFields&& Other);
+	FULMStructuredFields& operator=(FULMStructuredFields&& Other);
+
+	FULMStructuredFields(const FULMStructuredFields&) = delete;
+	FULMStructuredFields& operator=(const FULMStructuredFields&) = delete;
+
+	void AddString(FStringView Key, FStringView Value);
+	void AddInt(FStringView Key, int64 Value);
+	void AddFloat(FStringView Key, double Value);
+	void AddBool(FStringView Key, bool Value);
+	void AddVector(FStringView Key, const FVector& Value);
+	void AddRotator(FStringView Key, const FRotator& Value);
+
+	/** Drop every field and return the block to the pool */
+	void Reset();
+
+	bool IsSet() const { return Block != nullptr; }
+	int32 Num() const;
+
+	/** Append "key=value, key=value" - called on the log processor thread */
+	void AppendText(FString& Out) const;
+
+	/** Append a JSON object of the fields - strings escaped, numbers and booleans native, vectors as arrays */
+	void AppendJSON(FString& Out) const;
+
+	/** Hash of every field's type, key and value - equal field sets hash equal */
+	uint64 GetHash() const;
+
+	/** Block memory held while queued, charged against the queue's byte limit */
+	SIZE_T GetAllocatedBytes() const;
+
+private:
+	FULMStructuredField& AddField(EULMFieldType Type, FStringView Key);
+
+	FULMStructuredFieldBlock* Block = nullptr;
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include <atomic>
+
+/**
+ * Per-callsite throttle state for ULM_LOG_ONCE / EVERY_N / EVERY_SECONDS / RATE_LIMITED
+ * Each macro expansion owns one static, zero-initialised instance, so throttling is per line rather than per
+ * channel and shared by every thread. A throttled-out call costs a single relaxed atomic operation - no strings,
+ * no hashing, no channel token. A call that passes the throttle but is then rejected by the channel hands its
+ * pass back with Refund, so the emission isn't lost.
+ */
+namespace ULMThrottle
+{
+	FORCEINLINE uint64 SecondsToCycles(double Seconds)
+	{
+		return static_cast<uint64>(FMath::Max(0.0, Seconds) / FPlatformTime::GetSecondsPerCycle64());
+	}
+
+	// Passes the first call only
+	struct FOnce
+	{
+		std::atomic<bool> bFired{false};
+
+		FORCEINLINE bool TryPass()
+		{
+			return !bFired.load(std::memory_order_relaxed) && !bFired.exchange(true, std::memory_order_relaxed);
+		}
+
+		FORCEINLINE void Refund()
+		{
+			bFired.store(false, std::memory_order_relaxed);
+		}
+	};
+
+	// Passes the first call and every Nth after it
+	struct FEveryN
+	{
+		std::atomic<uint32> Count{0};
+
+		// Set by a refunded pass - the next call takes it over
+		std::atomic<bool> bOwed{false};
+
+		FORCEINLINE bool TryPass(uint32 N)
+		{
+			if (bOwed.load(std::memory_order_relaxed) && bOwed.exchange(false, std::memory_order_relaxed))
+			{
+				return true;
+			}
+			return Count.fetch_add(1, std::memory_order_relaxed) % FMath::Max(1u, N) == 0;
+		}
+
+		FORCEINLINE void Refund()
+		{
+			bOwed.store(true, std::memory_order_relaxed);
+		}
+	};
+
+	// Passes at most one call per interval
+	struct FEverySeconds
+	{
+		std::atomic<uint64> NextCycles{0};
+
+		FORCEINLINE bool TryPass(double Seconds)
+		{
+			const uint64 Now = FPlatformTime::Cycles64();
+			uint64 Next = NextCycles.load(std::memory_order_relaxed);
+			if (Now < Next)
+			{
+				return false;
+			}
+
+			// Only the thread that moves the deadline logs
+			return NextCycles.compare_exchange_strong(Next, Now + SecondsToCycles(Seconds), std::memory_order_relaxed);
+		}
+
+		// Clears the deadline so the next call logs in place of the rejected one
+		FORCEINLINE void Refund()
+		{
+			NextCycles.store(0, std::memory_order_relaxed);
+		}
+	};
+
+	/**
+	 * Token bucket of Burst tokens refilled at RatePerSecond, kept as a single theoretical arrival time (GCRA)
+	 * so it needs no lock and no separate token count
+	 */
+	struct FTokenBucket
+	{
+		std::atomic<uint64> TheoreticalArrival{0};
+
+		FORCEINLINE bool TryPass(double RatePerSecond, int32 Burst)
+		{
+			const uint64 Now = FPlatformTime::Cycles64();
+			const uint64 Interval = SecondsToCycles(1.0 / FMath::Max(RatePerSecond, UE_DOUBLE_SMALL_NUMBER));
+			const uint64 Tolerance = Interval * static_cast<uint64>(FMath::Max(1, Burst) - 1);
+
+			uint64 Arrival = TheoreticalArrival.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				if (Arrival > Now + Tolerance)
+				{
+					return false;
+				}
+
+				if (TheoreticalArrival.compare_exchange_weak(Arrival, FMath::Max(Arrival, Now) + Interval, std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+		}
+
+		// Gives the token back - the arrival time only grows between TryPass and Refund, so it never underflows
+		FORCEINLINE void Refund(double RatePerSecond)
+		{
+			TheoreticalArrival.fetch_sub(SecondsToCycles(1.0 / FMath::Max(RatePerSecond, UE_DOUBLE_SMALL_NUMBER)), std::memory_order_relaxed);
+		}
+	};
+}
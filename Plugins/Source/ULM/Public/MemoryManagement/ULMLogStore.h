@@ -0,0 +1,237 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Channels/ULMChannel.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/RefCounting.h"
+
+struct FULMLogEntry;
+
+/**
+ * Stored metadata for one log entry - the text lives in the owning store's chunks
+ */
+struct FULMLogRecord
+{
+	// Raw capture cycles - converted to wall-clock time only when the entry is read back
+	uint64 CaptureCycles = 0;
+
+	// Global storage sequence, and the highest sequence of this record or any older one - a late arrival slotted
+	// in behind newer records raises theirs, so a backwards scan for new sequences knows where to stop
+	int64 Sequence = 0;
+	int64 SequenceHighWater = 0;
+	const TCHAR* Text = nullptr;
+	int32 TextLen = 0;
+	int32 ThreadId = 0;
+	uint32 CallsiteId = 0;
+	float SampleWeight = 1.0f;
+
+	// Lowest chunk serial referenced by this record or any newer one - never decreases from oldest to newest,
+	// so chunks older than the oldest record's serial are unreferenced
+	uint32 ChunkSerial = 0;
+
+	EULMVerbosity Verbosity = EULMVerbosity::Message;
+};
+
+/**
+ * Block of bump-allocated message text
+ * Shared between the store and any read views pointing into it - text below Used is never rewritten while a
+ * view holds a reference, and the block is freed when the last holder lets go.
+ */
+struct ULM_API FULMTextChunk : public FThreadSafeRefCountedObject
+{
+	TCHAR* Data = nullptr;
+	int32 Capacity = 0;
+	int32 Used = 0;
+	uint32 Serial = 0;
+
+	~FULMTextChunk()
+	{
+		FMemory::Free(Data);
+	}
+};
+
+/**
+ * Immutable snapshot of the newest entries of one channel
+ * Holds its own copy of the window's records and a reference to every text chunk they point into, so it can be
+ * iterated from any thread with no lock while the store keeps appending and evicting. Message text is never
+ * copied - FString copies are only made by CopyEntries.
+ */
+class ULM_API FULMLogStoreView
+{
+public:
+	EULMChannelId GetChannelId() const { return ChannelId; }
+	int32 Num() const { return Records.Num(); }
+	bool IsEmpty() const { return Records.Num() == 0; }
+
+	/** Record by age - 0 is the oldest entry in the view */
+	const FULMLogRecord& operator[](int32 Index) const { return Records[Index]; }
+
+	FStringView GetMessage(int32 Index) const
+	{
+		const FULMLogRecord& Record = Records[Index];
+		return FStringView(Record.Text, Record.TextLen);
+	}
+
+	// Ranged-for over the records, oldest first
+	const FULMLogRecord* begin() const { return Records.GetData(); }
+	const FULMLogRecord* end() const { return Records.GetData() + Records.Num(); }
+
+	/** Materialise the newest MaxEntries entries of the view (all if MaxEntries <= 0), oldest first */
+	void CopyEntries(TArray<FULMLogEntry>& OutEntries, int32 MaxEntries = 0) const;
+
+private:
+	friend class FULMChannelLogStore;
+
+	EULMChannelId ChannelId = EULMChannelId::Invalid;
+	TArray<FULMLogRecord> Records;
+	TArray<TRefCountPtr<FULMTextChunk>, TInlineAllocator<4>> Chunks;
+};
+
+typedef TSharedPtr<const FULMLogStoreView, ESPMode::ThreadSafe> FULMLogStoreViewPtr;
+
+/**
+ * Per-channel in-memory log storage
+ * Records live in a power-of-two ring, so appending and dropping the oldest entries never moves other
+ * records. The ring is kept in capture order - the rare late arrival (priority lane, reservoir sample) is
+ * slotted in behind the newer records it missed, at most MAX_LATE_SHIFT of them; anything later keeps its own
+ * capture time but lands MAX_LATE_SHIFT records back, so one add never moves more. Message text is bump-allocated into large chunks
+ * instead of one FString per entry; removing the oldest entries frees whole chunks once no live record points
+ * into them, and clearing is O(chunks).
+ * Not thread-safe - callers hold the owning FULMStorageShard's lock.
+ */
+class ULM_API FULMChannelLogStore
+{
+public:
+	// Standard chunk size in characters - longer messages get a dedicated chunk
+	static constexpr int32 CHUNK_CAPACITY = 16 * 1024;
+
+	// Most records a late arrival is slotted in behind - bounds the per-add shift whatever the entry limit
+	static constexpr int32 MAX_LATE_SHIFT = 64;
+
+	FULMChannelLogStore() = default;
+	~FULMChannelLogStore();
+
+	FULMChannelLogStore(const FULMChannelLogStore&) = delete;
+	FULMChannelLogStore& operator=(const FULMChannelLogStore&) = delete;
+
+	/** Logical footprint of one stored entry, used for memory budget accounting */
+	static SIZE_T GetRecordSize(int32 TextLen)
+	{
+		return sizeof(FULMLogRecord) + static_cast<SIZE_T>(TextLen) * sizeof(TCHAR);
+	}
+
+	/** Copy an entry's text into the current chunk and insert its record in capture order, up to MAX_LATE_SHIFT back - Sequence must increase with every call */
+	void Add(const FULMLogEntry& Entry, int64 Sequence);
+
+	/** Drop the oldest entries - returns the logical bytes released */
+	SIZE_T RemoveOldest(int32 Count);
+
+	/** Drop every entry and free all chunks */
+	void Empty();
+
+	/** Size the ring for at least NumRecords entries - text chunks are allocated on demand */
+	void Reserve(int32 NumRecords);
+
+	int32 Num() const { return RecordCount; }
+
+	/** Entries ever added, including those since evicted or cleared */
+	int64 GetNumAdded() const { return NumAdded; }
+
+	/** Record by age - 0 is the oldest live entry, Num() - 1 the newest */
+	const FULMLogRecord& GetRecord(int32 Index) const
+	{
+		check(Index >= 0 && Index < RecordCount);
+		return Records[(RecordHead + Index) & (Records.Num() - 1)];
+	}
+
+	/** Logical bytes of all live entries */
+	SIZE_T GetLiveBytes() const { return LiveBytes; }
+
+	/** Bytes actually held in text chunks, including the spare */
+	SIZE_T GetAllocatedBytes() const;
+
+	/** Materialise the newest MaxEntries entries (all if MaxEntries <= 0), oldest first */
+	void CopyEntries(EULMChannelId ChannelId, TArray<FULMLogEntry>& OutEntries, int32 MaxEntries = 0) const;
+
+	/** Indices of the records stamped after AfterSequence, newest first - visits only those and the few they jumped */
+	void FindNewerThan(int64 AfterSequence, TArray<int32>& OutIndices) const;
+
+	/** Snapshot the newest MaxEntries entries (all if MaxEntries <= 0) - copies record metadata, shares the text */
+	FULMLogStoreViewPtr CreateView(EULMChannelId ChannelId, int32 MaxEntries = 0) const;
+
+	/** Materialise one record */
+	void CopyEntry(EULMChannelId ChannelId, int32 Index, TArray<FULMLogEntry>& OutEntries) const;
+
+	/**
+	 * Materialise the newest MaxEntries entries across every channel (all if MaxEntries <= 0), oldest first
+	 * K-way merge walking back from each channel's newest record - costs O(MaxEntries log channels) no matter
+	 * how much each channel holds. Stores are indexed by channel ID.
+	 */
+	static void CopyNewestMerged(TConstArrayView<const FULMChannelLogStore*> Stores, TArray<FULMLogEntry>& OutEntries, int32 MaxEntries);
+
+private:
+	TCHAR* AllocateText(int32 NumChars, uint32& OutSerial);
+	void GrowRing(int32 MinCapacity);
+	void ReleaseChunksBefore(uint32 Serial);
+	void ReleaseChunk(TRefCountPtr<FULMTextChunk>& Chunk);
+
+	// Oldest chunk first
+	TArray<TRefCountPtr<FULMTextChunk>> Chunks;
+	uint32 NextChunkSerial = 0;
+
+	// One standard-size chunk kept back so a channel cycling at its entry limit doesn't hit the allocator
+	TCHAR* SpareChunk = nullptr;
+
+	// Record ring - the oldest live record is at RecordHead, capacity is zero or a power of two
+	TArray<FULMLogRecord> Records;
+	int32 RecordHead = 0;
+	int32 RecordCount = 0;
+	int64 NumAdded = 0;
+
+	SIZE_T LiveBytes = 0;
+};
+
+/**
+ * One channel's store and the lock guarding it
+ * Readers share the lock, so a Blueprint reading one channel only waits for the processor when it is writing
+ * that same channel. Cache-line aligned so neighbouring shards don't false-share.
+ */
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FULMStorageShard
+{
+	mutable FRWLock Lock;
+	FULMChannelLogStore Store;
+
+	// Operations spanning channels take every shard in index order and release in reverse - the only
+	// multi-shard lock order, so global operations can't deadlock one another
+	static void ReadLockAll(TConstArrayView<FULMStorageShard> Shards)
+	{
+		for (const FULMStorageShard& Shard : Shards)
+		{
+			Shard.Lock.ReadLock();
+		}
+	}
+
+	static void ReadUnlockAll(TConstArrayView<FULMStorageShard> Shards)
+	{
+		for (int32 Index = Shards.Num() - 1; Index >= 0; --Index)
+		{
+			Shards[Index].Lock.ReadUnlock();
+		}
+	}
+
+	static void WriteLockAll(TConstArrayView<FULMStorageShard> Shards)
+	{
+		for (const FULMStorageShard& Shard : Shards)
+		{
+			Shard.Lock.WriteLock();
+		}
+	}
+
+	static void WriteUnlockAll(TConstArrayView<FULMStorageShard> Shards)
+	{
+		for (int32 Index = Shards.Num() - 1; Index >= 0; --Index)
+		{
+			Shards[Index].Lock.WriteUnlock();
+		}
+	}
+};
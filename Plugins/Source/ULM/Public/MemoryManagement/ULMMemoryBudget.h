@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "HAL/ThreadSafeCounter.h"
+#include "Containers/StaticArray.h"
+#include "Channels/ULMChannel.h"
 #include "ULMMemoryBudget.generated.h"
 
 /**
@@ -57,17 +59,18 @@ struct ULM_API FULMMemoryTracker
 	// Configuration
 	SIZE_T MemoryBudget;
 	
-	// Per-channel tracking (protected by critical section)
+	// Per-channel tracking indexed by EULMChannelId (protected by critical section)
 	mutable FCriticalSection ChannelMemoryLock;
-	TMap<FString, SIZE_T> ChannelMemoryUsage;
+	TStaticArray<SIZE_T, ULM_CHANNEL_COUNT> ChannelMemoryUsage;
 	
 	// Largest channel tracking
-	FString LargestChannelName;
+	EULMChannelId LargestChannelId;
 	SIZE_T LargestChannelUsage;
 	
 	FULMMemoryTracker()
 		: MemoryBudget(52428800) // 50MB default
-		, LargestChannelName(TEXT("None"))
+		, ChannelMemoryUsage(InPlace, 0)
+		, LargestChannelId(EULMChannelId::Invalid)
 		, LargestChannelUsage(0)
 	{}
 	
@@ -79,17 +82,17 @@ struct ULM_API FULMMemoryTracker
 	/**
 	 * Add memory usage for a channel
 	 */
-	void AddMemoryUsage(const FString& ChannelName, SIZE_T MemorySize);
+	void AddMemoryUsage(EULMChannelId ChannelId, SIZE_T MemorySize);
 	
 	/**
-	 * Remove memory usage for a channel
+	 * Remove memory usage for a channel - EntryCount is the number of entries the bytes belonged to
 	 */
-	void RemoveMemoryUsage(const FString& ChannelName, SIZE_T MemorySize);
+	void RemoveMemoryUsage(EULMChannelId ChannelId, SIZE_T MemorySize, int32 EntryCount = 1);
 	
 	/**
 	 * Get current memory usage for a specific channel
 	 */
-	SIZE_T GetChannelMemoryUsage(const FString& ChannelName) const;
+	SIZE_T GetChannelMemoryUsage(EULMChannelId ChannelId) const;
 	
 	/**
 	 * Check if adding memory would exceed budget